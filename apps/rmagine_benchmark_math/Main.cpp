@@ -0,0 +1,130 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include <rmagine/math/types.h>
+#include <rmagine/math/math.h>
+#include <rmagine/math/simd.h>
+#include <rmagine/types/Memory.hpp>
+#include <rmagine/util/StopWatch.hpp>
+
+using namespace rmagine;
+
+// previous path of multNxN etc: one operator* per element
+template<typename In1T, typename In2T, typename ResT>
+void mult_generic(
+    const MemoryView<In1T, RAM>& A,
+    const MemoryView<In2T, RAM>& B,
+    MemoryView<ResT, RAM>& C)
+{
+    #pragma omp parallel for
+    for(size_t i=0; i<C.size(); i++)
+    {
+        C[i] = A[A.size() == 1 ? 0 : i] * B[i];
+    }
+}
+
+template<typename FuncT>
+double measure(FuncT f, size_t runs)
+{
+    StopWatch sw;
+    f(); // warm up
+    double best = 1e9;
+    for(size_t i=0; i<runs; i++)
+    {
+        sw();
+        f();
+        best = std::min(best, sw());
+    }
+    return best;
+}
+
+template<typename In1T, typename In2T, typename ResT>
+void bench(
+    const std::string& name,
+    const MemoryView<In1T, RAM>& A,
+    const MemoryView<In2T, RAM>& B,
+    MemoryView<ResT, RAM>& C,
+    size_t runs)
+{
+    std::cout << "- " << std::setw(24) << std::left << name;
+
+    const double t_generic = measure([&](){ mult_generic(A, B, C); }, runs);
+    std::cout << std::fixed << std::setprecision(3) 
+        << " generic: " << t_generic * 1000.0 << "ms";
+
+    const simd::Level best = simd::detect();
+    for(int l=0; l<=static_cast<int>(best); l++)
+    {
+        simd::setLevel(static_cast<simd::Level>(l));
+        const double t = measure([&](){ simd::mult(A, B, C); }, runs);
+        std::cout << ", " << simd::name(simd::level()) << ": " 
+            << t * 1000.0 << "ms (x" << std::setprecision(2) << t_generic / t << ")" << std::setprecision(3);
+    }
+    simd::setLevel(best);
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    std::cout << "Rmagine Benchmark: Math" << std::endl;
+
+    size_t N = 1000000;
+    size_t runs = 20;
+    if(argc > 1)
+    {
+        N = std::stoul(argv[1]);
+    }
+    if(argc > 2)
+    {
+        runs = std::stoul(argv[2]);
+    }
+
+    std::cout << "Elements: " << N << ", runs: " << runs 
+        << ", best SIMD level: " << simd::name(simd::detect()) << std::endl;
+
+    Memory<Vector, RAM> X(N), Y(N);
+    Memory<Quaternion, RAM> Q(N);
+    Memory<Matrix3x3, RAM> M(N);
+    Memory<Transform, RAM> T(N), Tr(N);
+    
+    for(size_t i=0; i<N; i++)
+    {
+        const float f = static_cast<float>(i) / static_cast<float>(N);
+        X[i] = {f, 1.0f - f, 2.0f * f};
+        EulerAngles e{f, 0.5f * f, -f};
+        Q[i] = e;
+        M[i] = e;
+        T[i].R = Q[i];
+        T[i].t = X[i];
+        T[i].stamp = 0;
+    }
+
+    bench("Quaternion x Vector", Q(0, N), X(0, N), Y, runs);
+    bench("Matrix3x3 x Vector", M(0, N), X(0, N), Y, runs);
+    bench("Transform x Vector", T(0, N), X(0, N), Y, runs);
+    bench("Transform(1) x Vector", T(0, 1), X(0, N), Y, runs);
+    bench("Transform x Transform", T(0, N), T(0, N), Tr, runs);
+
+    // structure of arrays
+    Memory<float, RAM> xs(N), ys(N), zs(N);
+    for(size_t i=0; i<N; i++)
+    {
+        xs[i] = X[i].x;
+        ys[i] = X[i].y;
+        zs[i] = X[i].z;
+    }
+    VectorSoAView Xsoa{xs.raw(), ys.raw(), zs.raw(), N};
+    std::cout << "- " << std::setw(24) << std::left << "Transform(1) x SoA";
+    const simd::Level best = simd::detect();
+    for(int l=0; l<=static_cast<int>(best); l++)
+    {
+        simd::setLevel(static_cast<simd::Level>(l));
+        const double t = measure([&](){ simd::mult(T(0, 1), Xsoa, Xsoa); }, runs);
+        std::cout << (l > 0 ? ", " : " ") << simd::name(simd::level()) << ": " << t * 1000.0 << "ms";
+    }
+    simd::setLevel(best);
+    std::cout << std::endl;
+
+    return 0;
+}
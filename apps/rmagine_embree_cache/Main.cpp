@@ -0,0 +1,66 @@
+#include <iostream>
+
+#include <rmagine/map/EmbreeMap.hpp>
+#include <rmagine/map/embree/embree_cache.h>
+#include <rmagine/map/TiledEmbreeMap.hpp>
+#include <rmagine/util/StopWatch.hpp>
+
+using namespace rmagine;
+
+int main(int argc, char** argv)
+{
+    std::cout << "Rmagine Embree Cache" << std::endl;
+
+    // minimum 2 arguments
+    if(argc < 3)
+    {
+        std::cout << "Converts a mesh file into a scene cache that is memory-mapped by import_embree_map()" << std::endl;
+        std::cout << "Usage: " << argv[0] << " mesh_file cache_file" << std::endl;
+        std::cout << "   or: " << argv[0] << " mesh_file tile_directory tile_size" << std::endl;
+        std::cout << "       to split it into tiles for TiledEmbreeMap" << std::endl;
+        return 0;
+    }
+
+    std::string meshfile = argv[1];
+    std::string cachefile = argv[2];
+
+    std::cout << "Inputs: " << std::endl;
+    std::cout << "- mesh file: " << meshfile << std::endl;
+    std::cout << "- cache file: " << cachefile << std::endl;
+
+    StopWatch sw;
+    double el;
+
+    sw();
+    EmbreeMapPtr map = import_embree_map(meshfile);
+    el = sw();
+    std::cout << "- import: " << el << "s" << std::endl;
+
+    if(argc > 3)
+    {
+        const float tile_size = std::stof(argv[3]);
+        std::cout << "- tile size: " << tile_size << "m" << std::endl;
+
+        sw();
+        const size_t num_tiles = save_tiled_embree_map(map->scene, cachefile, tile_size);
+        el = sw();
+        std::cout << "- save: " << el << "s" << std::endl;
+
+        std::cout << "Done. Wrote " << num_tiles << " tiles." << std::endl;
+        return 0;
+    }
+
+    sw();
+    save_embree_scene(map->scene, cachefile);
+    el = sw();
+    std::cout << "- save: " << el << "s" << std::endl;
+
+    sw();
+    EmbreeScenePtr scene = load_embree_scene(cachefile);
+    el = sw();
+    std::cout << "- load (incl. BVH build): " << el << "s" << std::endl;
+
+    std::cout << "Done. Cached " << scene->findLeafs().size() << " geometries." << std::endl;
+
+    return 0;
+}
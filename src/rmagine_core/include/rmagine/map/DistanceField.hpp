@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief Sparse voxel distance field
+ * 
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_MAP_DISTANCE_FIELD_HPP
+#define RMAGINE_MAP_DISTANCE_FIELD_HPP
+
+#include <rmagine/math/types.h>
+#include <rmagine/types/Memory.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+
+namespace rmagine
+{
+
+/**
+ * @brief Sparse voxel grid of (signed or unsigned) distances to a surface, 
+ * e.g. as cache for point-to-surface distances during scan matching.
+ * 
+ * Distances are sampled on the nodes of a regular grid with spacing voxelSize(). 
+ * Only blocks of BLOCK_SIZE^3 cells near the surface are stored. Every block 
+ * stores the nodes of its far faces as well, so a lookup is one hash lookup 
+ * plus a trilinear interpolation within one block. Distances are truncated 
+ * to [-band, band].
+ * 
+ * Builders: see make_distance_field() of the embree backend
+ */
+class DistanceField
+{
+public:
+    // cells per block edge
+    static constexpr int32_t BLOCK_SIZE = 8;
+    // samples per block edge
+    static constexpr int32_t BLOCK_SAMPLES = BLOCK_SIZE + 1;
+    // samples per block
+    static constexpr size_t BLOCK_VOLUME = BLOCK_SAMPLES * BLOCK_SAMPLES * BLOCK_SAMPLES;
+
+    DistanceField(
+        float voxel_size = 0.1, 
+        float band = 0.5, 
+        bool is_signed = false);
+
+    inline float voxelSize() const 
+    {
+        return m_voxel_size;
+    }
+
+    inline float band() const 
+    {
+        return m_band;
+    }
+
+    inline bool isSigned() const 
+    {
+        return m_signed;
+    }
+
+    inline size_t numBlocks() const
+    {
+        return m_keys.size();
+    }
+
+    ///////////
+    // BUILDING
+
+    /**
+     * @brief Key of the block containing cell (i,j,k)
+     */
+    static uint64_t blockKeyOfCell(int32_t i, int32_t j, int32_t k);
+
+    /**
+     * @brief Key of the block containing p
+     */
+    uint64_t blockKey(const Point& p) const;
+
+    /**
+     * @brief Replace all blocks. All samples are set to band()
+     */
+    void setBlocks(const std::vector<uint64_t>& keys);
+
+    inline uint64_t blockKey(size_t block_id) const
+    {
+        return m_keys[block_id];
+    }
+
+    /**
+     * @brief Position of sample (0,0,0) of a block. Sample (i,j,k) is at 
+     * blockOrigin(block_id) + (i,j,k) * voxelSize()
+     */
+    Point blockOrigin(size_t block_id) const;
+
+    /**
+     * @brief BLOCK_VOLUME samples of a block. Sample (i,j,k) at 
+     * i + BLOCK_SAMPLES * (j + BLOCK_SAMPLES * k)
+     */
+    inline float* blockSamples(size_t block_id)
+    {
+        return m_samples.raw() + block_id * BLOCK_VOLUME;
+    }
+
+    inline const float* blockSamples(size_t block_id) const
+    {
+        return m_samples.raw() + block_id * BLOCK_VOLUME;
+    }
+
+    /////////
+    // LOOKUP
+
+    /**
+     * @brief Trilinear interpolated distance at p
+     * 
+     * @return false if p is not covered by the field
+     */
+    bool distance(const Point& p, float& d) const;
+
+    /**
+     * @brief Trilinear interpolated distance and its gradient at p
+     * 
+     * @return false if p is not covered by the field
+     */
+    bool distance(const Point& p, float& d, Vector& grad) const;
+
+    /**
+     * @brief Batched lookups in parallel. NaN where p is not covered
+     */
+    void distances(
+        const MemoryView<Point, RAM>& ps,
+        MemoryView<float, RAM>& ds) const;
+
+    Memory<float, RAM> distances(
+        const MemoryView<Point, RAM>& ps) const;
+
+    void distances(
+        const MemoryView<Point, RAM>& ps,
+        MemoryView<float, RAM>& ds,
+        MemoryView<Vector, RAM>& grads) const;
+
+    ////////
+    // IO
+
+    void save(const std::string& filename) const;
+
+    static DistanceField load(const std::string& filename);
+
+private:
+    const float* findCell(
+        const Point& p, 
+        float& fx, float& fy, float& fz) const;
+
+    float m_voxel_size;
+    float m_band;
+    bool m_signed;
+
+    // sorted block keys
+    std::vector<uint64_t> m_keys;
+    // key -> block id
+    std::unordered_map<uint64_t, uint32_t> m_block_ids;
+    Memory<float, RAM> m_samples;
+};
+
+using DistanceFieldPtr = std::shared_ptr<DistanceField>;
+
+} // namespace rmagine
+
+#endif // RMAGINE_MAP_DISTANCE_FIELD_HPP
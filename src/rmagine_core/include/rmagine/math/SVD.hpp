@@ -47,6 +47,13 @@
 
 namespace rmagine {
 
+/**
+ * @brief SVD of 3x3 matrices
+ * 
+ * Fixed iteration, branch free Jacobi SVD (McAdams et al. 2011). 
+ * Batched versions are vectorized over groups of 8 matrices 
+ * and parallelized over the groups.
+ */
 class SVD
 {
 public:
@@ -75,6 +82,23 @@ public:
         MemoryView<Matrix3x3, RAM>& Us,
         MemoryView<Vector, RAM>& Ss,
         MemoryView<Matrix3x3, RAM>& Vs) const;
+
+    /**
+     * @brief Rotation of the Kabsch algorithm: R = U * V^T 
+     * with U, V being proper rotations (no reflection correction needed)
+     * 
+     * @param C  cross covariance, e.g. cov(from, to) of centered point sets
+     * @return   R minimizing sum ||R * from_i - to_i||^2
+     */
+    Matrix3x3 kabsch(const Matrix3x3& C) const;
+
+    void kabsch(
+        const MemoryView<Matrix3x3, RAM>& Cs,
+        MemoryView<Matrix3x3, RAM>& Rs) const;
+
+    void kabsch(
+        const MemoryView<Matrix3x3, RAM>& Cs,
+        MemoryView<Quaternion, RAM>& Rs) const;
 };
 
 using SVDPtr = std::shared_ptr<SVD>;
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief Closest points on primitives
+ * 
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_MATH_CLOSEST_POINT_H
+#define RMAGINE_MATH_CLOSEST_POINT_H
+
+#include <rmagine/math/types.h>
+#include <rmagine/types/shared_functions.h>
+
+namespace rmagine
+{
+
+/**
+ * @brief Closest point on triangle (a,b,c) to p
+ * 
+ * Voronoi region tests on dot products only (Ericson, Real-Time Collision 
+ * Detection, 5.1.5): no matrix inversion, no square roots. 
+ * Degenerate triangles return a point on their edges / vertices.
+ */
+template<typename DataT>
+RMAGINE_CONSTEXPR_FUNCTION
+Vector3_<DataT> closestPointTriangle(
+    const Vector3_<DataT>& p,
+    const Vector3_<DataT>& a,
+    const Vector3_<DataT>& b,
+    const Vector3_<DataT>& c)
+{
+    const Vector3_<DataT> ab = b - a;
+    const Vector3_<DataT> ac = c - a;
+
+    // vertex region a
+    const Vector3_<DataT> ap = p - a;
+    const DataT d1 = ab.dot(ap);
+    const DataT d2 = ac.dot(ap);
+    if(d1 <= 0 && d2 <= 0)
+    {
+        return a;
+    }
+
+    // vertex region b
+    const Vector3_<DataT> bp = p - b;
+    const DataT d3 = ab.dot(bp);
+    const DataT d4 = ac.dot(bp);
+    if(d3 >= 0 && d4 <= d3)
+    {
+        return b;
+    }
+
+    // edge region ab
+    const DataT vc = d1 * d4 - d3 * d2;
+    if(vc <= 0 && d1 >= 0 && d3 <= 0)
+    {
+        return a + ab * (d1 / (d1 - d3));
+    }
+
+    // vertex region c
+    const Vector3_<DataT> cp = p - c;
+    const DataT d5 = ab.dot(cp);
+    const DataT d6 = ac.dot(cp);
+    if(d6 >= 0 && d5 <= d6)
+    {
+        return c;
+    }
+
+    // edge region ac
+    const DataT vb = d5 * d2 - d1 * d6;
+    if(vb <= 0 && d2 >= 0 && d6 <= 0)
+    {
+        return a + ac * (d2 / (d2 - d6));
+    }
+
+    // edge region bc
+    const DataT va = d3 * d6 - d5 * d4;
+    if(va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0)
+    {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    // face region: barycentric coordinates (u,v,w) = (va,vb,vc) / (va+vb+vc)
+    const DataT denom = static_cast<DataT>(1) / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+} // namespace rmagine
+
+#endif // RMAGINE_MATH_CLOSEST_POINT_H
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief sqrt, sin and cos usable in constant expressions
+ * 
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_MATH_CONSTEXPR_MATH_H
+#define RMAGINE_MATH_CONSTEXPR_MATH_H
+
+#include <rmagine/types/shared_functions.h>
+#include <limits>
+
+namespace rmagine
+{
+
+/**
+ * The functions of <cmath> cannot be evaluated at compile time (C++17).
+ * These replacements are computed in double and are accurate to a few ulp
+ * for the angles and magnitudes of sensor models. They are meant for 
+ * constant expressions only: at runtime use the functions of <cmath>
+ */
+namespace cx
+{
+
+constexpr double PI = 3.14159265358979323846;
+
+RMAGINE_CONSTEXPR_FUNCTION
+double abs(double x)
+{
+    return (x < 0.0) ? -x : x;
+}
+
+/**
+ * @brief Newton iterations
+ */
+RMAGINE_CONSTEXPR_FUNCTION
+double sqrt(double x)
+{
+    if(x < 0.0 || x != x)
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if(x == 0.0 || x == std::numeric_limits<double>::infinity())
+    {
+        return x;
+    }
+
+    // initial guess: bring x to [0.25, 1) by powers of 4
+    double scale = 1.0;
+    double m = x;
+    while(m >= 1.0)
+    {
+        m *= 0.25;
+        scale *= 2.0;
+    }
+    while(m < 0.25)
+    {
+        m *= 4.0;
+        scale *= 0.5;
+    }
+
+    double r = 0.5 + 0.5 * m;
+    for(unsigned int i=0; i<8; i++)
+    {
+        r = 0.5 * (r + m / r);
+    }
+    return r * scale;
+}
+
+/**
+ * @brief x -> [-pi, pi]
+ */
+RMAGINE_CONSTEXPR_FUNCTION
+double wrap_angle(double x)
+{
+    const double two_pi = 2.0 * PI;
+    const double k = static_cast<double>(static_cast<long long>(x / two_pi));
+    x -= k * two_pi;
+    if(x > PI)
+    {
+        x -= two_pi;
+    } else if(x < -PI) {
+        x += two_pi;
+    }
+    return x;
+}
+
+/**
+ * @brief Taylor series of sin on [-pi/2, pi/2]
+ */
+RMAGINE_CONSTEXPR_FUNCTION
+double sin_taylor(double x)
+{
+    const double x2 = x * x;
+    double term = x;
+    double res = x;
+    for(unsigned int n=1; n<12; n++)
+    {
+        term *= -x2 / static_cast<double>((2 * n) * (2 * n + 1));
+        res += term;
+    }
+    return res;
+}
+
+RMAGINE_CONSTEXPR_FUNCTION
+double sin(double x)
+{
+    x = wrap_angle(x);
+    // sin(x) = sin(pi - x): fold to [-pi/2, pi/2]
+    if(x > PI / 2.0)
+    {
+        x = PI - x;
+    } else if(x < -PI / 2.0) {
+        x = -PI - x;
+    }
+    return sin_taylor(x);
+}
+
+RMAGINE_CONSTEXPR_FUNCTION
+double cos(double x)
+{
+    return sin(x + PI / 2.0);
+}
+
+} // namespace cx
+
+} // namespace rmagine
+
+#endif // RMAGINE_MATH_CONSTEXPR_MATH_H
@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief Lazy elementwise expressions on CPU Memory
+ * 
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_MATH_EXPR_H
+#define RMAGINE_MATH_EXPR_H
+
+#include <rmagine/types/Memory.hpp>
+#include <rmagine/math/types.h>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Elementwise operations on MemoryViews that are only evaluated when 
+ * assigned to a destination. A chain of operations is computed in a single
+ * parallel loop without intermediate buffers:
+ * 
+ * @code
+ * Memory<Vector, RAM> Y(N);
+ * Y = T * (lazy(A) - b); // one pass, no temporaries
+ * Memory<Vector, RAM> Z = lazy(A) + lazy(B) * 2.0f;
+ * @endcode
+ * 
+ * - lazy(view) starts an expression. Every operator (+, -, *, /, unary -)
+ *   with at least one expression operand returns an expression.
+ *   Other operands can be MemoryViews (RAM) or single values, e.g. a Transform.
+ * - Operands of size 1 are broadcast, like the Nx1 / 1xN functions of math.h
+ * - Expressions reference the views they were built from. They must 
+ *   not outlive them. Do not keep expressions on temporaries.
+ * - The destination may appear elementwise in the expression (Y = lazy(Y) * 2.0f),
+ *   but not as broadcast operand of size 1.
+ */
+
+namespace rmagine
+{
+
+/**
+ * @brief CRTP base of all expressions
+ */
+template<typename ExprT>
+class MemoryExpr
+{
+public:
+    inline const ExprT& derived() const
+    {
+        return static_cast<const ExprT&>(*this);
+    }
+
+    inline size_t size() const
+    {
+        return derived().size();
+    }
+
+    inline auto operator[](size_t i) const
+    {
+        return derived()[i];
+    }
+};
+
+/**
+ * @brief Leaf: elements of a view. A view of size 1 is broadcast
+ */
+template<typename DataT>
+class MemoryViewExpr : public MemoryExpr<MemoryViewExpr<DataT> >
+{
+public:
+    using DataType = DataT;
+
+    MemoryViewExpr(const DataT* mem, size_t N)
+    :m_mem(mem)
+    ,m_size(N)
+    ,m_stride(N == 1 ? 0 : 1)
+    {}
+
+    inline size_t size() const
+    {
+        return m_size;
+    }
+
+    inline const DataT& operator[](size_t i) const
+    {
+        return m_mem[i * m_stride];
+    }
+
+private:
+    const DataT* m_mem;
+    size_t m_size;
+    size_t m_stride;
+};
+
+/**
+ * @brief Leaf: a single value, broadcast to all elements
+ */
+template<typename DataT>
+class ValueExpr : public MemoryExpr<ValueExpr<DataT> >
+{
+public:
+    using DataType = DataT;
+
+    ValueExpr(const DataT& value)
+    :m_value(value)
+    {}
+
+    inline size_t size() const
+    {
+        return 1;
+    }
+
+    inline const DataT& operator[](size_t) const
+    {
+        return m_value;
+    }
+
+private:
+    DataT m_value;
+};
+
+namespace expr
+{
+
+struct Add
+{
+    template<typename A, typename B>
+    inline auto operator()(const A& a, const B& b) const -> decltype(a + b)
+    {
+        return a + b;
+    }
+};
+
+struct Sub
+{
+    template<typename A, typename B>
+    inline auto operator()(const A& a, const B& b) const -> decltype(a - b)
+    {
+        return a - b;
+    }
+};
+
+struct Mul
+{
+    template<typename A, typename B>
+    inline auto operator()(const A& a, const B& b) const -> decltype(a * b)
+    {
+        return a * b;
+    }
+};
+
+struct Div
+{
+    template<typename A, typename B>
+    inline auto operator()(const A& a, const B& b) const -> decltype(a / b)
+    {
+        return a / b;
+    }
+};
+
+struct Neg
+{
+    template<typename A>
+    inline auto operator()(const A& a) const -> decltype(-a)
+    {
+        return -a;
+    }
+};
+
+// size of an elementwise combination. size 1 is broadcast
+size_t combine_sizes(size_t a, size_t b);
+
+} // namespace expr
+
+template<typename LhsT, typename RhsT, typename OpT>
+class BinaryExpr : public MemoryExpr<BinaryExpr<LhsT, RhsT, OpT> >
+{
+public:
+    using DataType = typename std::decay<decltype(OpT()(
+        std::declval<typename LhsT::DataType>(), 
+        std::declval<typename RhsT::DataType>()))>::type;
+
+    BinaryExpr(const LhsT& lhs, const RhsT& rhs)
+    :m_lhs(lhs)
+    ,m_rhs(rhs)
+    ,m_size(expr::combine_sizes(lhs.size(), rhs.size()))
+    {}
+
+    inline size_t size() const
+    {
+        return m_size;
+    }
+
+    inline DataType operator[](size_t i) const
+    {
+        return OpT()(m_lhs[i], m_rhs[i]);
+    }
+
+private:
+    // leaves are small: store by value
+    LhsT m_lhs;
+    RhsT m_rhs;
+    size_t m_size;
+};
+
+template<typename ArgT, typename OpT>
+class UnaryExpr : public MemoryExpr<UnaryExpr<ArgT, OpT> >
+{
+public:
+    using DataType = typename std::decay<decltype(OpT()(
+        std::declval<typename ArgT::DataType>()))>::type;
+
+    UnaryExpr(const ArgT& arg)
+    :m_arg(arg)
+    {}
+
+    inline size_t size() const
+    {
+        return m_arg.size();
+    }
+
+    inline DataType operator[](size_t i) const
+    {
+        return OpT()(m_arg[i]);
+    }
+
+private:
+    ArgT m_arg;
+};
+
+/**
+ * @brief start a lazy expression on a view
+ */
+template<typename DataT>
+inline MemoryViewExpr<DataT> lazy(const MemoryView<DataT, RAM>& X)
+{
+    return MemoryViewExpr<DataT>(X.raw(), X.size());
+}
+
+namespace expr
+{
+
+template<typename DataT>
+std::true_type is_ram_view_impl(const MemoryView<DataT, RAM>*);
+std::false_type is_ram_view_impl(...);
+
+template<typename T>
+struct is_ram_view : decltype(is_ram_view_impl(std::declval<T*>())) {};
+
+template<typename ExprT>
+std::true_type is_expr_impl(const MemoryExpr<ExprT>*);
+std::false_type is_expr_impl(...);
+
+template<typename T>
+struct is_expr : decltype(is_expr_impl(std::declval<T*>())) {};
+
+// operands of expressions: expressions, views (incl. Memory) or values
+template<typename T>
+inline auto make_operand(const T& x)
+{
+    if constexpr(is_expr<T>::value)
+    {
+        return x;
+    } else if constexpr(is_ram_view<T>::value) {
+        return lazy(x);
+    } else {
+        return ValueExpr<T>(x);
+    }
+}
+
+template<typename T>
+using operand_t = decltype(make_operand(std::declval<T>()));
+
+// enables the operators if at least one side is an expression.
+// The result type is only formed for enabled operators
+template<bool Enable, typename LhsT, typename RhsT, typename OpT>
+struct binary_result {};
+
+template<typename LhsT, typename RhsT, typename OpT>
+struct binary_result<true, LhsT, RhsT, OpT>
+{
+    using type = BinaryExpr<operand_t<LhsT>, operand_t<RhsT>, OpT>;
+};
+
+template<typename LhsT, typename RhsT, typename OpT>
+using enable_binary_t = typename binary_result<
+    (is_expr<LhsT>::value || is_expr<RhsT>::value), 
+    LhsT, RhsT, OpT>::type;
+
+} // namespace expr
+
+template<typename LhsT, typename RhsT>
+inline expr::enable_binary_t<LhsT, RhsT, expr::Add> operator+(
+    const LhsT& lhs, const RhsT& rhs)
+{
+    return {expr::make_operand(lhs), expr::make_operand(rhs)};
+}
+
+template<typename LhsT, typename RhsT>
+inline expr::enable_binary_t<LhsT, RhsT, expr::Sub> operator-(
+    const LhsT& lhs, const RhsT& rhs)
+{
+    return {expr::make_operand(lhs), expr::make_operand(rhs)};
+}
+
+template<typename LhsT, typename RhsT>
+inline expr::enable_binary_t<LhsT, RhsT, expr::Mul> operator*(
+    const LhsT& lhs, const RhsT& rhs)
+{
+    return {expr::make_operand(lhs), expr::make_operand(rhs)};
+}
+
+template<typename LhsT, typename RhsT>
+inline expr::enable_binary_t<LhsT, RhsT, expr::Div> operator/(
+    const LhsT& lhs, const RhsT& rhs)
+{
+    return {expr::make_operand(lhs), expr::make_operand(rhs)};
+}
+
+template<typename ExprT>
+inline UnaryExpr<ExprT, expr::Neg> operator-(const MemoryExpr<ExprT>& e)
+{
+    return {e.derived()};
+}
+
+/**
+ * @brief evaluate an expression into dst in one parallel pass
+ */
+template<typename DataT, typename ExprT>
+void eval(const MemoryExpr<ExprT>& e, MemoryView<DataT, RAM>& dst);
+
+} // namespace rmagine
+
+#include "expr.tcc"
+
+#endif // RMAGINE_MATH_EXPR_H
@@ -0,0 +1,72 @@
+#include "expr.h"
+#include <rmagine/util/exceptions.h>
+
+namespace rmagine
+{
+
+namespace expr
+{
+
+inline size_t combine_sizes(size_t a, size_t b)
+{
+    if(a != b && a != 1 && b != 1)
+    {
+        RM_THROW(Exception, "Expression: operands of different sizes.");
+    }
+    return (a == 1 ? b : a);
+}
+
+} // namespace expr
+
+template<typename DataT, typename ExprT>
+void eval(const MemoryExpr<ExprT>& e, MemoryView<DataT, RAM>& dst)
+{
+    const ExprT& ex = e.derived();
+    if(ex.size() != dst.size() && ex.size() != 1)
+    {
+        RM_THROW(Exception, "Expression: size of destination does not match.");
+    }
+
+    #pragma omp parallel for
+    for(size_t i=0; i<dst.size(); i++)
+    {
+        dst[i] = ex[i];
+    }
+}
+
+template<typename DataT, typename MemT>
+template<typename ExprT>
+MemoryView<DataT, MemT>& MemoryView<DataT, MemT>::operator=(
+    const MemoryExpr<ExprT>& e)
+{
+    static_assert(std::is_same<MemT, RAM>::value, 
+        "Expressions can only be evaluated into RAM");
+    eval(e, *this);
+    return *this;
+}
+
+template<typename DataT, typename MemT>
+template<typename ExprT>
+Memory<DataT, MemT>::Memory(const MemoryExpr<ExprT>& e)
+:Memory(e.size())
+{
+    Base::operator=(e);
+}
+
+template<typename DataT, typename MemT>
+template<typename ExprT>
+Memory<DataT, MemT>& Memory<DataT, MemT>::operator=(
+    const MemoryExpr<ExprT>& e)
+{
+    if(e.size() != this->size())
+    {
+        // e may read from *this (a = a + b with broadcasting): 
+        // evaluate before the old buffer is released
+        *this = Memory<DataT, MemT>(e);
+        return *this;
+    }
+    Base::operator=(e);
+    return *this;
+}
+
+} // namespace rmagine
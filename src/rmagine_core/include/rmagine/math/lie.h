@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief Lie group operations on SO(3) and SE(3)
+ * 
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_MATH_LIE_H
+#define RMAGINE_MATH_LIE_H
+
+#include <rmagine/math/types.h>
+#include <rmagine/types/Memory.hpp>
+#include <rmagine/types/shared_functions.h>
+
+/**
+ * Exponential and logarithmic maps between the tangent spaces and 
+ * Quaternion / Transform. 
+ * 
+ * - so(3): Vector3 w (axis * angle)
+ * - se(3): Vector6 (w, v). Unlike (R, t) = (exp(w), v), the translation 
+ *   is coupled with the rotation: t = V(w) * v
+ * 
+ * Perturbations are applied from the right (in the local frame):
+ * - boxplus(T, xi) = T * exp(xi)
+ * - boxminus(T1, T2) = log(T2^-1 * T1), so that boxplus(T2, boxminus(T1, T2)) = T1
+ * 
+ * Small angles are handled with Taylor expansions.
+ * Single element versions can be used in host and device code.
+ * Batched versions for RAM are parallelized.
+ */
+
+namespace rmagine
+{
+
+//////////
+// Single elements
+
+template<typename DataT>
+RMAGINE_INLINE_FUNCTION
+Quaternion_<DataT> so3Exp(const Vector3_<DataT>& w);
+
+/**
+ * @brief angle in [0, pi]
+ */
+template<typename DataT>
+RMAGINE_INLINE_FUNCTION
+Vector3_<DataT> so3Log(const Quaternion_<DataT>& q);
+
+template<typename DataT>
+RMAGINE_INLINE_FUNCTION
+Transform_<DataT> se3Exp(const Vector6_<DataT>& xi);
+
+template<typename DataT>
+RMAGINE_INLINE_FUNCTION
+Vector6_<DataT> se3Log(const Transform_<DataT>& T);
+
+/**
+ * @brief Ad_T * xi. Moves a tangent vector from the frame of T to its parent frame:
+ * T * exp(xi) = exp(Ad_T * xi) * T
+ */
+template<typename DataT>
+RMAGINE_INLINE_FUNCTION
+Vector6_<DataT> se3Adjoint(const Transform_<DataT>& T, const Vector6_<DataT>& xi);
+
+template<typename DataT>
+RMAGINE_INLINE_FUNCTION
+Transform_<DataT> boxplus(const Transform_<DataT>& T, const Vector6_<DataT>& xi);
+
+template<typename DataT>
+RMAGINE_INLINE_FUNCTION
+Vector6_<DataT> boxminus(const Transform_<DataT>& T1, const Transform_<DataT>& T2);
+
+//////////
+// Batched. Inputs of size 1 are broadcast
+
+void so3Exp(
+    const MemoryView<Vector, RAM>& w,
+    MemoryView<Quaternion, RAM>& q);
+
+Memory<Quaternion, RAM> so3Exp(
+    const MemoryView<Vector, RAM>& w);
+
+void so3Log(
+    const MemoryView<Quaternion, RAM>& q,
+    MemoryView<Vector, RAM>& w);
+
+Memory<Vector, RAM> so3Log(
+    const MemoryView<Quaternion, RAM>& q);
+
+void se3Exp(
+    const MemoryView<Vector6, RAM>& xi,
+    MemoryView<Transform, RAM>& T);
+
+Memory<Transform, RAM> se3Exp(
+    const MemoryView<Vector6, RAM>& xi);
+
+void se3Log(
+    const MemoryView<Transform, RAM>& T,
+    MemoryView<Vector6, RAM>& xi);
+
+Memory<Vector6, RAM> se3Log(
+    const MemoryView<Transform, RAM>& T);
+
+/**
+ * @brief Tr = T * exp(xi). Tr may be T for in-place updates
+ */
+void boxplus(
+    const MemoryView<Transform, RAM>& T,
+    const MemoryView<Vector6, RAM>& xi,
+    MemoryView<Transform, RAM>& Tr);
+
+Memory<Transform, RAM> boxplus(
+    const MemoryView<Transform, RAM>& T,
+    const MemoryView<Vector6, RAM>& xi);
+
+/**
+ * @brief xi = log(T2^-1 * T1)
+ */
+void boxminus(
+    const MemoryView<Transform, RAM>& T1,
+    const MemoryView<Transform, RAM>& T2,
+    MemoryView<Vector6, RAM>& xi);
+
+Memory<Vector6, RAM> boxminus(
+    const MemoryView<Transform, RAM>& T1,
+    const MemoryView<Transform, RAM>& T2);
+
+} // namespace rmagine
+
+#include "lie.tcc"
+
+#endif // RMAGINE_MATH_LIE_H
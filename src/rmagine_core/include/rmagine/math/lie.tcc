@@ -0,0 +1,144 @@
+#include "lie.h"
+#include <math.h>
+
+namespace rmagine
+{
+
+namespace lie
+{
+
+// below: Taylor expansions of sin(x)/x like terms
+template<typename DataT>
+RMAGINE_INLINE_FUNCTION
+DataT small_angle()
+{
+    return static_cast<DataT>(sizeof(DataT) == sizeof(float) ? 1e-3 : 1e-6);
+}
+
+// below: Taylor expansions of the V coefficients. Their closed forms 
+// suffer from cancellation ((1 - cos(x)) / x^2, ...), especially in float
+template<typename DataT>
+RMAGINE_INLINE_FUNCTION
+DataT taylor_angle()
+{
+    return static_cast<DataT>(sizeof(DataT) == sizeof(float) ? 0.1 : 1e-3);
+}
+
+} // namespace lie
+
+template<typename DataT>
+RMAGINE_INLINE_FUNCTION
+Quaternion_<DataT> so3Exp(const Vector3_<DataT>& w)
+{
+    const DataT theta2 = w.l2normSquared();
+    const DataT theta = sqrt(theta2);
+    // sin(theta / 2) / theta
+    const DataT s = (theta < lie::small_angle<DataT>()) 
+        ? static_cast<DataT>(0.5) - theta2 / static_cast<DataT>(48.0)
+        : sin(theta / static_cast<DataT>(2.0)) / theta;
+    return {w.x * s, w.y * s, w.z * s, cos(theta / static_cast<DataT>(2.0))};
+}
+
+template<typename DataT>
+RMAGINE_INLINE_FUNCTION
+Vector3_<DataT> so3Log(const Quaternion_<DataT>& q)
+{
+    // q and -q are the same rotation: use the one with w >= 0 -> angle <= pi
+    const DataT sgn = (q.w < static_cast<DataT>(0.0)) ? static_cast<DataT>(-1.0) : static_cast<DataT>(1.0);
+    const DataT qw = sgn * q.w;
+    const Vector3_<DataT> qv{sgn * q.x, sgn * q.y, sgn * q.z};
+
+    const DataT n2 = qv.l2normSquared();
+    const DataT n = sqrt(n2);
+    // theta / sin(theta / 2), theta = 2 * atan2(n, qw)
+    const DataT f = (n < lie::small_angle<DataT>()) 
+        ? static_cast<DataT>(2.0) / qw - static_cast<DataT>(2.0) * n2 / (static_cast<DataT>(3.0) * qw * qw * qw)
+        : static_cast<DataT>(2.0) * atan2(n, qw) / n;
+    return qv * f;
+}
+
+template<typename DataT>
+RMAGINE_INLINE_FUNCTION
+Transform_<DataT> se3Exp(const Vector6_<DataT>& xi)
+{
+    const Vector3_<DataT>& w = xi.w;
+    const DataT theta2 = w.l2normSquared();
+    const DataT theta = sqrt(theta2);
+
+    // V = I + a * W + b * W^2
+    DataT a, b;
+    if(theta < lie::taylor_angle<DataT>())
+    {
+        const DataT theta4 = theta2 * theta2;
+        a = static_cast<DataT>(0.5) - theta2 / static_cast<DataT>(24.0) + theta4 / static_cast<DataT>(720.0);
+        b = static_cast<DataT>(1.0 / 6.0) - theta2 / static_cast<DataT>(120.0) + theta4 / static_cast<DataT>(5040.0);
+    } else {
+        a = (static_cast<DataT>(1.0) - cos(theta)) / theta2;
+        b = (theta - sin(theta)) / (theta2 * theta);
+    }
+
+    const Vector3_<DataT> wxv = w.cross(xi.v);
+    const Vector3_<DataT> wxwxv = w.cross(wxv);
+
+    Transform_<DataT> T;
+    T.R = so3Exp(w);
+    T.t = xi.v + wxv * a + wxwxv * b;
+    T.stamp = 0;
+    return T;
+}
+
+template<typename DataT>
+RMAGINE_INLINE_FUNCTION
+Vector6_<DataT> se3Log(const Transform_<DataT>& T)
+{
+    Vector6_<DataT> xi;
+    xi.w = so3Log(T.R);
+
+    const Vector3_<DataT>& w = xi.w;
+    const DataT theta2 = w.l2normSquared();
+    const DataT theta = sqrt(theta2);
+
+    // V^-1 = I - 1/2 * W + c * W^2
+    DataT c;
+    if(theta < lie::taylor_angle<DataT>())
+    {
+        c = static_cast<DataT>(1.0 / 12.0) + theta2 / static_cast<DataT>(720.0) 
+            + theta2 * theta2 / static_cast<DataT>(30240.0);
+    } else {
+        c = (static_cast<DataT>(1.0) - theta * sin(theta) 
+            / (static_cast<DataT>(2.0) * (static_cast<DataT>(1.0) - cos(theta)))) / theta2;
+    }
+
+    const Vector3_<DataT> wxt = w.cross(T.t);
+    const Vector3_<DataT> wxwxt = w.cross(wxt);
+    xi.v = T.t - wxt * static_cast<DataT>(0.5) + wxwxt * c;
+    return xi;
+}
+
+template<typename DataT>
+RMAGINE_INLINE_FUNCTION
+Vector6_<DataT> se3Adjoint(const Transform_<DataT>& T, const Vector6_<DataT>& xi)
+{
+    Vector6_<DataT> ret;
+    ret.w = T.R * xi.w;
+    ret.v = T.R * xi.v + T.t.cross(ret.w);
+    return ret;
+}
+
+template<typename DataT>
+RMAGINE_INLINE_FUNCTION
+Transform_<DataT> boxplus(const Transform_<DataT>& T, const Vector6_<DataT>& xi)
+{
+    Transform_<DataT> ret = T * se3Exp(xi);
+    ret.stamp = T.stamp;
+    return ret;
+}
+
+template<typename DataT>
+RMAGINE_INLINE_FUNCTION
+Vector6_<DataT> boxminus(const Transform_<DataT>& T1, const Transform_<DataT>& T2)
+{
+    return se3Log(T2.inv() * T1);
+}
+
+} // namespace rmagine
@@ -41,11 +41,178 @@
 #ifndef RMAGINE_MATH_MATH_BATCHED_H
 #define RMAGINE_MATH_MATH_BATCHED_H
 
+#include <rmagine/math/types.h>
+#include <rmagine/types/Memory.hpp>
 
+/**
+ * Segmented reductions over flat buffers. A buffer of size N is split into 
+ * N / batchSize consecutive batches, e.g. one batch per pose of a simulation.
+ * All batches are computed in one parallel pass, large batches are additionally
+ * split into blocks. Accumulation is done in double precision.
+ * 
+ * Same interface as the CUDA versions in math_batched.cuh
+ */
 
 namespace rmagine
 {
 
+//////////
+// #sumBatched
+void sumBatched(
+    const MemoryView<Vector, RAM>& data,
+    MemoryView<Vector, RAM>& sums);
+
+Memory<Vector, RAM> sumBatched(
+    const MemoryView<Vector, RAM>& data,
+    size_t batchSize);
+
+void sumBatched(
+    const MemoryView<Matrix3x3, RAM>& data,
+    MemoryView<Matrix3x3, RAM>& sums);
+
+Memory<Matrix3x3, RAM> sumBatched(
+    const MemoryView<Matrix3x3, RAM>& data,
+    size_t batchSize);
+
+void sumBatched(
+    const MemoryView<float, RAM>& data,
+    MemoryView<float, RAM>& sums);
+
+Memory<float, RAM> sumBatched(
+    const MemoryView<float, RAM>& data,
+    size_t batchSize);
+
+void sumBatched(
+    const MemoryView<unsigned int, RAM>& data,
+    MemoryView<unsigned int, RAM>& sums);
+
+Memory<unsigned int, RAM> sumBatched(
+    const MemoryView<unsigned int, RAM>& data,
+    size_t batchSize);
+
+//////////
+// #sumBatched masked
+// only elements with mask[i] != 0 are summed up. uint8_t masks are 
+// the format of simulated hits (Hits<RAM>::hits)
+void sumBatched(
+    const MemoryView<Vector, RAM>& data,
+    const MemoryView<bool, RAM>& mask,
+    MemoryView<Vector, RAM>& sums);
+
+Memory<Vector, RAM> sumBatched(
+    const MemoryView<Vector, RAM>& data,
+    const MemoryView<bool, RAM>& mask,
+    size_t batchSize);
+
+void sumBatched(
+    const MemoryView<Vector, RAM>& data,
+    const MemoryView<unsigned int, RAM>& mask,
+    MemoryView<Vector, RAM>& sums);
+
+Memory<Vector, RAM> sumBatched(
+    const MemoryView<Vector, RAM>& data,
+    const MemoryView<unsigned int, RAM>& mask,
+    size_t batchSize);
+
+void sumBatched(
+    const MemoryView<Vector, RAM>& data,
+    const MemoryView<uint8_t, RAM>& mask,
+    MemoryView<Vector, RAM>& sums);
+
+Memory<Vector, RAM> sumBatched(
+    const MemoryView<Vector, RAM>& data,
+    const MemoryView<uint8_t, RAM>& mask,
+    size_t batchSize);
+
+/**
+ * @brief Number of elements with mask[i] != 0 per batch
+ */
+void countBatched(
+    const MemoryView<uint8_t, RAM>& mask,
+    MemoryView<unsigned int, RAM>& counts);
+
+Memory<unsigned int, RAM> countBatched(
+    const MemoryView<uint8_t, RAM>& mask,
+    size_t batchSize);
+
+//////////
+// #meanBatched
+void meanBatched(
+    const MemoryView<Vector, RAM>& data,
+    MemoryView<Vector, RAM>& means);
+
+Memory<Vector, RAM> meanBatched(
+    const MemoryView<Vector, RAM>& data,
+    size_t batchSize);
+
+void meanBatched(
+    const MemoryView<float, RAM>& data,
+    MemoryView<float, RAM>& means);
+
+Memory<float, RAM> meanBatched(
+    const MemoryView<float, RAM>& data,
+    size_t batchSize);
+
+/**
+ * @brief Mean of all elements with mask[i] != 0 per batch. 
+ * Batches without valid elements result in zero
+ */
+void meanBatched(
+    const MemoryView<Vector, RAM>& data,
+    const MemoryView<uint8_t, RAM>& mask,
+    MemoryView<Vector, RAM>& means);
+
+Memory<Vector, RAM> meanBatched(
+    const MemoryView<Vector, RAM>& data,
+    const MemoryView<uint8_t, RAM>& mask,
+    size_t batchSize);
+
+////////
+// #covBatched   C = (m1 * m2.T) / batchSize
+void covBatched(
+    const MemoryView<Vector, RAM>& m1, 
+    const MemoryView<Vector, RAM>& m2,
+    MemoryView<Matrix3x3, RAM>& covs);
+
+Memory<Matrix3x3, RAM> covBatched(
+    const MemoryView<Vector, RAM>& m1, 
+    const MemoryView<Vector, RAM>& m2,
+    unsigned int batchSize);
+
+/**
+ * @brief Covariances of corresponding points only, normalized by 
+ * the number of correspondences ncorr of each batch. Zero without correspondences
+ */
+void covBatched(
+    const MemoryView<Vector, RAM>& m1, 
+    const MemoryView<Vector, RAM>& m2,
+    const MemoryView<bool, RAM>& corr,
+    const MemoryView<unsigned int, RAM>& ncorr,
+    MemoryView<Matrix3x3, RAM>& covs);
+
+Memory<Matrix3x3, RAM> covBatched(
+    const MemoryView<Vector, RAM>& m1, 
+    const MemoryView<Vector, RAM>& m2,
+    const MemoryView<bool, RAM>& corr,
+    const MemoryView<unsigned int, RAM>& ncorr,
+    unsigned int batchSize);
+
+/**
+ * @brief Covariances of elements with mask[i] != 0, normalized by their number.
+ * Batches without valid elements result in zero
+ */
+void covBatched(
+    const MemoryView<Vector, RAM>& m1, 
+    const MemoryView<Vector, RAM>& m2,
+    const MemoryView<uint8_t, RAM>& mask,
+    MemoryView<Matrix3x3, RAM>& covs);
+
+Memory<Matrix3x3, RAM> covBatched(
+    const MemoryView<Vector, RAM>& m1, 
+    const MemoryView<Vector, RAM>& m2,
+    const MemoryView<uint8_t, RAM>& mask,
+    unsigned int batchSize);
+
 } // namespace rmagine
 
 #endif // RMAGINE_MATH_MATH_BATCHED_H
\ No newline at end of file
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief Parallel scan, compaction, partition and gather/scatter for CPU Memory
+ * 
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_MATH_PRIMITIVES_H
+#define RMAGINE_MATH_PRIMITIVES_H
+
+#include <rmagine/types/Memory.hpp>
+#include <functional>
+#include <cstdint>
+
+/**
+ * All functions split the input into blocks that fit into the cache and 
+ * work in two parallel passes: 
+ * 1. reduce/count every block
+ * 2. scan the block results, then write every block at its offset
+ * 
+ * Compaction and partitions are stable. Inputs of up to one block 
+ * are processed serially. Only the scans can work in-place, the outputs 
+ * of all other functions must not overlap their inputs.
+ */
+
+namespace rmagine
+{
+
+//////////
+// #scan
+/**
+ * @brief out[i] = in[0] op ... op in[i]. out may be in
+ * 
+ * @return the total
+ */
+template<typename DataT, typename OpT = std::plus<DataT> >
+DataT inclusive_scan(
+    const MemoryView<DataT, RAM>& in,
+    MemoryView<DataT, RAM>& out,
+    OpT op = OpT());
+
+/**
+ * @brief out[i] = init op in[0] op ... op in[i-1]. out may be in
+ * 
+ * @return the total: init op in[0] op ... op in[N-1]
+ */
+template<typename DataT, typename OpT = std::plus<DataT> >
+DataT exclusive_scan(
+    const MemoryView<DataT, RAM>& in,
+    MemoryView<DataT, RAM>& out,
+    DataT init = DataT(0),
+    OpT op = OpT());
+
+//////////
+// #compact
+/**
+ * @brief copies the elements with pred(in[i]) == true to the front of out
+ * 
+ * @param out  at least as large as the number of selected elements
+ * @return number of selected elements
+ */
+template<typename DataT, typename PredT>
+size_t compact_if(
+    const MemoryView<DataT, RAM>& in,
+    MemoryView<DataT, RAM>& out,
+    PredT pred);
+
+template<typename DataT, typename PredT>
+Memory<DataT, RAM> compact_if(
+    const MemoryView<DataT, RAM>& in,
+    PredT pred);
+
+/**
+ * @brief copies the elements with mask[i] != 0 to the front of out, 
+ * e.g. to drop misses with Hits<RAM>::hits as mask
+ */
+template<typename DataT, typename MaskT>
+size_t compact(
+    const MemoryView<DataT, RAM>& in,
+    const MemoryView<MaskT, RAM>& mask,
+    MemoryView<DataT, RAM>& out);
+
+template<typename DataT, typename MaskT>
+Memory<DataT, RAM> compact(
+    const MemoryView<DataT, RAM>& in,
+    const MemoryView<MaskT, RAM>& mask);
+
+//////////
+// #partition
+/**
+ * @brief Stable partition: elements with pred(in[i]) == true first, then the others
+ * 
+ * @return number of elements with pred(in[i]) == true
+ */
+template<typename DataT, typename PredT>
+size_t partition(
+    const MemoryView<DataT, RAM>& in,
+    MemoryView<DataT, RAM>& out,
+    PredT pred);
+
+/**
+ * @brief Stable partition into Nbuckets buckets by keys (counting sort), 
+ * e.g. rays bucketed by ObjectIds. Bucket k ends up in 
+ * out[offsets[k], offsets[k+1]). Elements with keys >= Nbuckets are dropped
+ * 
+ * @param offsets  size Nbuckets + 1
+ */
+template<typename DataT, typename KeyT>
+void partition(
+    const MemoryView<DataT, RAM>& in,
+    const MemoryView<KeyT, RAM>& keys,
+    size_t Nbuckets,
+    MemoryView<DataT, RAM>& out,
+    MemoryView<unsigned int, RAM>& offsets);
+
+//////////
+// #gather/scatter
+/**
+ * @brief out[i] = in[ids[i]]
+ */
+template<typename DataT, typename IndexT>
+void gather(
+    const MemoryView<DataT, RAM>& in,
+    const MemoryView<IndexT, RAM>& ids,
+    MemoryView<DataT, RAM>& out);
+
+template<typename DataT, typename IndexT>
+Memory<DataT, RAM> gather(
+    const MemoryView<DataT, RAM>& in,
+    const MemoryView<IndexT, RAM>& ids);
+
+/**
+ * @brief out[ids[i]] = in[i]. ids must not contain duplicates
+ */
+template<typename DataT, typename IndexT>
+void scatter(
+    const MemoryView<DataT, RAM>& in,
+    const MemoryView<IndexT, RAM>& ids,
+    MemoryView<DataT, RAM>& out);
+
+} // namespace rmagine
+
+#include "primitives.tcc"
+
+#endif // RMAGINE_MATH_PRIMITIVES_H
@@ -0,0 +1,442 @@
+#include "primitives.h"
+#include <rmagine/util/exceptions.h>
+#include <vector>
+#include <algorithm>
+
+namespace rmagine
+{
+
+namespace primitives
+{
+
+// elements per block. Small enough for the L2 cache 
+// so that the second pass reads the input from cache
+static constexpr size_t BLOCK_SIZE = 16384;
+
+inline size_t num_blocks(size_t N)
+{
+    return (N + BLOCK_SIZE - 1) / BLOCK_SIZE;
+}
+
+/**
+ * @brief two pass block scheme:
+ * 1. counts[b] = count_func(id_begin, id_end) for every non-empty block
+ * 2. exclusive scan of counts with op, starting at init (serial over blocks)
+ * 3. write_func(id_begin, id_end, offset) for every block
+ * 
+ * @return init op counts[0] op ... op counts[Nblocks-1]
+ */
+template<typename CountT, typename OpT, typename CountFuncT, typename WriteFuncT>
+CountT blocked_two_pass(
+    size_t N,
+    CountT init,
+    OpT op,
+    CountFuncT count_func,
+    WriteFuncT write_func)
+{
+    const size_t Nblocks = num_blocks(N);
+    if(Nblocks == 0)
+    {
+        return init;
+    }
+    if(Nblocks == 1)
+    {
+        // count first: write_func may overwrite the input
+        const CountT total = op(init, count_func(0, N));
+        write_func(0, N, init);
+        return total;
+    }
+
+    std::vector<CountT> offsets(Nblocks);
+
+    #pragma omp parallel for schedule(static)
+    for(size_t b=0; b<Nblocks; b++)
+    {
+        offsets[b] = count_func(b * BLOCK_SIZE, std::min(N, (b + 1) * BLOCK_SIZE));
+    }
+
+    CountT total = init;
+    for(size_t b=0; b<Nblocks; b++)
+    {
+        const CountT c = offsets[b];
+        offsets[b] = total;
+        total = op(total, c);
+    }
+
+    #pragma omp parallel for schedule(static)
+    for(size_t b=0; b<Nblocks; b++)
+    {
+        write_func(b * BLOCK_SIZE, std::min(N, (b + 1) * BLOCK_SIZE), offsets[b]);
+    }
+
+    return total;
+}
+
+} // namespace primitives
+
+template<typename DataT, typename OpT>
+DataT inclusive_scan(
+    const MemoryView<DataT, RAM>& in,
+    MemoryView<DataT, RAM>& out,
+    OpT op)
+{
+    if(out.size() < in.size())
+    {
+        RM_THROW(Exception, "inclusive_scan: output is too small.");
+    }
+    if(in.size() == 0)
+    {
+        return DataT(0);
+    }
+
+    const DataT* src = in.raw();
+    DataT* dst = out.raw();
+
+    // offsets are the exclusive prefixes of the blocks: start the blocks 
+    // with their first element instead of an identity of op
+    const size_t Nblocks = primitives::num_blocks(in.size());
+    std::vector<DataT> sums(Nblocks);
+
+    #pragma omp parallel for schedule(static) if(Nblocks > 1)
+    for(size_t b=0; b<Nblocks; b++)
+    {
+        const size_t id_b = b * primitives::BLOCK_SIZE;
+        const size_t id_e = std::min(in.size(), id_b + primitives::BLOCK_SIZE);
+        DataT acc = src[id_b];
+        for(size_t i=id_b+1; i<id_e; i++)
+        {
+            acc = op(acc, src[i]);
+        }
+        sums[b] = acc;
+    }
+
+    for(size_t b=1; b<Nblocks; b++)
+    {
+        sums[b] = op(sums[b-1], sums[b]);
+    }
+
+    #pragma omp parallel for schedule(static) if(Nblocks > 1)
+    for(size_t b=0; b<Nblocks; b++)
+    {
+        const size_t id_b = b * primitives::BLOCK_SIZE;
+        const size_t id_e = std::min(in.size(), id_b + primitives::BLOCK_SIZE);
+        DataT acc = (b == 0) ? src[id_b] : op(sums[b-1], src[id_b]);
+        dst[id_b] = acc;
+        for(size_t i=id_b+1; i<id_e; i++)
+        {
+            acc = op(acc, src[i]);
+            dst[i] = acc;
+        }
+    }
+
+    return sums[Nblocks - 1];
+}
+
+template<typename DataT, typename OpT>
+DataT exclusive_scan(
+    const MemoryView<DataT, RAM>& in,
+    MemoryView<DataT, RAM>& out,
+    DataT init,
+    OpT op)
+{
+    if(out.size() < in.size())
+    {
+        RM_THROW(Exception, "exclusive_scan: output is too small.");
+    }
+
+    const DataT* src = in.raw();
+    DataT* dst = out.raw();
+
+    return primitives::blocked_two_pass(in.size(), init, op,
+        [&](size_t id_b, size_t id_e) {
+            DataT acc = src[id_b];
+            for(size_t i=id_b+1; i<id_e; i++)
+            {
+                acc = op(acc, src[i]);
+            }
+            return acc;
+        },
+        [&](size_t id_b, size_t id_e, DataT offset) {
+            // in-place safe: read before write
+            DataT acc = offset;
+            for(size_t i=id_b; i<id_e; i++)
+            {
+                const DataT x = src[i];
+                dst[i] = acc;
+                acc = op(acc, x);
+            }
+        });
+}
+
+namespace primitives
+{
+
+// compaction with a predicate on the index
+template<typename DataT, typename PredT>
+size_t compact_ids(
+    const MemoryView<DataT, RAM>& in,
+    MemoryView<DataT, RAM>& out,
+    PredT pred)
+{
+    const DataT* src = in.raw();
+    DataT* dst = out.raw();
+    const size_t Nout = out.size();
+
+    const size_t Nselected = blocked_two_pass(in.size(), size_t(0), std::plus<size_t>(),
+        [&](size_t id_b, size_t id_e) {
+            size_t n = 0;
+            for(size_t i=id_b; i<id_e; i++)
+            {
+                n += static_cast<bool>(pred(i));
+            }
+            return n;
+        },
+        [&](size_t id_b, size_t id_e, size_t offset) {
+            for(size_t i=id_b; i<id_e; i++)
+            {
+                if(pred(i))
+                {
+                    if(offset < Nout)
+                    {
+                        dst[offset] = src[i];
+                    }
+                    offset++;
+                }
+            }
+        });
+
+    if(Nselected > Nout)
+    {
+        RM_THROW(Exception, "compact: output is too small.");
+    }
+    return Nselected;
+}
+
+} // namespace primitives
+
+template<typename DataT, typename PredT>
+size_t compact_if(
+    const MemoryView<DataT, RAM>& in,
+    MemoryView<DataT, RAM>& out,
+    PredT pred)
+{
+    const DataT* src = in.raw();
+    return primitives::compact_ids(in, out, [&](size_t i) {
+        return pred(src[i]);
+    });
+}
+
+template<typename DataT, typename PredT>
+Memory<DataT, RAM> compact_if(
+    const MemoryView<DataT, RAM>& in,
+    PredT pred)
+{
+    Memory<DataT, RAM> out(in.size());
+    const size_t N = compact_if(in, out, pred);
+    out.resize(N);
+    return out;
+}
+
+template<typename DataT, typename MaskT>
+size_t compact(
+    const MemoryView<DataT, RAM>& in,
+    const MemoryView<MaskT, RAM>& mask,
+    MemoryView<DataT, RAM>& out)
+{
+    if(mask.size() != in.size())
+    {
+        RM_THROW(Exception, "compact: mask differs in size.");
+    }
+
+    const MaskT* m = mask.raw();
+    return primitives::compact_ids(in, out, [m](size_t i) {
+        return m[i] != 0;
+    });
+}
+
+template<typename DataT, typename MaskT>
+Memory<DataT, RAM> compact(
+    const MemoryView<DataT, RAM>& in,
+    const MemoryView<MaskT, RAM>& mask)
+{
+    Memory<DataT, RAM> out(in.size());
+    const size_t N = compact(in, mask, out);
+    out.resize(N);
+    return out;
+}
+
+template<typename DataT, typename PredT>
+size_t partition(
+    const MemoryView<DataT, RAM>& in,
+    MemoryView<DataT, RAM>& out,
+    PredT pred)
+{
+    if(out.size() < in.size())
+    {
+        RM_THROW(Exception, "partition: output is too small.");
+    }
+
+    const DataT* src = in.raw();
+    DataT* dst = out.raw();
+
+    // first pass: number of trues per block
+    const size_t N = in.size();
+    const size_t Nblocks = primitives::num_blocks(N);
+    std::vector<size_t> ntrue(Nblocks + 1, 0);
+
+    #pragma omp parallel for schedule(static) if(Nblocks > 1)
+    for(size_t b=0; b<Nblocks; b++)
+    {
+        const size_t id_b = b * primitives::BLOCK_SIZE;
+        const size_t id_e = std::min(N, id_b + primitives::BLOCK_SIZE);
+        size_t n = 0;
+        for(size_t i=id_b; i<id_e; i++)
+        {
+            n += static_cast<bool>(pred(src[i]));
+        }
+        ntrue[b + 1] = n;
+    }
+
+    // trues before block b, falses before block b = id_b - trues before b
+    for(size_t b=0; b<Nblocks; b++)
+    {
+        ntrue[b + 1] += ntrue[b];
+    }
+    const size_t Ntrue = ntrue[Nblocks];
+
+    #pragma omp parallel for schedule(static) if(Nblocks > 1)
+    for(size_t b=0; b<Nblocks; b++)
+    {
+        const size_t id_b = b * primitives::BLOCK_SIZE;
+        const size_t id_e = std::min(N, id_b + primitives::BLOCK_SIZE);
+        size_t it = ntrue[b];
+        size_t jf = Ntrue + (id_b - ntrue[b]);
+        for(size_t i=id_b; i<id_e; i++)
+        {
+            if(pred(src[i]))
+            {
+                dst[it++] = src[i];
+            } else {
+                dst[jf++] = src[i];
+            }
+        }
+    }
+
+    return Ntrue;
+}
+
+template<typename DataT, typename KeyT>
+void partition(
+    const MemoryView<DataT, RAM>& in,
+    const MemoryView<KeyT, RAM>& keys,
+    size_t Nbuckets,
+    MemoryView<DataT, RAM>& out,
+    MemoryView<unsigned int, RAM>& offsets)
+{
+    if(keys.size() != in.size() || out.size() < in.size() || offsets.size() != Nbuckets + 1)
+    {
+        RM_THROW(Exception, "partition: wrong buffer sizes.");
+    }
+
+    const DataT* src = in.raw();
+    const KeyT* k = keys.raw();
+    DataT* dst = out.raw();
+
+    const size_t N = in.size();
+    const size_t Nblocks = std::max(primitives::num_blocks(N), size_t(1));
+
+    // first pass: histogram per block. hist[bucket * Nblocks + block]
+    std::vector<unsigned int> hist(Nbuckets * Nblocks, 0);
+
+    #pragma omp parallel for schedule(static) if(Nblocks > 1)
+    for(size_t b=0; b<Nblocks; b++)
+    {
+        const size_t id_b = b * primitives::BLOCK_SIZE;
+        const size_t id_e = std::min(N, id_b + primitives::BLOCK_SIZE);
+        for(size_t i=id_b; i<id_e; i++)
+        {
+            const size_t key = static_cast<size_t>(k[i]);
+            if(key < Nbuckets)
+            {
+                hist[key * Nblocks + b]++;
+            }
+        }
+    }
+
+    // bucket major scan -> write offset of every (bucket, block)
+    unsigned int total = 0;
+    for(size_t bucket=0; bucket<Nbuckets; bucket++)
+    {
+        offsets[bucket] = total;
+        for(size_t b=0; b<Nblocks; b++)
+        {
+            const unsigned int c = hist[bucket * Nblocks + b];
+            hist[bucket * Nblocks + b] = total;
+            total += c;
+        }
+    }
+    offsets[Nbuckets] = total;
+
+    #pragma omp parallel for schedule(static) if(Nblocks > 1)
+    for(size_t b=0; b<Nblocks; b++)
+    {
+        const size_t id_b = b * primitives::BLOCK_SIZE;
+        const size_t id_e = std::min(N, id_b + primitives::BLOCK_SIZE);
+        for(size_t i=id_b; i<id_e; i++)
+        {
+            const size_t key = static_cast<size_t>(k[i]);
+            if(key < Nbuckets)
+            {
+                dst[hist[key * Nblocks + b]++] = src[i];
+            }
+        }
+    }
+}
+
+template<typename DataT, typename IndexT>
+void gather(
+    const MemoryView<DataT, RAM>& in,
+    const MemoryView<IndexT, RAM>& ids,
+    MemoryView<DataT, RAM>& out)
+{
+    if(out.size() != ids.size())
+    {
+        RM_THROW(Exception, "gather: output size differs from number of indices.");
+    }
+
+    #pragma omp parallel for schedule(static) if(ids.size() > primitives::BLOCK_SIZE)
+    for(size_t i=0; i<ids.size(); i++)
+    {
+        out[i] = in[ids[i]];
+    }
+}
+
+template<typename DataT, typename IndexT>
+Memory<DataT, RAM> gather(
+    const MemoryView<DataT, RAM>& in,
+    const MemoryView<IndexT, RAM>& ids)
+{
+    Memory<DataT, RAM> out(ids.size());
+    gather(in, ids, out);
+    return out;
+}
+
+template<typename DataT, typename IndexT>
+void scatter(
+    const MemoryView<DataT, RAM>& in,
+    const MemoryView<IndexT, RAM>& ids,
+    MemoryView<DataT, RAM>& out)
+{
+    if(in.size() != ids.size())
+    {
+        RM_THROW(Exception, "scatter: input size differs from number of indices.");
+    }
+
+    #pragma omp parallel for schedule(static) if(ids.size() > primitives::BLOCK_SIZE)
+    for(size_t i=0; i<ids.size(); i++)
+    {
+        out[ids[i]] = in[i];
+    }
+}
+
+} // namespace rmagine
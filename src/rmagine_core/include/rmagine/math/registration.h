@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief Batched registration solvers for CPU Memory
+ * 
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_MATH_REGISTRATION_H
+#define RMAGINE_MATH_REGISTRATION_H
+
+#include <rmagine/math/types.h>
+#include <rmagine/types/Memory.hpp>
+#include <cstdint>
+
+/**
+ * One registration update per pose. The correspondences are given as flat 
+ * buffers in the layout of the simulators: the elements 
+ * [b * batchSize, (b + 1) * batchSize) belong to pose b.
+ * 
+ * - dataset: points to be aligned, e.g. a scan transformed by the current pose estimate
+ * - model: corresponding points, e.g. simulated Points
+ * - model_normals: normals at the model points, e.g. simulated Normals
+ * - mask: valid correspondences (!= 0), e.g. simulated Hits
+ * 
+ * The result Tcorr per pose minimizes the error of Tcorr * dataset 
+ * to the model. Poses with too few correspondences result in identity.
+ * All poses are solved in parallel using segmented reductions.
+ */
+
+namespace rmagine
+{
+
+//////////
+// #umeyamaBatched: point to point
+/**
+ * @brief Closed form point to point alignment (Umeyama, without scale).
+ * Requires at least 3 correspondences per pose
+ */
+void umeyamaBatched(
+    const MemoryView<Vector, RAM>& dataset,
+    const MemoryView<Vector, RAM>& model,
+    const MemoryView<uint8_t, RAM>& mask,
+    MemoryView<Transform, RAM>& Tcorr);
+
+Memory<Transform, RAM> umeyamaBatched(
+    const MemoryView<Vector, RAM>& dataset,
+    const MemoryView<Vector, RAM>& model,
+    const MemoryView<uint8_t, RAM>& mask,
+    unsigned int batchSize);
+
+//////////
+// #pointToPlaneBatched
+/**
+ * @brief One Gauss-Newton step minimizing sum (n_i * (Tcorr * d_i - m_i))^2.
+ * The 6x6 normal equations are accumulated in double precision per pose 
+ * and solved with LDLT. Requires at least 6 correspondences per pose
+ */
+void pointToPlaneBatched(
+    const MemoryView<Vector, RAM>& dataset,
+    const MemoryView<Vector, RAM>& model,
+    const MemoryView<Vector, RAM>& model_normals,
+    const MemoryView<uint8_t, RAM>& mask,
+    MemoryView<Transform, RAM>& Tcorr);
+
+Memory<Transform, RAM> pointToPlaneBatched(
+    const MemoryView<Vector, RAM>& dataset,
+    const MemoryView<Vector, RAM>& model,
+    const MemoryView<Vector, RAM>& model_normals,
+    const MemoryView<uint8_t, RAM>& mask,
+    unsigned int batchSize);
+
+} // namespace rmagine
+
+#endif // RMAGINE_MATH_REGISTRATION_H
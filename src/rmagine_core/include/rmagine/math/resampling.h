@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief Particle weighting and resampling for CPU Memory
+ * 
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_MATH_RESAMPLING_H
+#define RMAGINE_MATH_RESAMPLING_H
+
+#include <rmagine/math/types.h>
+#include <rmagine/types/Memory.hpp>
+#include <cstdint>
+
+/**
+ * Building blocks of particle filters. All functions are parallelized. 
+ * Reductions are computed in double over fixed blocks and random numbers 
+ * are derived from (seed, output index): results only depend on the inputs 
+ * and the seed, not on the number of threads.
+ * 
+ * Weights do not need to be normalized for resampling.
+ */
+
+namespace rmagine
+{
+
+//////////
+// #weights
+
+/**
+ * @brief log(sum_i exp(log_weights[i])), numerically stable
+ */
+double logSumExp(
+    const MemoryView<float, RAM>& log_weights);
+
+/**
+ * @brief weights[i] = exp(log_weights[i] - logSumExp(log_weights)).
+ * weights may be log_weights. If every log weight is -inf, the weights 
+ * are uniform
+ * 
+ * @return logSumExp(log_weights)
+ * @throws Exception if a log weight is +inf or NaN
+ */
+double normalizeLogWeights(
+    const MemoryView<float, RAM>& log_weights,
+    MemoryView<float, RAM>& weights);
+
+/**
+ * @brief weights[i] /= sum(weights)
+ * 
+ * @return the sum before normalization
+ */
+double normalizeWeights(
+    MemoryView<float, RAM>& weights);
+
+/**
+ * @brief (sum w)^2 / sum w^2. In [1, N]
+ */
+double effectiveSampleSize(
+    const MemoryView<float, RAM>& weights);
+
+//////////
+// #resampling
+/**
+ * @brief Systematic resampling: one random offset for all outputs.
+ * 
+ * @param weights    one weight per input particle
+ * @param ancestors  input index of every output particle. The number of 
+ *                   outputs may differ from the number of inputs
+ */
+void resampleSystematic(
+    const MemoryView<float, RAM>& weights,
+    MemoryView<unsigned int, RAM>& ancestors,
+    uint64_t seed);
+
+/**
+ * @brief Stratified resampling: one random offset per output.
+ */
+void resampleStratified(
+    const MemoryView<float, RAM>& weights,
+    MemoryView<unsigned int, RAM>& ancestors,
+    uint64_t seed);
+
+void resampleSystematic(
+    const MemoryView<Transform, RAM>& particles,
+    const MemoryView<float, RAM>& weights,
+    MemoryView<Transform, RAM>& particles_out,
+    uint64_t seed);
+
+Memory<Transform, RAM> resampleSystematic(
+    const MemoryView<Transform, RAM>& particles,
+    const MemoryView<float, RAM>& weights,
+    uint64_t seed);
+
+void resampleStratified(
+    const MemoryView<Transform, RAM>& particles,
+    const MemoryView<float, RAM>& weights,
+    MemoryView<Transform, RAM>& particles_out,
+    uint64_t seed);
+
+Memory<Transform, RAM> resampleStratified(
+    const MemoryView<Transform, RAM>& particles,
+    const MemoryView<float, RAM>& weights,
+    uint64_t seed);
+
+} // namespace rmagine
+
+#endif // RMAGINE_MATH_RESAMPLING_H
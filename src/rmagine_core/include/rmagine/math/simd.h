@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief Vectorized batched transformations of vectors and transforms
+ * 
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_MATH_SIMD_H
+#define RMAGINE_MATH_SIMD_H
+
+#include <rmagine/math/types.h>
+#include <rmagine/types/Memory.hpp>
+
+/**
+ * Explicitly vectorized kernels for the hot combinations of mult:
+ * - Quaternion * Vector
+ * - Matrix3x3 * Vector
+ * - Transform * Vector
+ * - Transform * Transform
+ * 
+ * Every kernel exists as AVX-512, AVX2 and scalar version. The best one 
+ * supported by the CPU is selected at runtime. It can be lowered via 
+ * simd::setLevel or the environment variable RMAGINE_SIMD=scalar|avx2|avx512.
+ * 
+ * Broadcasting follows the sizes of the inputs: an input of size 1 is 
+ * applied to every element of the other input (the Nx1 and 1xN variants 
+ * of math.h). Otherwise both inputs and the output need the same size.
+ * 
+ * The multNxN, multNx1 and mult1xN functions of math.h use these kernels 
+ * for the types above.
+ */
+
+namespace rmagine
+{
+
+/**
+ * @brief Non-owning structure of arrays view on vectors.
+ * Component i of vector j is located at x[j], y[j], z[j]
+ */
+struct VectorSoAView
+{
+    float* x;
+    float* y;
+    float* z;
+    size_t size;
+};
+
+namespace simd
+{
+
+enum class Level
+{
+    SCALAR = 0,
+    AVX2 = 1,
+    AVX512 = 2
+};
+
+/**
+ * @brief best level supported by the CPU and the build
+ */
+Level detect();
+
+/**
+ * @brief level currently used for dispatching
+ */
+Level level();
+
+/**
+ * @brief Set the level used for dispatching. 
+ * Levels not supported by the CPU are lowered to detect()
+ */
+void setLevel(Level l);
+
+const char* name(Level l);
+
+/////////
+// AoS
+
+void mult(
+    const MemoryView<Quaternion, RAM>& Q,
+    const MemoryView<Vector, RAM>& X,
+    MemoryView<Vector, RAM>& Y);
+
+void mult(
+    const MemoryView<Matrix3x3, RAM>& M,
+    const MemoryView<Vector, RAM>& X,
+    MemoryView<Vector, RAM>& Y);
+
+void mult(
+    const MemoryView<Transform, RAM>& T,
+    const MemoryView<Vector, RAM>& X,
+    MemoryView<Vector, RAM>& Y);
+
+/**
+ * @brief Tr = T1 * T2. Like Transform::mult, Tr takes the stamp of T1
+ */
+void mult(
+    const MemoryView<Transform, RAM>& T1,
+    const MemoryView<Transform, RAM>& T2,
+    MemoryView<Transform, RAM>& Tr);
+
+/////////
+// SoA. X and Y may be the same view for in-place transformation
+
+void mult(
+    const MemoryView<Quaternion, RAM>& Q,
+    const VectorSoAView& X,
+    const VectorSoAView& Y);
+
+void mult(
+    const MemoryView<Matrix3x3, RAM>& M,
+    const VectorSoAView& X,
+    const VectorSoAView& Y);
+
+void mult(
+    const MemoryView<Transform, RAM>& T,
+    const VectorSoAView& X,
+    const VectorSoAView& Y);
+
+} // namespace simd
+
+} // namespace rmagine
+
+#endif // RMAGINE_MATH_SIMD_H
@@ -51,5 +51,6 @@
 #include "types/Transform.hpp"
 #include "types/Vector2.hpp"
 #include "types/Vector3.hpp"
+#include "types/Vector6.hpp"
 
 #endif // RMAGINE_MATH_TYPES_H
\ No newline at end of file
@@ -24,35 +24,35 @@ struct Matrix_ {
     //////////////////////////
     // initializer functions
 
-    RMAGINE_INLINE_FUNCTION 
+    RMAGINE_CONSTEXPR_FUNCTION 
     void setZeros();
 
-    RMAGINE_INLINE_FUNCTION 
+    RMAGINE_CONSTEXPR_FUNCTION 
     void setOnes();
 
-    RMAGINE_INLINE_FUNCTION 
+    RMAGINE_CONSTEXPR_FUNCTION 
     void setIdentity();
 
-    RMAGINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     static Matrix_<DataT, Rows, Cols> Zeros()
     {
-        Matrix_<DataT, Rows, Cols> ret;
+        Matrix_<DataT, Rows, Cols> ret{};
         ret.setZeros();
         return ret;
     }
 
-    RMAGINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     static Matrix_<DataT, Rows, Cols> Ones()
     {
-        Matrix_<DataT, Rows, Cols> ret;
+        Matrix_<DataT, Rows, Cols> ret{};
         ret.setOnes();
         return ret;
     }
 
-    RMAGINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     static Matrix_<DataT, Rows, Cols> Identity()
     {
-        Matrix_<DataT, Rows, Cols> ret;
+        Matrix_<DataT, Rows, Cols> ret{};
         ret.setIdentity();
         return ret;
     }
@@ -60,106 +60,106 @@ struct Matrix_ {
     ////////////////////
     // access functions
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     DataT& at(unsigned int row, unsigned int col);
 
     RMAGINE_INLINE_FUNCTION
     volatile DataT& at(unsigned int row, unsigned int col) volatile;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     DataT at(unsigned int row, unsigned int col) const;
 
     RMAGINE_INLINE_FUNCTION
     DataT at(unsigned int i, unsigned int j) volatile const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     DataT& operator()(unsigned int row, unsigned int col);
 
     RMAGINE_INLINE_FUNCTION
     volatile DataT& operator()(unsigned int row, unsigned int col) volatile;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     DataT operator()(unsigned int row, unsigned int col) const;
 
     RMAGINE_INLINE_FUNCTION
     DataT operator()(unsigned int row, unsigned int col) volatile const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     DataT* operator[](const unsigned int col);
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     const DataT* operator[](const unsigned int col) const;
 
     /////////////////////
     // math functions
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols> negate() const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void negateInplace();
 
     template<unsigned int Cols2>
-    RMAGINE_INLINE_FUNCTION 
+    RMAGINE_CONSTEXPR_FUNCTION 
     Matrix_<DataT, Rows, Cols2> mult(const Matrix_<DataT, Cols, Cols2>& M) const;
 
-    RMAGINE_INLINE_FUNCTION 
+    RMAGINE_CONSTEXPR_FUNCTION 
     void multInplace(const Matrix_<DataT, Rows, Cols>& M);
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols> mult(const DataT& scalar) const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void multInplace(const DataT& scalar);
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols> multEwise(const Matrix_<DataT, Rows, Cols>& M) const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols> div(const DataT& scalar) const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void divInplace(const DataT& scalar);
 
-    RMAGINE_INLINE_FUNCTION 
+    RMAGINE_CONSTEXPR_FUNCTION 
     Vector3_<DataT> mult(const Vector3_<DataT>& v) const;
 
-    RMAGINE_INLINE_FUNCTION 
+    RMAGINE_CONSTEXPR_FUNCTION 
     Vector2_<DataT> mult(const Vector2_<DataT>& v) const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols> add(const Matrix_<DataT, Rows, Cols>& M) const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void addInplace(const Matrix_<DataT, Rows, Cols>& M);
 
     RMAGINE_INLINE_FUNCTION
     void addInplace(volatile Matrix_<DataT, Rows, Cols>& M) volatile;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols> sub(const Matrix_<DataT, Rows, Cols>& M) const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void subInplace(const Matrix_<DataT, Rows, Cols>& M);
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Cols, Rows> transpose() const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void transposeInplace();
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     DataT trace() const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     DataT det() const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Cols, Rows> inv() const;
 
     /////////////////////
     // math function aliases
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Cols, Rows> T() const 
     {
         return transpose();
@@ -169,13 +169,13 @@ struct Matrix_ {
     // math function operators
 
     template<unsigned int Cols2>
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols2> operator*(const Matrix_<DataT, Cols, Cols2>& M) const
     {
         return mult(M);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols>& operator*=(const Matrix_<DataT, Rows, Cols>& M)
     {
         static_assert(Rows == Cols);
@@ -183,51 +183,51 @@ struct Matrix_ {
         return *this;
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols> operator*(const DataT& s) const
     {
         return mult(s);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols>& operator*=(const DataT& s)
     {
         multInplace(s);
         return *this;
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> operator*(const Vector3_<DataT>& p) const
     {
         return mult(p);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector2_<DataT> operator*(const Vector2_<DataT>& p) const
     {
         return mult(p);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols> operator/(const DataT& s) const
     {
         return div(s);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols>& operator/=(const DataT& s)
     {
         divInplace(s);
         return *this;
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols> operator+(const Matrix_<DataT, Rows, Cols>& M) const
     {
         return add(M);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols>& operator+=(const Matrix_<DataT, Rows, Cols>& M)
     {
         addInplace(M);
@@ -241,19 +241,19 @@ struct Matrix_ {
         return *this;
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols> operator-(const Matrix_<DataT, Rows, Cols>& M) const
     {
         return sub(M);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols> operator-() const
     {
         return negate();
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols> operator~() const
     {
         return inv();
@@ -262,40 +262,40 @@ struct Matrix_ {
     /////////////////////
     // Transformation Helpers. Matrix Form: Square, Homogenous
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows-1, Cols-1> rotation() const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void setRotation(const Matrix_<DataT, Rows-1, Cols-1>& R);
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void setRotation(const Quaternion_<DataT>& q);
 
     RMAGINE_INLINE_FUNCTION
     void setRotation(const EulerAngles_<DataT>& e);
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows-1, 1> translation() const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void setTranslation(const Matrix_<DataT, Rows-1, 1>& t);
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void setTranslation(const Vector2_<DataT>& t);
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void setTranslation(const Vector3_<DataT>& t);
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, Rows, Cols> invRigid() const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void set(const Quaternion_<DataT>& q);
 
     RMAGINE_INLINE_FUNCTION
     void set(const EulerAngles_<DataT>& e);
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void set(const Transform_<DataT>& T);
 
     ////////////////
@@ -306,7 +306,7 @@ struct Matrix_ {
      * 
      * @return Vector2_<DataT> 
      */
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     operator Vector2_<DataT>() const;
 
     /**
@@ -314,7 +314,7 @@ struct Matrix_ {
      * 
      * @return Vector3_<DataT> 
      */
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     operator Vector3_<DataT>() const;
 
     /**
@@ -337,10 +337,10 @@ struct Matrix_ {
      * @brief Data Type Cast to ConvT
      * 
      * @tparam ConvT 
-     * @return RMAGINE_INLINE_FUNCTION 
+     * @return RMAGINE_CONSTEXPR_FUNCTION 
      */
     template<typename ConvT>
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<ConvT, Rows, Cols> cast() const;
 
     /////////////////////
@@ -4,7 +4,7 @@ namespace rmagine {
 
 
 template<typename DataT, unsigned int Rows, unsigned int Cols>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT& Matrix_<DataT, Rows, Cols>::at(unsigned int row, unsigned int col)
 {
     return data[col][row];
@@ -18,7 +18,7 @@ volatile DataT& Matrix_<DataT, Rows, Cols>::at(unsigned int row, unsigned int co
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT Matrix_<DataT, Rows, Cols>::at(unsigned int row, unsigned int col) const
 {
     return data[col][row];
@@ -32,7 +32,7 @@ DataT Matrix_<DataT, Rows, Cols>::at(unsigned int row, unsigned int col) volatil
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT& Matrix_<DataT, Rows, Cols>::operator()(unsigned int row, unsigned int col)
 {
     return at(row, col);
@@ -46,7 +46,7 @@ volatile DataT& Matrix_<DataT, Rows, Cols>::operator()(unsigned int row, unsigne
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT Matrix_<DataT, Rows, Cols>::operator()(unsigned int row, unsigned int col) const
 {
     return at(row, col);
@@ -60,14 +60,14 @@ DataT Matrix_<DataT, Rows, Cols>::operator()(unsigned int row, unsigned int col)
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT* Matrix_<DataT, Rows, Cols>::operator[](const unsigned int col) 
 {
     return data[col];
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 const DataT* Matrix_<DataT, Rows, Cols>::operator[](const unsigned int col) const 
 {
     return data[col];
@@ -77,7 +77,7 @@ const DataT* Matrix_<DataT, Rows, Cols>::operator[](const unsigned int col) cons
 // setZeros
 ////////////////
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION 
+RMAGINE_CONSTEXPR_FUNCTION 
 void Matrix_<DataT, Rows, Cols>::setZeros()
 {
     for(unsigned int i=0; i<Rows; i++)
@@ -91,7 +91,7 @@ void Matrix_<DataT, Rows, Cols>::setZeros()
 
 // specializations
 template<> 
-RMAGINE_INLINE_FUNCTION 
+RMAGINE_CONSTEXPR_FUNCTION 
 void Matrix_<float, 3, 3>::setZeros()
 {
     at(0,0) = 0.0f;
@@ -106,7 +106,7 @@ void Matrix_<float, 3, 3>::setZeros()
 }
 
 template<> 
-RMAGINE_INLINE_FUNCTION 
+RMAGINE_CONSTEXPR_FUNCTION 
 void Matrix_<double, 3, 3>::setZeros()
 {
     at(0,0) = 0.0;
@@ -121,7 +121,7 @@ void Matrix_<double, 3, 3>::setZeros()
 }
 
 template<> 
-RMAGINE_INLINE_FUNCTION 
+RMAGINE_CONSTEXPR_FUNCTION 
 void Matrix_<float, 4, 4>::setZeros()
 {
     at(0,0) = 0.0f;
@@ -143,7 +143,7 @@ void Matrix_<float, 4, 4>::setZeros()
 }
 
 template<> 
-RMAGINE_INLINE_FUNCTION 
+RMAGINE_CONSTEXPR_FUNCTION 
 void Matrix_<double, 4, 4>::setZeros()
 {
     at(0,0) = 0.0;
@@ -169,7 +169,7 @@ void Matrix_<double, 4, 4>::setZeros()
 // setOnes
 ////////////////
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION 
+RMAGINE_CONSTEXPR_FUNCTION 
 void Matrix_<DataT, Rows, Cols>::setOnes()
 {
     for(unsigned int i=0; i<Rows; i++)
@@ -183,7 +183,7 @@ void Matrix_<DataT, Rows, Cols>::setOnes()
 
 // specializations
 template<> 
-RMAGINE_INLINE_FUNCTION 
+RMAGINE_CONSTEXPR_FUNCTION 
 void Matrix_<float, 3, 3>::setOnes()
 {
     at(0,0) = 1.0f;
@@ -198,7 +198,7 @@ void Matrix_<float, 3, 3>::setOnes()
 }
 
 template<> 
-RMAGINE_INLINE_FUNCTION 
+RMAGINE_CONSTEXPR_FUNCTION 
 void Matrix_<double, 3, 3>::setOnes()
 {
     at(0,0) = 1.0;
@@ -213,7 +213,7 @@ void Matrix_<double, 3, 3>::setOnes()
 }
 
 template<> 
-RMAGINE_INLINE_FUNCTION 
+RMAGINE_CONSTEXPR_FUNCTION 
 void Matrix_<float, 4, 4>::setOnes()
 {
     at(0,0) = 1.0f;
@@ -235,7 +235,7 @@ void Matrix_<float, 4, 4>::setOnes()
 }
 
 template<> 
-RMAGINE_INLINE_FUNCTION 
+RMAGINE_CONSTEXPR_FUNCTION 
 void Matrix_<double, 4, 4>::setOnes()
 {
     at(0,0) = 1.0;
@@ -260,7 +260,7 @@ void Matrix_<double, 4, 4>::setOnes()
 // setIdentity
 ////////////////
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<DataT, Rows, Cols>::setIdentity()
 {
     for(unsigned int i=0; i<Rows; i++)
@@ -279,7 +279,7 @@ void Matrix_<DataT, Rows, Cols>::setIdentity()
 
 // specializatons
 template<> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<float, 3, 3>::setIdentity()
 {
     at(0,0) = 1.0f;
@@ -294,7 +294,7 @@ void Matrix_<float, 3, 3>::setIdentity()
 }
 
 template<> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<double, 3, 3>::setIdentity()
 {
     at(0,0) = 1.0;
@@ -309,7 +309,7 @@ void Matrix_<double, 3, 3>::setIdentity()
 }
 
 template<> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<float, 4, 4>::setIdentity()
 {
     at(0,0) = 1.0f;
@@ -331,7 +331,7 @@ void Matrix_<float, 4, 4>::setIdentity()
 }
 
 template<> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<double, 4, 4>::setIdentity()
 {
     at(0,0) = 1.0;
@@ -353,11 +353,11 @@ void Matrix_<double, 4, 4>::setIdentity()
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<DataT, Rows, Cols> 
     Matrix_<DataT, Rows, Cols>::negate() const
 {
-    Matrix_<DataT, Rows, Cols> res;
+    Matrix_<DataT, Rows, Cols> res{};
 
     for(unsigned int i=0; i<Rows; i++)
     {
@@ -371,7 +371,7 @@ Matrix_<DataT, Rows, Cols>
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<DataT, Rows, Cols>::negateInplace()
 {
     for(unsigned int i=0; i<Rows; i++)
@@ -386,7 +386,7 @@ void Matrix_<DataT, Rows, Cols>::negateInplace()
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
 template<unsigned int Cols2>
-RMAGINE_INLINE_FUNCTION 
+RMAGINE_CONSTEXPR_FUNCTION 
 Matrix_<DataT, Rows, Cols2> 
     Matrix_<DataT, Rows, Cols>::mult(const Matrix_<DataT, Cols, Cols2>& M) const
 {
@@ -394,7 +394,7 @@ Matrix_<DataT, Rows, Cols2>
     constexpr unsigned int Rows3 = Rows;
     constexpr unsigned int Cols3 = Cols2;
 
-    Matrix_<DataT, Rows3, Cols3> res;
+    Matrix_<DataT, Rows3, Cols3> res{};
     
     // before
     res.setZeros();
@@ -431,7 +431,7 @@ Matrix_<DataT, Rows, Cols2>
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION 
+RMAGINE_CONSTEXPR_FUNCTION 
 void Matrix_<DataT, Rows, Cols>::multInplace(const Matrix_<DataT, Rows, Cols>& M)
 {
     static_assert(Rows == Cols);
@@ -464,11 +464,11 @@ void Matrix_<DataT, Rows, Cols>::multInplace(const Matrix_<DataT, Rows, Cols>& M
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<DataT, Rows, Cols> 
     Matrix_<DataT, Rows, Cols>::mult(const DataT& scalar) const
 {
-    Matrix_<DataT, Rows, Cols> res;
+    Matrix_<DataT, Rows, Cols> res{};
 
     for(unsigned int i = 0; i < Rows; i++)
     {
@@ -482,7 +482,7 @@ Matrix_<DataT, Rows, Cols>
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<DataT, Rows, Cols>::multInplace(const DataT& scalar)
 {
     for(unsigned int i = 0; i < Rows; i++)
@@ -495,10 +495,10 @@ void Matrix_<DataT, Rows, Cols>::multInplace(const DataT& scalar)
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<DataT, Rows, Cols> Matrix_<DataT, Rows, Cols>::multEwise(const Matrix_<DataT, Rows, Cols>& M) const
 {
-    Matrix_<DataT, Rows, Cols> res;
+    Matrix_<DataT, Rows, Cols> res{};
 
     for(unsigned int i = 0; i < Rows; i++)
     {
@@ -513,11 +513,11 @@ Matrix_<DataT, Rows, Cols> Matrix_<DataT, Rows, Cols>::multEwise(const Matrix_<D
 
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<DataT, Rows, Cols> 
     Matrix_<DataT, Rows, Cols>::div(const DataT& scalar) const
 {
-    Matrix_<DataT, Rows, Cols> res;
+    Matrix_<DataT, Rows, Cols> res{};
 
     for(unsigned int i = 0; i < Rows; i++)
     {
@@ -531,7 +531,7 @@ Matrix_<DataT, Rows, Cols>
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<DataT, Rows, Cols>::divInplace(const DataT& scalar)
 {
     for(unsigned int i = 0; i < Rows; i++)
@@ -544,7 +544,7 @@ void Matrix_<DataT, Rows, Cols>::divInplace(const DataT& scalar)
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION 
+RMAGINE_CONSTEXPR_FUNCTION 
 Vector3_<DataT> 
     Matrix_<DataT, Rows, Cols>::mult(const Vector3_<DataT>& v) const
 {
@@ -570,7 +570,7 @@ Vector3_<DataT>
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION 
+RMAGINE_CONSTEXPR_FUNCTION 
 Vector2_<DataT> 
     Matrix_<DataT, Rows, Cols>::mult(const Vector2_<DataT>& v) const
 {
@@ -595,11 +595,11 @@ Vector2_<DataT>
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<DataT, Rows, Cols> 
     Matrix_<DataT, Rows, Cols>::add(const Matrix_<DataT, Rows, Cols>& M) const
 {
-    Matrix_<DataT, Rows, Cols> res;
+    Matrix_<DataT, Rows, Cols> res{};
 
     for(unsigned int i = 0; i < Rows; i++)
     {
@@ -613,7 +613,7 @@ Matrix_<DataT, Rows, Cols>
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<DataT, Rows, Cols>::addInplace(const Matrix_<DataT, Rows, Cols>& M)
 {
     for(unsigned int i = 0; i < Rows; i++)
@@ -639,11 +639,11 @@ void Matrix_<DataT, Rows, Cols>::addInplace(volatile Matrix_<DataT, Rows, Cols>&
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<DataT, Rows, Cols> 
     Matrix_<DataT, Rows, Cols>::sub(const Matrix_<DataT, Rows, Cols>& M) const
 {
-    Matrix_<DataT, Rows, Cols> res;
+    Matrix_<DataT, Rows, Cols> res{};
 
     for(unsigned int i = 0; i < Rows; i++)
     {
@@ -657,7 +657,7 @@ Matrix_<DataT, Rows, Cols>
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<DataT, Rows, Cols>::subInplace(const Matrix_<DataT, Rows, Cols>& M)
 {
     for(unsigned int i = 0; i < Rows; i++)
@@ -670,11 +670,11 @@ void Matrix_<DataT, Rows, Cols>::subInplace(const Matrix_<DataT, Rows, Cols>& M)
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<DataT, Cols, Rows> 
     Matrix_<DataT, Rows, Cols>::transpose() const
 {
-    Matrix_<DataT, Cols, Rows> res;
+    Matrix_<DataT, Cols, Rows> res{};
 
     for(unsigned int i = 0; i < Rows; i++)
     {
@@ -688,11 +688,11 @@ Matrix_<DataT, Cols, Rows>
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<DataT, Rows, Cols>::transposeInplace()
 {
     static_assert(Rows == Cols);
-    float swap_mem;
+    DataT swap_mem{};
 
     for(unsigned int i = 0; i < Rows - 1; i++)
     {
@@ -707,11 +707,11 @@ void Matrix_<DataT, Rows, Cols>::transposeInplace()
 
 // specializations
 template<> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<float, 3, 3>::transposeInplace()
 {
     // use only one float as additional memory
-    float swap_mem;
+    float swap_mem = 0.0f;
     // can we do this without additional memory?
 
     swap_mem = at(0,1);
@@ -728,7 +728,7 @@ void Matrix_<float, 3, 3>::transposeInplace()
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT Matrix_<DataT, Rows, Cols>::trace() const
 {
     static_assert(Rows == Cols);
@@ -743,21 +743,21 @@ DataT Matrix_<DataT, Rows, Cols>::trace() const
 }
 
 template<>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 float Matrix_<float, 2, 2>::det() const
 {
     return at(0, 0) * at(1, 1) - at(0, 1) * at(1, 0);
 }
 
 template<>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 double Matrix_<double, 2, 2>::det() const
 {
     return at(0, 0) * at(1, 1) - at(0, 1) * at(1, 0);
 }
 
 template<>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 float Matrix_<float, 3, 3>::det() const
 {
     return  at(0, 0) * (at(1, 1) * at(2, 2) - at(2, 1) * at(1, 2)) -
@@ -766,7 +766,7 @@ float Matrix_<float, 3, 3>::det() const
 }
 
 template<>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 double Matrix_<double, 3, 3>::det() const
 {
     return  at(0, 0) * (at(1, 1) * at(2, 2) - at(2, 1) * at(1, 2)) -
@@ -775,7 +775,7 @@ double Matrix_<double, 3, 3>::det() const
 }
 
 template<> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 float Matrix_<float, 4, 4>::det() const
 {
     // TODO: check
@@ -805,7 +805,7 @@ float Matrix_<float, 4, 4>::det() const
 }
 
 template<> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 double Matrix_<double, 4, 4>::det() const
 {
     // TODO: check
@@ -835,10 +835,10 @@ double Matrix_<double, 4, 4>::det() const
 }
 
 template<>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<float, 2, 2> Matrix_<float, 2, 2>::inv() const
 {
-    Matrix_<float, 2, 2> ret;
+    Matrix_<float, 2, 2> ret{};
     
     const float invdet = 1.0f / det();
     ret(0, 0) =  at(1, 1) * invdet;
@@ -850,10 +850,10 @@ Matrix_<float, 2, 2> Matrix_<float, 2, 2>::inv() const
 }
 
 template<>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<double, 2, 2> Matrix_<double, 2, 2>::inv() const
 {
-    Matrix_<double, 2, 2> ret;
+    Matrix_<double, 2, 2> ret{};
     
     const double invdet = 1.0 / det();
     ret(0, 0) =  at(1, 1) * invdet;
@@ -865,10 +865,10 @@ Matrix_<double, 2, 2> Matrix_<double, 2, 2>::inv() const
 }
 
 template<> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<float, 3, 3> Matrix_<float, 3, 3>::inv() const
 {
-    Matrix_<float, 3, 3> ret;
+    Matrix_<float, 3, 3> ret{};
 
     const float invdet = 1.0f / det();
 
@@ -886,10 +886,10 @@ Matrix_<float, 3, 3> Matrix_<float, 3, 3>::inv() const
 }
 
 template<> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<double, 3, 3> Matrix_<double, 3, 3>::inv() const
 {
-    Matrix_<double, 3, 3> ret;
+    Matrix_<double, 3, 3> ret{};
 
     const double invdet = 1.0 / det();
 
@@ -907,7 +907,7 @@ Matrix_<double, 3, 3> Matrix_<double, 3, 3>::inv() const
 }
 
 template<> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<float, 4, 4> Matrix_<float, 4, 4>::inv() const
 {
     // https://stackoverflow.com/questions/1148309/inverting-a-4x4-matrix
@@ -940,7 +940,7 @@ Matrix_<float, 4, 4> Matrix_<float, 4, 4>::inv() const
     // inv det
     det_ = 1.0f / det_;
 
-    Matrix_<float, 4, 4> ret;
+    Matrix_<float, 4, 4> ret{};
     ret(0,0) = det_ *   ( at(1,1) * A2323 - at(1,2) * A1323 + at(1,3) * A1223 );
     ret(0,1) = det_ * - ( at(0,1) * A2323 - at(0,2) * A1323 + at(0,3) * A1223 );
     ret(0,2) = det_ *   ( at(0,1) * A2313 - at(0,2) * A1313 + at(0,3) * A1213 );
@@ -963,7 +963,7 @@ Matrix_<float, 4, 4> Matrix_<float, 4, 4>::inv() const
 
 
 template<> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<double, 4, 4> Matrix_<double, 4, 4>::inv() const
 {
     // https://stackoverflow.com/questions/1148309/inverting-a-4x4-matrix
@@ -996,7 +996,7 @@ Matrix_<double, 4, 4> Matrix_<double, 4, 4>::inv() const
     // inv det
     det_ = 1.0 / det_;
 
-    Matrix_<double, 4, 4> ret;
+    Matrix_<double, 4, 4> ret{};
     ret(0,0) = det_ *   ( at(1,1) * A2323 - at(1,2) * A1323 + at(1,3) * A1223 );
     ret(0,1) = det_ * - ( at(0,1) * A2323 - at(0,2) * A1323 + at(0,3) * A1223 );
     ret(0,2) = det_ *   ( at(0,1) * A2313 - at(0,2) * A1313 + at(0,3) * A1213 );
@@ -1021,11 +1021,11 @@ Matrix_<double, 4, 4> Matrix_<double, 4, 4>::inv() const
 // Transformation Helpers
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<DataT, Rows-1, Cols-1> Matrix_<DataT, Rows, Cols>::rotation() const
 {
     static_assert(Rows == Cols);
-    Matrix_<DataT, Rows-1, Cols-1> res;
+    Matrix_<DataT, Rows-1, Cols-1> res{};
 
     for(unsigned int i=0; i < Rows - 1; i++)
     {
@@ -1039,7 +1039,7 @@ Matrix_<DataT, Rows-1, Cols-1> Matrix_<DataT, Rows, Cols>::rotation() const
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<DataT, Rows, Cols>::setRotation(const Matrix_<DataT, Rows-1, Cols-1>& R)
 {
     for(unsigned int i=0; i < Rows - 1; i++)
@@ -1052,11 +1052,11 @@ void Matrix_<DataT, Rows, Cols>::setRotation(const Matrix_<DataT, Rows-1, Cols-1
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<DataT, Rows, Cols>::setRotation(const Quaternion_<DataT>& q)
 {
     static_assert(Rows >= 3 && Cols >= 3);
-    Matrix_<DataT, 3, 3> R;
+    Matrix_<DataT, 3, 3> R{};
     R = q;
     setRotation(R);
 }
@@ -1072,11 +1072,11 @@ void Matrix_<DataT, Rows, Cols>::setRotation(const EulerAngles_<DataT>& e)
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<DataT, Rows-1, 1> Matrix_<DataT, Rows, Cols>::translation() const
 {
     static_assert(Rows == Cols);
-    Matrix_<DataT, Rows-1, 1> res;
+    Matrix_<DataT, Rows-1, 1> res{};
 
     for(unsigned int i=0; i < Rows - 1; i++)
     {
@@ -1087,7 +1087,7 @@ Matrix_<DataT, Rows-1, 1> Matrix_<DataT, Rows, Cols>::translation() const
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<DataT, Rows, Cols>::setTranslation(const Matrix_<DataT, Rows-1, 1>& t)
 {
     for(unsigned int i=0; i < Rows - 1; i++)
@@ -1097,7 +1097,7 @@ void Matrix_<DataT, Rows, Cols>::setTranslation(const Matrix_<DataT, Rows-1, 1>&
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<DataT, Rows, Cols>::setTranslation(const Vector2_<DataT>& t)
 {
     static_assert(Rows >= 2 && Cols >= 3);
@@ -1106,7 +1106,7 @@ void Matrix_<DataT, Rows, Cols>::setTranslation(const Vector2_<DataT>& t)
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<DataT, Rows, Cols>::setTranslation(const Vector3_<DataT>& t)
 {
     static_assert(Rows >= 3 && Cols >= 4);
@@ -1116,11 +1116,11 @@ void Matrix_<DataT, Rows, Cols>::setTranslation(const Vector3_<DataT>& t)
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<DataT, Rows, Cols> Matrix_<DataT, Rows, Cols>::invRigid() const
 {
     static_assert(Rows == Cols);
-    Matrix_<DataT, Rows, Cols> ret;
+    Matrix_<DataT, Rows, Cols> ret{};
     ret.setIdentity();
 
     // TODO
@@ -1136,7 +1136,7 @@ Matrix_<DataT, Rows, Cols> Matrix_<DataT, Rows, Cols>::invRigid() const
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<DataT, Rows, Cols>::set(const Quaternion_<DataT>& q)
 {
     static_assert(Rows == 3 && Cols == 3);
@@ -1153,7 +1153,7 @@ void Matrix_<DataT, Rows, Cols>::set(const EulerAngles_<DataT>& e)
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Matrix_<DataT, Rows, Cols>::set(const Transform_<DataT>& T)
 {
     static_assert(Rows >= 3);
@@ -1166,7 +1166,7 @@ void Matrix_<DataT, Rows, Cols>::set(const Transform_<DataT>& T)
 /////
 // CASTINGS
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<DataT, Rows, Cols>::operator Vector2_<DataT>() const 
 {
     static_assert(Rows == 2 && Cols == 1);
@@ -1177,7 +1177,7 @@ Matrix_<DataT, Rows, Cols>::operator Vector2_<DataT>() const
 }
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<DataT, Rows, Cols>::operator Vector3_<DataT>() const 
 {
     static_assert(Rows == 3 && Cols == 1);
@@ -1270,10 +1270,10 @@ Matrix_<DataT, Rows, Cols>::operator EulerAngles_<DataT>() const
 
 template<typename DataT, unsigned int Rows, unsigned int Cols> 
 template<typename ConvT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<ConvT, Rows, Cols> Matrix_<DataT, Rows, Cols>::cast() const
 {
-    Matrix_<ConvT, Rows, Cols> res;
+    Matrix_<ConvT, Rows, Cols> res{};
 
     for(unsigned int i=0; i<Rows; i++)
     {
@@ -22,15 +22,15 @@ struct Quaternion_
     DataT z;
     DataT w;
 
-    RMAGINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     static Quaternion_<DataT> Identity()
     {
-        Quaternion_<DataT> ret;
+        Quaternion_<DataT> ret{};
         ret.setIdentity();
         return ret;
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void setIdentity();
 
     /**
@@ -38,10 +38,10 @@ struct Quaternion_
      * 
      * @return Quaternion_<DataT> 
      */
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Quaternion_<DataT> inv() const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void invInplace();
 
     /**
@@ -50,10 +50,10 @@ struct Quaternion_
      * @param q2 
      * @return Quaternion_<DataT> 
      */
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Quaternion_<DataT> mult(const Quaternion_<DataT>& q2) const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void multInplace(const Quaternion_<DataT>& q2);
 
     /**
@@ -62,13 +62,13 @@ struct Quaternion_
      * @param p 
      * @return Vector 
      */
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> mult(const Vector3_<DataT>& p) const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     DataT dot(const Quaternion_<DataT>& q) const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     DataT l2normSquared() const;
 
     RMAGINE_INLINE_FUNCTION
@@ -87,29 +87,29 @@ struct Quaternion_
     void set(const EulerAngles_<DataT>& e);
 
     // TODO: Quatenrion from rotation around an axis v by an angle a
-    // RMAGINE_INLINE_FUNCTION
+    // RMAGINE_CONSTEXPR_FUNCTION
     // void set(const Vector3& v, float a);
 
     // OPERATORS
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Quaternion_<DataT> operator~() const 
     {
         return inv();
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Quaternion_<DataT> operator*(const Quaternion_<DataT>& q2) const 
     {
         return mult(q2);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> operator*(const Vector3_<DataT>& p) const
     {
         return mult(p);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Quaternion_<DataT>& operator*=(const Quaternion_<DataT>& q2)
     {
         multInplace(q2);
@@ -132,17 +132,17 @@ struct Quaternion_
      * 
      * @return Matrix_<DataT, 3, 3> 
      */
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     operator Matrix_<DataT, 3, 3>() const;
 
     /**
      * @brief Data Type cast to ConvT
      * 
      * @tparam ConvT 
-     * @return RMAGINE_INLINE_FUNCTION 
+     * @return RMAGINE_CONSTEXPR_FUNCTION 
      */
     template<typename ConvT>
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Quaternion_<ConvT> cast() const;
 };
 
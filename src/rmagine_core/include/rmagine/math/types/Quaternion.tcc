@@ -5,7 +5,7 @@ namespace rmagine
 {
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Quaternion_<DataT>::setIdentity()
 {
     x = 0.0;
@@ -15,14 +15,14 @@ void Quaternion_<DataT>::setIdentity()
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Quaternion_<DataT> Quaternion_<DataT>::inv() const 
 {
     return {-x, -y, -z, w};
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Quaternion_<DataT>::invInplace()
 {
     x = -x;
@@ -31,7 +31,7 @@ void Quaternion_<DataT>::invInplace()
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Quaternion_<DataT> Quaternion_<DataT>::mult(const Quaternion_<DataT>& q2) const 
 {
     return {w*q2.x + x*q2.w + y*q2.z - z*q2.y,
@@ -41,7 +41,7 @@ Quaternion_<DataT> Quaternion_<DataT>::mult(const Quaternion_<DataT>& q2) const
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Quaternion_<DataT>::multInplace(const Quaternion_<DataT>& q2) 
 {
     const Quaternion_<DataT> tmp = mult(q2);
@@ -52,7 +52,7 @@ void Quaternion_<DataT>::multInplace(const Quaternion_<DataT>& q2)
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Vector3_<DataT> Quaternion_<DataT>::mult(const Vector3_<DataT>& p) const
 {
     const Quaternion_<DataT> P{p.x, p.y, p.z, 0.0};
@@ -61,14 +61,14 @@ Vector3_<DataT> Quaternion_<DataT>::mult(const Vector3_<DataT>& p) const
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT Quaternion_<DataT>::dot(const Quaternion_<DataT>& q) const
 {
     return x * q.x + y * q.y + z * q.z + w * q.w;
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT Quaternion_<DataT>::l2normSquared() const 
 {
     return w * w + x * x + y * y + z * z;
@@ -168,10 +168,10 @@ Quaternion_<DataT>::operator EulerAngles_<DataT>() const
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Quaternion_<DataT>::operator Matrix_<DataT, 3, 3>() const
 {
-    Matrix_<DataT, 3, 3> res;
+    Matrix_<DataT, 3, 3> res{};
     res(0,0) = 2.0 * (w * w + x * x) - 1.0;
     res(0,1) = 2.0 * (x * y - w * z);
     res(0,2) = 2.0 * (x * z + w * y);
@@ -186,7 +186,7 @@ Quaternion_<DataT>::operator Matrix_<DataT, 3, 3>() const
 
 template<typename DataT>
 template<typename ConvT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Quaternion_<ConvT> Quaternion_<DataT>::cast() const
 {
     return {
@@ -27,29 +27,32 @@ struct Transform_
     uint32_t stamp;
 
     // FUNCTIONS
-    RMAGINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     static Transform_<DataT> Identity()
     {
-        Transform_<DataT> ret;
+        Transform_<DataT> ret{};
         ret.setIdentity();
         return ret;
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void setIdentity();
 
     RMAGINE_INLINE_FUNCTION
     void set(const Matrix_<DataT, 4, 4>& M);
 
-    RMAGINE_INLINE_FUNCTION
+    /**
+     * @brief Inverse transform. Keeps the stamp
+     */
+    RMAGINE_CONSTEXPR_FUNCTION
     Transform_<DataT> inv() const;
 
     /**
-     * @brief Transform of type T3 = this*T2
+     * @brief Transform of type T3 = this*T2. T3 takes the stamp of this
      * 
      * @param T2 Other transform
      */
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Transform_<DataT> mult(const Transform_<DataT>& T2) const;
 
     /**
@@ -57,45 +60,46 @@ struct Transform_
      * 
      * @param T2 Other transform
      */
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void multInplace(const Transform_<DataT>& T2);
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> mult(const Vector3_<DataT>& v) const;
 
     // OPERATORS
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void operator=(const Matrix_<DataT, 4, 4>& M)
     {
         set(M);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Transform_<DataT> operator~() const
     {
         return inv();
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Transform_<DataT> operator*(const Transform_<DataT>& T2) const 
     {
         return mult(T2);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Transform_<DataT>& operator*=(const Transform_<DataT>& T2)
     {
         multInplace(T2);
         return *this;
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> operator*(const Vector3_<DataT>& v) const
     {
         return mult(v);
     }
 
     template<typename ConvT>
+    RMAGINE_CONSTEXPR_FUNCTION
     Transform_<ConvT> cast() const
     {
         return {
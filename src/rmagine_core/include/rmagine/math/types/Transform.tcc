@@ -4,7 +4,7 @@ namespace rmagine
 {
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Transform_<DataT>::setIdentity()
 {
     R.setIdentity();
@@ -20,29 +20,31 @@ void Transform_<DataT>::set(const Matrix_<DataT, 4, 4>& M)
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Transform_<DataT> Transform_<DataT>::inv() const
 {
-    Transform Tinv;
+    Transform_<DataT> Tinv{};
     Tinv.R = ~R;
     Tinv.t = -(Tinv.R * t);
+    Tinv.stamp = stamp;
     return Tinv;
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Transform_<DataT> Transform_<DataT>::mult(const Transform_<DataT>& T2) const
 {
     // P_ = R1 * (R2 * P + t2) + t1;
-    Transform T3;
+    Transform_<DataT> T3{};
     T3.t = R * T2.t;
     T3.R = R * T2.R;
     T3.t += t;
+    T3.stamp = stamp;
     return T3;
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Transform_<DataT>::multInplace(const Transform_<DataT>& T2)
 {
     // P_ = R1 * (R2 * P + t2) + t1;
@@ -55,7 +57,7 @@ void Transform_<DataT>::multInplace(const Transform_<DataT>& T2)
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Vector3_<DataT> Transform_<DataT>::mult(const Vector3_<DataT>& v) const
 {
     return R * v + t;
@@ -4,14 +4,14 @@ namespace rmagine
 {
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Vector2_<DataT> Vector2_<DataT>::add(const Vector2_<DataT>& b) const
 {
     return {x + b.x, y + b.y};
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Vector2_<DataT>::addInplace(const Vector2_<DataT>& b)
 {
     x += b.x;
@@ -19,14 +19,14 @@ void Vector2_<DataT>::addInplace(const Vector2_<DataT>& b)
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Vector2_<DataT> Vector2_<DataT>::sub(const Vector2_<DataT>& b) const
 {
     return {x - b.x, y - b.y};
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Vector2_<DataT>::subInplace(const Vector2_<DataT>& b)
 {
     x -= b.x;
@@ -34,14 +34,14 @@ void Vector2_<DataT>::subInplace(const Vector2_<DataT>& b)
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Vector2_<DataT> Vector2_<DataT>::negate() const
 {
     return {-x, -y};
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Vector2_<DataT>::negateInplace()
 {
     x = -x;
@@ -49,28 +49,28 @@ void Vector2_<DataT>::negateInplace()
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT Vector2_<DataT>::dot(const Vector2_<DataT>& b) const 
 {
     return x * b.x + y * b.y; 
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT Vector2_<DataT>::mult(const Vector2_<DataT>& b) const
 {
     return dot(b);
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Vector2_<DataT> Vector2_<DataT>::mult(const DataT& s) const 
 {
     return {x * s, y * s};
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Vector2_<DataT>::multInplace(const DataT& s) 
 {
     x *= s;
@@ -78,14 +78,14 @@ void Vector2_<DataT>::multInplace(const DataT& s)
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Vector2_<DataT> Vector2_<DataT>::div(const DataT& s) const 
 {
     return {x / s, y / s};
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Vector2_<DataT>::divInplace(const DataT& s) 
 {
     x /= s;
@@ -93,7 +93,7 @@ void Vector2_<DataT>::divInplace(const DataT& s)
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT Vector2_<DataT>::l2normSquared() const
 {
     return x*x + y*y;
@@ -107,14 +107,14 @@ DataT Vector2_<DataT>::l2norm() const
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT Vector2_<DataT>::sum() const 
 {
     return x + y;
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT Vector2_<DataT>::prod() const 
 {
     return x * y;
@@ -128,7 +128,7 @@ DataT Vector2_<DataT>::l1norm() const
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Vector2_<DataT>::setZeros()
 {
     x = 0.0;
@@ -137,7 +137,7 @@ void Vector2_<DataT>::setZeros()
 
 template<typename DataT>
 template<typename ConvT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Vector2_<ConvT> Vector2_<DataT>::cast() const
 {
     return {
@@ -16,92 +16,92 @@ struct Vector3_
     DataT y;
     DataT z;
 
-    RMAGINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     static Vector3_<DataT> NaN()
     {
         return {NAN, NAN, NAN};
     }
 
-    RMAGINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     static Vector3_<DataT> Zeros()
     {
         return {static_cast<DataT>(0), static_cast<DataT>(0), static_cast<DataT>(0)};
     }
 
-    RMAGINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     static Vector3_<DataT> Ones()
     {
         return {static_cast<DataT>(1), static_cast<DataT>(1), static_cast<DataT>(1)};
     }
 
-    RMAGINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     static Vector3_<DataT> Max()
     {
         return {std::numeric_limits<DataT>::max(), std::numeric_limits<DataT>::max(), std::numeric_limits<DataT>::max()};
     }
 
-    RMAGINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     static Vector3_<DataT> Min()
     {
         return {std::numeric_limits<DataT>::lowest(), std::numeric_limits<DataT>::lowest(), std::numeric_limits<DataT>::lowest()};
     }
 
     // FUNCTIONS
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> add(const Vector3_<DataT>& b) const;
 
     RMAGINE_INLINE_FUNCTION
     volatile Vector3_<DataT> add(volatile Vector3_<DataT>& b) const volatile;
     
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void addInplace(const Vector3_<DataT>& b);
 
     RMAGINE_INLINE_FUNCTION
     void addInplace(volatile Vector3_<DataT>& b) volatile;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> sub(const Vector3_<DataT>& b) const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> negate() const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void negateInplace();
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void subInplace(const Vector3_<DataT>& b);
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     DataT dot(const Vector3_<DataT>& b) const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> cross(const Vector3_<DataT>& b) const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     DataT mult(const Vector3_<DataT>& b) const;
     
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> multEwise(const Vector3_<DataT>& b) const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> mult(const DataT& s) const;
 
     RMAGINE_INLINE_FUNCTION
     volatile Vector3_<DataT> mult(const DataT& s) const volatile;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void multInplace(const DataT& s);
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Matrix_<DataT, 3, 3> multT(const Vector3_<DataT>& b) const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> div(const DataT& s) const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void divInplace(const DataT& s);
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     DataT l2normSquared() const;
 
     /**
@@ -112,10 +112,10 @@ struct Vector3_
     RMAGINE_INLINE_FUNCTION
     DataT l2norm() const; 
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     DataT sum() const;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     DataT prod() const;
     
     RMAGINE_INLINE_FUNCTION
@@ -127,11 +127,11 @@ struct Vector3_
     RMAGINE_INLINE_FUNCTION
     void normalizeInplace();
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     void setZeros();
 
     // OPERATORS
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> operator+(const Vector3_<DataT>& b) const
     {
         return add(b);
@@ -143,7 +143,7 @@ struct Vector3_
         return add(b);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT>& operator+=(const Vector3_<DataT>& b)
     {
         addInplace(b);
@@ -157,32 +157,32 @@ struct Vector3_
         return *this;
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> operator-(const Vector3_<DataT>& b) const
     {
         return sub(b);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT>& operator-=(const Vector3_<DataT>& b)
     {
         subInplace(b);
         return *this;
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> operator-() const
     {
         return negate();
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     DataT operator*(const Vector3_<DataT>& b) const
     {
         return mult(b);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> operator*(const DataT& s) const 
     {
         return mult(s);
@@ -194,20 +194,20 @@ struct Vector3_
         return mult(s);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT>& operator*=(const DataT& s)
     {
         multInplace(s);
         return *this;
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> operator/(const DataT& s) const 
     {
         return div(s);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> operator/=(const DataT& s)
     {
         divInplace(s);
@@ -226,13 +226,13 @@ struct Vector3_
     ////////////////////////
     // CASTING
     template<typename ConvT>
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<ConvT> cast() const;
 
     ///////////////////////
     // DEPRECATED FUNCTIONS
     [[deprecated("Use multEwise() instead.")]]
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector3_<DataT> mult_ewise(const Vector3_<DataT>& b) const
     {   
         return multEwise(b);
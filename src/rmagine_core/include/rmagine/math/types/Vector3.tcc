@@ -5,7 +5,7 @@ namespace rmagine
 {
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Vector3_<DataT> Vector3_<DataT>::add(const Vector3_<DataT>& b) const
 {
     return {x + b.x, y + b.y, z + b.z};
@@ -19,7 +19,7 @@ volatile Vector3_<DataT> Vector3_<DataT>::add(volatile Vector3_<DataT>& b) const
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Vector3_<DataT>::addInplace(const Vector3_<DataT>& b)
 {
     x += b.x;
@@ -37,21 +37,21 @@ void Vector3_<DataT>::addInplace(volatile Vector3_<DataT>& b) volatile
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Vector3_<DataT> Vector3_<DataT>::sub(const Vector3_<DataT>& b) const
 {
     return {x - b.x, y - b.y, z - b.z};
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Vector3_<DataT> Vector3_<DataT>::negate() const
 {
     return {-x, -y, -z};
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Vector3_<DataT>::negateInplace() 
 {
     x = -x;
@@ -60,7 +60,7 @@ void Vector3_<DataT>::negateInplace()
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Vector3_<DataT>::subInplace(const Vector3_<DataT>& b)
 {
     x -= b.x;
@@ -69,14 +69,14 @@ void Vector3_<DataT>::subInplace(const Vector3_<DataT>& b)
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT Vector3_<DataT>::dot(const Vector3_<DataT>& b) const 
 {
     return x * b.x + y * b.y + z * b.z;
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Vector3_<DataT> Vector3_<DataT>::cross(const Vector3_<DataT>& b) const
 {
     return {
@@ -87,24 +87,24 @@ Vector3_<DataT> Vector3_<DataT>::cross(const Vector3_<DataT>& b) const
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT Vector3_<DataT>::mult(const Vector3_<DataT>& b) const
 {
     return dot(b);
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Vector3_<DataT> Vector3_<DataT>::multEwise(const Vector3_<DataT>& b) const
 {
     return {x * b.x, y * b.y, z * b.z};
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Matrix_<DataT, 3, 3> Vector3_<DataT>::multT(const Vector3_<DataT>& b) const
 {
-    Matrix_<DataT, 3, 3> C;
+    Matrix_<DataT, 3, 3> C{};
     C(0,0) = x * b.x;
     C(1,0) = y * b.x;
     C(2,0) = z * b.x;
@@ -118,7 +118,7 @@ Matrix_<DataT, 3, 3> Vector3_<DataT>::multT(const Vector3_<DataT>& b) const
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Vector3_<DataT> Vector3_<DataT>::mult(const DataT& s) const 
 {
     return {x * s, y * s, z * s};
@@ -133,7 +133,7 @@ volatile Vector3_<DataT> Vector3_<DataT>::mult(const DataT& s) const volatile
 
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Vector3_<DataT>::multInplace(const DataT& s) 
 {
     x *= s;
@@ -142,14 +142,14 @@ void Vector3_<DataT>::multInplace(const DataT& s)
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Vector3_<DataT> Vector3_<DataT>::div(const DataT& s) const 
 {
     return {x / s, y / s, z / s};
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Vector3_<DataT>::divInplace(const DataT& s) 
 {
     x /= s;
@@ -158,7 +158,7 @@ void Vector3_<DataT>::divInplace(const DataT& s)
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT Vector3_<DataT>::l2normSquared() const
 {
     return x*x + y*y + z*z;
@@ -172,14 +172,14 @@ DataT Vector3_<DataT>::l2norm() const
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT Vector3_<DataT>::sum() const 
 {
     return x + y + z;
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 DataT Vector3_<DataT>::prod() const 
 {
     return x * y * z;
@@ -207,7 +207,7 @@ void Vector3_<DataT>::normalizeInplace()
 }
 
 template<typename DataT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 void Vector3_<DataT>::setZeros()
 {
     x = static_cast<DataT>(0);
@@ -217,7 +217,7 @@ void Vector3_<DataT>::setZeros()
 
 template<typename DataT>
 template<typename ConvT>
-RMAGINE_INLINE_FUNCTION
+RMAGINE_CONSTEXPR_FUNCTION
 Vector3_<ConvT> Vector3_<DataT>::cast() const
 {
     return {
@@ -0,0 +1,138 @@
+#ifndef RMAGINE_MATH_VECTOR6_HPP
+#define RMAGINE_MATH_VECTOR6_HPP
+
+#include "definitions.h"
+#include <rmagine/types/shared_functions.h>
+#include "Vector3.hpp"
+
+namespace rmagine
+{
+
+/**
+ * @brief 6D vector, e.g. a tangent vector of SE(3) (see rmagine/math/lie.h)
+ * 
+ * Consists of a rotational part w (axis-angle) and a translational part v.
+ * Index order of operator(): w.x, w.y, w.z, v.x, v.y, v.z
+ */
+template<typename DataT>
+struct Vector6_
+{
+    // DATA
+    Vector3_<DataT> w;
+    Vector3_<DataT> v;
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    static Vector6_<DataT> Zeros()
+    {
+        return {Vector3_<DataT>::Zeros(), Vector3_<DataT>::Zeros()};
+    }
+
+    // FUNCTIONS
+    RMAGINE_CONSTEXPR_FUNCTION
+    Vector6_<DataT> add(const Vector6_<DataT>& b) const;
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    Vector6_<DataT> sub(const Vector6_<DataT>& b) const;
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    Vector6_<DataT> negate() const;
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    Vector6_<DataT> mult(const DataT& s) const;
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    DataT dot(const Vector6_<DataT>& b) const;
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    DataT l2normSquared() const;
+
+    RMAGINE_INLINE_FUNCTION
+    DataT l2norm() const;
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    void setZeros();
+
+    // OPERATORS
+    RMAGINE_CONSTEXPR_FUNCTION
+    DataT& operator()(unsigned int i)
+    {
+        switch(i)
+        {
+            case 0: return w.x;
+            case 1: return w.y;
+            case 2: return w.z;
+            case 3: return v.x;
+            case 4: return v.y;
+            default: return v.z;
+        }
+    }
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    DataT operator()(unsigned int i) const
+    {
+        switch(i)
+        {
+            case 0: return w.x;
+            case 1: return w.y;
+            case 2: return w.z;
+            case 3: return v.x;
+            case 4: return v.y;
+            default: return v.z;
+        }
+    }
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    Vector6_<DataT> operator+(const Vector6_<DataT>& b) const
+    {
+        return add(b);
+    }
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    Vector6_<DataT>& operator+=(const Vector6_<DataT>& b)
+    {
+        w += b.w;
+        v += b.v;
+        return *this;
+    }
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    Vector6_<DataT> operator-(const Vector6_<DataT>& b) const
+    {
+        return sub(b);
+    }
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    Vector6_<DataT> operator-() const
+    {
+        return negate();
+    }
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    Vector6_<DataT> operator*(const DataT& s) const
+    {
+        return mult(s);
+    }
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    Vector6_<DataT>& operator*=(const DataT& s)
+    {
+        w *= s;
+        v *= s;
+        return *this;
+    }
+
+    ////////////////////////
+    // CASTING
+    template<typename ConvT>
+    RMAGINE_CONSTEXPR_FUNCTION
+    Vector6_<ConvT> cast() const
+    {
+        return {w.template cast<ConvT>(), v.template cast<ConvT>()};
+    }
+};
+
+} // namespace rmagine
+
+#include "Vector6.tcc"
+
+#endif // RMAGINE_MATH_VECTOR6_HPP
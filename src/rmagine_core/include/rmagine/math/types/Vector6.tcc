@@ -0,0 +1,64 @@
+#include "Vector6.hpp"
+#include <math.h>
+
+namespace rmagine
+{
+
+template<typename DataT>
+RMAGINE_CONSTEXPR_FUNCTION
+Vector6_<DataT> Vector6_<DataT>::add(const Vector6_<DataT>& b) const
+{
+    return {w + b.w, v + b.v};
+}
+
+template<typename DataT>
+RMAGINE_CONSTEXPR_FUNCTION
+Vector6_<DataT> Vector6_<DataT>::sub(const Vector6_<DataT>& b) const
+{
+    return {w - b.w, v - b.v};
+}
+
+template<typename DataT>
+RMAGINE_CONSTEXPR_FUNCTION
+Vector6_<DataT> Vector6_<DataT>::negate() const
+{
+    return {-w, -v};
+}
+
+template<typename DataT>
+RMAGINE_CONSTEXPR_FUNCTION
+Vector6_<DataT> Vector6_<DataT>::mult(const DataT& s) const
+{
+    return {w * s, v * s};
+}
+
+template<typename DataT>
+RMAGINE_CONSTEXPR_FUNCTION
+DataT Vector6_<DataT>::dot(const Vector6_<DataT>& b) const
+{
+    return w.dot(b.w) + v.dot(b.v);
+}
+
+template<typename DataT>
+RMAGINE_CONSTEXPR_FUNCTION
+DataT Vector6_<DataT>::l2normSquared() const
+{
+    return w.l2normSquared() + v.l2normSquared();
+}
+
+template<typename DataT>
+RMAGINE_INLINE_FUNCTION
+DataT Vector6_<DataT>::l2norm() const
+{
+    return sqrt(l2normSquared());
+}
+
+template<typename DataT>
+RMAGINE_CONSTEXPR_FUNCTION
+void Vector6_<DataT>::setZeros()
+{
+    w.setZeros();
+    v.setZeros();
+}
+
+} // namespace rmagine
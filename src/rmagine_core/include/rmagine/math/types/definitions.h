@@ -24,6 +24,9 @@ struct Vector2_;
 template<typename DataT>
 struct Vector3_;
 
+template<typename DataT>
+struct Vector6_;
+
 template<typename DataT>
 struct EulerAngles_;
 
@@ -42,6 +45,7 @@ struct AABB_;
 
 using Vector2f = Vector2_<float>;
 using Vector3f = Vector3_<float>;
+using Vector6f = Vector6_<float>;
 using Matrix2x2f = Matrix_<float, 2, 2>;
 using Matrix3x3f = Matrix_<float, 3, 3>;
 using Matrix4x4f = Matrix_<float, 4, 4>;
@@ -52,6 +56,7 @@ using AABBf = AABB_<float>;
 
 using Vector2d = Vector2_<double>;
 using Vector3d = Vector3_<double>;
+using Vector6d = Vector6_<double>;
 using Matrix2x2d = Matrix_<double, 2, 2>;
 using Matrix3x3d = Matrix_<double, 3, 3>;
 using Matrix4x4d = Matrix_<double, 4, 4>;
@@ -67,6 +72,7 @@ using DefaultFloatType = float;
 // default types
 using Vector3 = Vector3_<DefaultFloatType>;
 using Vector2 = Vector2_<DefaultFloatType>;
+using Vector6 = Vector6_<DefaultFloatType>;
 using Matrix2x2 = Matrix_<DefaultFloatType, 2, 2>;
 using Matrix3x3 = Matrix_<DefaultFloatType, 3, 3>;
 using Matrix4x4 = Matrix_<DefaultFloatType, 4, 4>;
@@ -44,6 +44,10 @@
 #include <rmagine/types/Memory.hpp>
 #include <rmagine/math/types.h>
 
+#include <memory>
+#include <cstdint>
+#include <type_traits>
+
 namespace rmagine
 {
 
@@ -192,6 +196,208 @@ static void resize_memory_bundle(BundleT& res,
     }
 }
 
+/**
+ * @brief Call f for the memory of every attribute that is part of the bundle.
+ * Order: hits, ranges, points, normals, face_ids, geom_ids, object_ids
+ */
+template<typename MemT, typename BundleT, typename FuncT>
+static void for_each_memory_attribute(BundleT& res, FuncT&& f)
+{
+    if constexpr(BundleT::template has<Hits<MemT> >())
+    {
+        f(res.Hits<MemT>::hits);
+    }
+
+    if constexpr(BundleT::template has<Ranges<MemT> >())
+    {
+        f(res.Ranges<MemT>::ranges);
+    }
+
+    if constexpr(BundleT::template has<Points<MemT> >())
+    {
+        f(res.Points<MemT>::points);
+    }
+
+    if constexpr(BundleT::template has<Normals<MemT> >())
+    {
+        f(res.Normals<MemT>::normals);
+    }
+
+    if constexpr(BundleT::template has<FaceIds<MemT> >())
+    {
+        f(res.FaceIds<MemT>::face_ids);
+    }
+
+    if constexpr(BundleT::template has<GeomIds<MemT> >())
+    {
+        f(res.GeomIds<MemT>::geom_ids);
+    }
+
+    if constexpr(BundleT::template has<ObjectIds<MemT> >())
+    {
+        f(res.ObjectIds<MemT>::object_ids);
+    }
+}
+
+/**
+ * @brief Alignment (in bytes) of every attribute buffer inside a contiguous bundle.
+ */
+constexpr size_t BUNDLE_MEMORY_ALIGNMENT = 64;
+
+/**
+ * @brief Resize a whole bundle of attributes using one single allocation
+ * 
+ * Instead of one allocation per attribute, all attribute buffers are placed
+ * into one slab of MemT, each starting at a BUNDLE_MEMORY_ALIGNMENT aligned offset.
+ * This reduces the number of allocations (and CUDA mallocs) for repeated simulations
+ * to one and keeps the results of one simulation call close to each other.
+ * The slab is freed as soon as the last attribute memory referencing it is
+ * destroyed or resized.
+ * 
+ * If the bundle already is stored contiguously with the requested size, nothing is done.
+ * Otherwise the contents are not preserved.
+ * 
+ * @code
+ * IntAttrAny<RAM> res;
+ * resize_memory_bundle_contiguous<RAM>(res, model.getWidth(), model.getHeight(), Tbm.size());
+ * sim->simulate(Tbm, res);
+ * @endcode
+ */
+template<typename MemT, typename BundleT>
+static void resize_memory_bundle_contiguous(BundleT& res, 
+    unsigned int W,
+    unsigned int H,
+    unsigned int N )
+{
+    const size_t Nelements = static_cast<size_t>(W) * H * N;
+    const size_t A = BUNDLE_MEMORY_ALIGNMENT;
+
+    // keep the slab if every attribute lies in it at the offset it would 
+    // get below: same holder, consecutive from the first attribute
+    bool keep = true;
+    size_t bytes = 0;
+    const std::shared_ptr<void>* holder = nullptr;
+    uintptr_t begin = 0;
+    for_each_memory_attribute<MemT>(res, [&](auto& mem) {
+        using DataT = typename std::decay_t<decltype(mem)>::DataType;
+        static_assert(std::is_trivially_copyable<DataT>::value, 
+            "Contiguous bundles require trivially copyable attributes");
+        bytes = (bytes + A - 1) / A * A;
+        if(holder == nullptr)
+        {
+            holder = &mem.holder();
+            begin = reinterpret_cast<uintptr_t>(mem.raw());
+        }
+        keep = keep && !mem.owning() 
+            && mem.holder() == *holder
+            && reinterpret_cast<uintptr_t>(mem.raw()) == begin + bytes
+            && mem.size() == Nelements;
+        bytes += Nelements * sizeof(DataT);
+    });
+
+    if(keep)
+    {
+        return;
+    }
+
+    // extra space to align the start of the slab
+    auto slab = std::make_shared<Memory<uint8_t, MemT> >(bytes + A);
+    const uintptr_t base = (reinterpret_cast<uintptr_t>(slab->raw()) + A - 1) / A * A;
+
+    size_t offset = 0;
+    for_each_memory_attribute<MemT>(res, [&](auto& mem) {
+        using DataT = typename std::decay_t<decltype(mem)>::DataType;
+        offset = (offset + A - 1) / A * A;
+        DataT* ptr = reinterpret_cast<DataT*>(base + offset);
+        mem = Memory<DataT, MemT>(ptr, Nelements, slab);
+        offset += Nelements * sizeof(DataT);
+    });
+}
+
+/**
+ * @brief All intersection attributes of one ray in one record
+ * 
+ * Simulators write their results attribute-wise (struct of arrays). There is 
+ * no storage mode in which they write records directly. Consumers that process 
+ * every attribute of one ray at once can copy the results into an array of 
+ * IntAttrRecord afterwards to access one ray with a single cache line.
+ */
+struct IntAttrRecord {
+    Point point;
+    Vector normal;
+    float range;
+    unsigned int face_id;
+    unsigned int geom_id;
+    unsigned int object_id;
+    uint8_t hit;
+};
+
+/**
+ * @brief Copy the attributes of a RAM bundle into an array of records (in parallel).
+ * Record fields of attributes that are not part of the bundle are not touched.
+ * 
+ * This is an extra pass over the results after the simulation, not an 
+ * array of structs layout of the bundle itself.
+ * 
+ * @param res      struct of arrays simulation results
+ * @param records  array of structs result. Size must match the size of the bundle attributes
+ */
+template<typename BundleT>
+static void copy_bundle_to_records(
+    const BundleT& res,
+    MemoryView<IntAttrRecord, RAM>& records)
+{
+    const long Nrecords = records.size();
+
+    #pragma omp parallel for
+    for(long i=0; i<Nrecords; i++)
+    {
+        IntAttrRecord& rec = records[i];
+        if constexpr(BundleT::template has<Hits<RAM> >())
+        {
+            rec.hit = res.Hits<RAM>::hits[i];
+        }
+        if constexpr(BundleT::template has<Ranges<RAM> >())
+        {
+            rec.range = res.Ranges<RAM>::ranges[i];
+        }
+        if constexpr(BundleT::template has<Points<RAM> >())
+        {
+            rec.point = res.Points<RAM>::points[i];
+        }
+        if constexpr(BundleT::template has<Normals<RAM> >())
+        {
+            rec.normal = res.Normals<RAM>::normals[i];
+        }
+        if constexpr(BundleT::template has<FaceIds<RAM> >())
+        {
+            rec.face_id = res.FaceIds<RAM>::face_ids[i];
+        }
+        if constexpr(BundleT::template has<GeomIds<RAM> >())
+        {
+            rec.geom_id = res.GeomIds<RAM>::geom_ids[i];
+        }
+        if constexpr(BundleT::template has<ObjectIds<RAM> >())
+        {
+            rec.object_id = res.ObjectIds<RAM>::object_ids[i];
+        }
+    }
+}
+
+template<typename BundleT>
+static Memory<IntAttrRecord, RAM> copy_bundle_to_records(
+    const BundleT& res)
+{
+    size_t N = 0;
+    for_each_memory_attribute<RAM>(res, [&](const auto& mem) {
+        N = mem.size();
+    });
+
+    Memory<IntAttrRecord, RAM> records(N);
+    copy_bundle_to_records(res, records);
+    return records;
+}
+
 // template<typename BundleT>
 // static void resize_memory_bundle(BundleT& res, 
 //     unsigned int W,
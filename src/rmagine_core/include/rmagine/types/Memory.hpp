@@ -39,13 +39,22 @@
 #include <iostream>
 #include <cstring>
 #include <type_traits>
+#include <memory>
+#include <algorithm>
+#include <vector>
 
 #include <rmagine/types/shared_functions.h>
+#include <rmagine/util/MemoryStats.hpp>
+#include <rmagine/util/exceptions.h>
 
 namespace rmagine {
 
 struct RAM;
 
+// elementwise expressions. see rmagine/math/expr.h
+template<typename ExprT>
+class MemoryExpr;
+
 template<typename DataT, typename MemT = RAM>
 class MemoryView {
 public:
@@ -68,6 +77,11 @@ public:
     MemoryView<DataT, MemT>& operator=(
         const MemoryView<DataT, MemT2>& o);
 
+    // Evaluate an expression in one pass (rmagine/math/expr.h)
+    template<typename ExprT>
+    MemoryView<DataT, MemT>& operator=(
+        const MemoryExpr<ExprT>& e);
+
     // TODO: Check CUDA usage (in kernels)
     RMAGINE_FUNCTION
     DataT* raw();
@@ -81,6 +95,31 @@ public:
         return raw();
     }
 
+    // iterators: range based for and std algorithms (RAM only)
+    RMAGINE_FUNCTION
+    DataT* begin()
+    {
+        return m_mem;
+    }
+
+    RMAGINE_FUNCTION
+    DataT* end()
+    {
+        return m_mem + m_size;
+    }
+
+    RMAGINE_FUNCTION
+    const DataT* begin() const
+    {
+        return m_mem;
+    }
+
+    RMAGINE_FUNCTION
+    const DataT* end() const
+    {
+        return m_mem + m_size;
+    }
+
     RMAGINE_FUNCTION
     const DataT* operator->() const
     {
@@ -171,10 +210,40 @@ public:
 
     Memory(Memory<DataT, MemT>&& o) noexcept;
 
+    // Evaluate an expression in one pass (rmagine/math/expr.h)
+    template<typename ExprT>
+    Memory(const MemoryExpr<ExprT>& e);
+
+    /**
+     * @brief Memory on a buffer that was not allocated by this object,
+     * e.g. a part of a larger slab. The buffer is kept alive as long as 
+     * holder is referenced. Elements are neither constructed nor destructed.
+     * A resize() copies the data into a newly allocated buffer of MemT.
+     * 
+     * @throws Exception if holder is empty but mem is not
+     */
+    Memory(DataT* mem, size_t N, std::shared_ptr<void> holder);
+
     ~Memory();
 
     void resize(size_t N);
 
+    /**
+     * @brief false if the buffer is only borrowed from a holder
+     */
+    inline bool owning() const
+    {
+        return !m_holder;
+    }
+
+    /**
+     * @brief keeps a borrowed buffer alive. empty if the buffer is owned
+     */
+    inline const std::shared_ptr<void>& holder() const
+    {
+        return m_holder;
+    }
+
     // Copy for assignment of same MemT
     Memory<DataT, MemT>& operator=(
         const MemoryView<DataT, MemT>& o);
@@ -201,20 +270,110 @@ public:
         return operator=(c);
     }
 
+    /**
+     * @brief Move for assignment of same MemT: takes over the buffer of o 
+     * and releases the own one, even if the sizes match. Views of the 
+     * previous buffer dangle afterwards, e.g. after mem = make_something().
+     * Assign a MemoryView to copy into the existing buffer instead.
+     */
+    Memory<DataT, MemT>& operator=(Memory<DataT, MemT>&& o) noexcept;
+
+    // Evaluate an expression in one pass. Resizes if necessary
+    template<typename ExprT>
+    Memory<DataT, MemT>& operator=(const MemoryExpr<ExprT>& e);
+
 protected:
 
+    void release();
+
     using Base::m_mem;
     using Base::m_size;
+
+    // keeps borrowed buffers alive. empty if the buffer is owned
+    std::shared_ptr<void> m_holder;
 };
 
 template<typename DataT, typename MemT = RAM>
 using Mem = Memory<DataT, MemT>;
 
+/**
+ * @brief Take ownership of an external buffer of MemT without copying
+ * 
+ * @param mem      buffer of at least N elements
+ * @param N        number of elements
+ * @param deleter  called with mem as soon as the returned Memory 
+ *                 (or the last slab view of it) is destroyed or resized
+ * 
+ * @code
+ * float* data = new float[1000];
+ * Memory<float, RAM> mem = adopt_memory(data, 1000, [](float* p) { delete[] p; });
+ * @endcode
+ */
+template<typename MemT = RAM, typename DataT, typename DeleterT>
+Memory<DataT, MemT> adopt_memory(DataT* mem, size_t N, DeleterT deleter)
+{
+    std::shared_ptr<void> holder(static_cast<void*>(mem), 
+        [deleter](void* p) mutable { deleter(static_cast<DataT*>(p)); });
+    return Memory<DataT, MemT>(mem, N, std::move(holder));
+}
+
+/**
+ * @brief Share an external buffer of MemT. The buffer lives as long 
+ * as holder or the returned Memory
+ */
+template<typename MemT = RAM, typename DataT, typename HolderT>
+Memory<DataT, MemT> share_memory(DataT* mem, size_t N, std::shared_ptr<HolderT> holder)
+{
+    return Memory<DataT, MemT>(mem, N, std::move(holder));
+}
+
+/**
+ * @brief Take over the buffer of a std::vector without copying
+ * 
+ * @code
+ * std::vector<Point> cloud = load_cloud();
+ * Memory<Point, RAM> cloud_mem = adopt_memory(std::move(cloud));
+ * @endcode
+ */
+template<typename DataT, typename AllocT>
+Memory<DataT, RAM> adopt_memory(std::vector<DataT, AllocT>&& vec)
+{
+    auto holder = std::make_shared<std::vector<DataT, AllocT> >(std::move(vec));
+    return Memory<DataT, RAM>(holder->data(), holder->size(), holder);
+}
+
+/**
+ * @brief Share the buffer of a std::vector. The vector must not be resized
+ * while the returned Memory is in use
+ */
+template<typename DataT, typename AllocT>
+Memory<DataT, RAM> share_memory(std::shared_ptr<std::vector<DataT, AllocT> > vec)
+{
+    DataT* mem = vec->data();
+    const size_t N = vec->size();
+    return Memory<DataT, RAM>(mem, N, std::move(vec));
+}
+
 // RAM specific
 
+/**
+ * @brief Where the pages of large RAM allocations are placed on multi-socket (NUMA) hosts
+ */
+enum class RamPlacement {
+    // pages are placed on the node of the thread that writes them first
+    DEFAULT,
+    // pages are first touched in parallel with a static partitioning, 
+    // the same partitioning the simulators use for their pose loops.
+    // Each thread's part of a result buffer then lies on its local node
+    FIRST_TOUCH,
+    // pages are distributed round robin over all NUMA nodes
+    INTERLEAVE
+};
+
 // RAM Type
 struct RAM {
-    
+    static constexpr char name[] = "RAM";
+
     template<typename DataT>
     static DataT* alloc(size_t N);
 
@@ -223,6 +382,25 @@ struct RAM {
 
     template<typename DataT>
     static void free(DataT* mem, size_t N);
+
+    /**
+     * @brief Set the page placement for all following allocations of at least min_bytes.
+     * Smaller allocations are always done with plain malloc
+     */
+    static void setPlacement(RamPlacement placement, size_t min_bytes = 16 * 1024 * 1024);
+
+    static RamPlacement placement();
+
+    /**
+     * @brief true if an allocation of this size is placed according to placement()
+     */
+    static bool placed(size_t bytes);
+
+    /**
+     * @brief Page aligned allocation placed according to placement(). 
+     * Trivially constructible data is touched in parallel. Release with ::free
+     */
+    static void* allocPlaced(size_t bytes);
 };
 
 // Some functions that can be specialized:
@@ -70,6 +70,10 @@ Memory<DataT, MemT>::Memory(size_t N)
 :Base(MemT::template alloc<DataT>(N), N)
 {
     // std::cout << "[Memory::Memory(size_t)]" << std::endl;
+    if(MemoryStats::enabled())
+    {
+        MemoryStats::onAlloc(MemT::name, m_mem, sizeof(DataT) * N);
+    }
 }
 
 template<typename DataT, typename MemT>
@@ -98,6 +102,7 @@ Memory<DataT, MemT>::Memory(const MemoryView<DataT, MemT2>& o)
 template<typename DataT, typename MemT>
 Memory<DataT, MemT>::Memory(Memory<DataT, MemT>&& o) noexcept
 :Base(o.m_mem, o.m_size)
+,m_holder(std::move(o.m_holder))
 {
     // std::cout << "[Memory] Move" << std::endl;
     // move
@@ -105,29 +110,97 @@ Memory<DataT, MemT>::Memory(Memory<DataT, MemT>&& o) noexcept
     o.m_size = 0;
 }
 
-
+template<typename DataT, typename MemT>
+Memory<DataT, MemT>::Memory(DataT* mem, size_t N, std::shared_ptr<void> holder)
+:Base(mem, N)
+,m_holder(std::move(holder))
+{
+    if(!m_holder && mem != nullptr)
+    {
+        // would be freed by MemT::free as if it was allocated by this object
+        RM_THROW(Exception, "Memory: borrowed buffer without holder.");
+    }
+}
 
 template<typename DataT, typename MemT>
 Memory<DataT, MemT>::~Memory()
 {
     // std::cout << "[Memory] Destructor" << std::endl;
-    MemT::free(m_mem, m_size);
+    release();
+}
+
+template<typename DataT, typename MemT>
+void Memory<DataT, MemT>::release()
+{
+    if(m_holder)
+    {
+        // borrowed: the holder cares about destruction
+        m_holder.reset();
+    } else {
+        if(m_mem != nullptr && MemoryStats::enabled())
+        {
+            MemoryStats::onFree(MemT::name, m_mem);
+        }
+        MemT::free(m_mem, m_size);
+    }
+    m_mem = nullptr;
+    m_size = 0;
 }
 
 template<typename DataT, typename MemT>
 void Memory<DataT, MemT>::resize(size_t N) 
 {
+    if(m_holder)
+    {
+        // borrowed buffer cannot be reallocated -> move data to own buffer
+        Memory<DataT, MemT> tmp(N);
+        const size_t Ncopy = std::min(N, m_size);
+        if(Ncopy > 0)
+        {
+            const MemoryView<DataT, MemT> src(m_mem, Ncopy);
+            MemoryView<DataT, MemT> dst = tmp(0, Ncopy);
+            copy(src, dst);
+        }
+        *this = std::move(tmp);
+        return;
+    }
+
     if(m_mem != nullptr)
     {
         // initialized -> resize
+        DataT* mem_old = m_mem;
         m_mem = MemT::realloc(m_mem, m_size, N);
+        if(MemoryStats::enabled())
+        {
+            MemoryStats::onRealloc(MemT::name, mem_old, m_mem, sizeof(DataT) * N);
+        }
     } else {
         // not initialized -> make new buffer of size N
         m_mem = MemT::template alloc<DataT>(N);
+        if(MemoryStats::enabled())
+        {
+            MemoryStats::onAlloc(MemT::name, m_mem, sizeof(DataT) * N);
+        }
     }
     m_size = N;
 }
 
+template<typename DataT, typename MemT>
+Memory<DataT, MemT>& Memory<DataT, MemT>::operator=(
+    Memory<DataT, MemT>&& o) noexcept
+{
+    if(this != &o)
+    {
+        release();
+        m_mem = o.m_mem;
+        m_size = o.m_size;
+        m_holder = std::move(o.m_holder);
+        o.m_mem = nullptr;
+        o.m_size = 0;
+    }
+    return *this;
+}
+
 template<typename DataT, typename MemT>
 Memory<DataT, MemT>& Memory<DataT, MemT>::operator=(
     const MemoryView<DataT, MemT>& o)
@@ -158,6 +231,23 @@ Memory<DataT, MemT>& Memory<DataT, MemT>::operator=(
 template<typename DataT>
 DataT* RAM::alloc(size_t N)
 {
+    if(placed(N * sizeof(DataT)))
+    {
+        DataT* ret = static_cast<DataT*>(allocPlaced(N * sizeof(DataT)));
+
+        if constexpr( !std::is_trivially_constructible<DataT>::value )
+        {
+            // construct in the same order the pages were touched
+            #pragma omp parallel for schedule(static)
+            for(size_t i=0; i<N; i++)
+            {
+                new (&ret[i]) DataT();
+            }
+        }
+
+        return ret;
+    }
+
     DataT* ret = static_cast<DataT*>(malloc(N * sizeof(DataT)));
 
     if constexpr( !std::is_trivially_constructible<DataT>::value )
@@ -174,21 +264,38 @@ DataT* RAM::alloc(size_t N)
 template<typename DataT>
 DataT* RAM::realloc(DataT* mem, size_t Nold, size_t Nnew)
 {
-    DataT* ret = static_cast<DataT*>(::realloc(mem, Nnew * sizeof(DataT)));
-    
-    if constexpr( !std::is_trivially_constructible<DataT>::value )
+    if(Nnew > Nold && placed(Nnew * sizeof(DataT)))
     {
-        // construct new elements
-        size_t id_b = Nold;
-        size_t id_e = Nnew;
+        // growing into placed memory: the pages of ::realloc 
+        // would be first touched by the copying thread
+        DataT* ret = static_cast<DataT*>(allocPlaced(Nnew * sizeof(DataT)));
+        if(Nold > 0)
+        {
+            std::memcpy(static_cast<void*>(ret), mem, Nold * sizeof(DataT));
+        }
+        // mem may be non-null with Nold == 0, e.g. after resize(0)
+        ::free(mem);
 
-        if(ret != mem)
+        if constexpr( !std::is_trivially_constructible<DataT>::value )
         {
-            // beginnings differ: recall all constructors
-            id_b = 0;
+            #pragma omp parallel for schedule(static)
+            for(size_t i=Nold; i<Nnew; i++)
+            {
+                new (&ret[i]) DataT();
+            }
         }
 
-        for(size_t i=id_b; i < id_e; i++)
+        return ret;
+    }
+
+    DataT* ret = static_cast<DataT*>(::realloc(mem, Nnew * sizeof(DataT)));
+    
+    if constexpr( !std::is_trivially_constructible<DataT>::value )
+    {
+        // construct new elements only. If the beginnings differ, ::realloc 
+        // moved the existing elements bytewise: constructing them again 
+        // would overwrite them (same as the placed path above)
+        for(size_t i=Nold; i < Nnew; i++)
         {
             new (&ret[i]) DataT();
         }
@@ -210,11 +317,8 @@ void RAM::free(DataT* mem, size_t N)
         }
     }
 
-    if(N > 0)
-    {
-        // std::cout << "Free " << mem << std::endl;
-        ::free(mem);
-    }
+    // malloc(0) and realloc(mem, 0) may return non-null buffers
+    ::free(mem);
 }
 
 
@@ -64,6 +64,7 @@ void* freeHost(void* ptr);
 } // namespace cuda
 
 struct VRAM_CUDA {
+    static constexpr char name[] = "VRAM_CUDA";
 
     template<typename DataT>
     static DataT* alloc(size_t N);
@@ -76,6 +77,8 @@ struct VRAM_CUDA {
 };
 
 struct RAM_CUDA {
+    static constexpr char name[] = "RAM_CUDA";
+
     template<typename DataT>
     static DataT* alloc(size_t N);
 
@@ -87,6 +90,8 @@ struct RAM_CUDA {
 };
 
 struct UNIFIED_CUDA {
+    static constexpr char name[] = "UNIFIED_CUDA";
+
     template<typename DataT>
     static DataT* alloc(size_t N);
 
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief Zero-copy exchange of Memory with Eigen
+ * 
+ * - adopt_memory: move an Eigen matrix into a Memory object
+ * - eigen_map: Eigen::Map on a MemoryView in RAM
+ * 
+ * @code
+ * Eigen::Matrix3Xf cloud = load_cloud();
+ * Memory<Point, RAM> cloud_mem = adopt_memory(std::move(cloud));
+ * 
+ * // 3xN view on the same buffer
+ * Eigen::Map<Eigen::Matrix3Xf> cloud_eig = eigen_map(cloud_mem);
+ * Eigen::Vector3f c = cloud_eig.rowwise().mean();
+ * @endcode
+ *
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_TYPES_MEMORY_EIGEN_HPP
+#define RMAGINE_TYPES_MEMORY_EIGEN_HPP
+
+#include <rmagine/types/Memory.hpp>
+#include <rmagine/math/types.h>
+#include <Eigen/Dense>
+
+namespace rmagine
+{
+
+static_assert(sizeof(Vector3_<float>) == 3 * sizeof(float), 
+    "Vector3 must be densely packed to be mapped by Eigen");
+static_assert(sizeof(Vector3_<double>) == 3 * sizeof(double), 
+    "Vector3 must be densely packed to be mapped by Eigen");
+
+/**
+ * @brief Take over the buffer of a (3 x N) column major Eigen matrix
+ * as N vectors without copying
+ */
+template<typename DataT>
+Memory<Vector3_<DataT>, RAM> adopt_memory(
+    Eigen::Matrix<DataT, 3, Eigen::Dynamic>&& M)
+{
+    using MatT = Eigen::Matrix<DataT, 3, Eigen::Dynamic>;
+    auto holder = std::make_shared<MatT>(std::move(M));
+    return Memory<Vector3_<DataT>, RAM>(
+        reinterpret_cast<Vector3_<DataT>*>(holder->data()), holder->cols(), holder);
+}
+
+/**
+ * @brief Take over the buffer of an Eigen column vector without copying
+ */
+template<typename DataT>
+Memory<DataT, RAM> adopt_memory(
+    Eigen::Matrix<DataT, Eigen::Dynamic, 1>&& v)
+{
+    using VecT = Eigen::Matrix<DataT, Eigen::Dynamic, 1>;
+    auto holder = std::make_shared<VecT>(std::move(v));
+    return Memory<DataT, RAM>(holder->data(), holder->size(), holder);
+}
+
+/**
+ * @brief (3 x N) Eigen map on N vectors
+ */
+template<typename DataT>
+Eigen::Map<Eigen::Matrix<DataT, 3, Eigen::Dynamic> > eigen_map(
+    MemoryView<Vector3_<DataT>, RAM>& mem)
+{
+    return Eigen::Map<Eigen::Matrix<DataT, 3, Eigen::Dynamic> >(
+        reinterpret_cast<DataT*>(mem.raw()), 3, mem.size());
+}
+
+template<typename DataT>
+Eigen::Map<const Eigen::Matrix<DataT, 3, Eigen::Dynamic> > eigen_map(
+    const MemoryView<Vector3_<DataT>, RAM>& mem)
+{
+    return Eigen::Map<const Eigen::Matrix<DataT, 3, Eigen::Dynamic> >(
+        reinterpret_cast<const DataT*>(mem.raw()), 3, mem.size());
+}
+
+/**
+ * @brief Eigen column vector map on scalar memory, e.g. ranges
+ */
+template<typename DataT, 
+    typename = typename std::enable_if<std::is_arithmetic<DataT>::value>::type>
+Eigen::Map<Eigen::Matrix<DataT, Eigen::Dynamic, 1> > eigen_map(
+    MemoryView<DataT, RAM>& mem)
+{
+    return Eigen::Map<Eigen::Matrix<DataT, Eigen::Dynamic, 1> >(
+        mem.raw(), mem.size());
+}
+
+template<typename DataT, 
+    typename = typename std::enable_if<std::is_arithmetic<DataT>::value>::type>
+Eigen::Map<const Eigen::Matrix<DataT, Eigen::Dynamic, 1> > eigen_map(
+    const MemoryView<DataT, RAM>& mem)
+{
+    return Eigen::Map<const Eigen::Matrix<DataT, Eigen::Dynamic, 1> >(
+        mem.raw(), mem.size());
+}
+
+} // namespace rmagine
+
+#endif // RMAGINE_TYPES_MEMORY_EIGEN_HPP
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *
+ * @brief Strided N-dimensional views over Memory
+ *
+ * Simulation results are stored as flat 1D buffers in the order
+ * (pose, row, column). A TensorView interprets such a buffer with
+ * a shape and strides, so that sub-windows, single poses or
+ * transposed layouts can be accessed without copying.
+ *
+ * @code
+ * Memory<float, RAM> ranges = sim->simulateRanges(Tbm);
+ * // shape: (Tbm.size(), model.getHeight(), model.getWidth())
+ * auto T = make_sensor_view(ranges, model);
+ * // rows 4-7 of every pose. no copy
+ * auto rows = T.slice(1, 4, 8);
+ * float r = rows(pid, 0, hid);
+ * @endcode
+ *
+ * @date 19.10.2026
+ * @author Alexander Mock
+ *
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ *
+ */
+
+#ifndef RMAGINE_TYPES_TENSOR_VIEW_HPP
+#define RMAGINE_TYPES_TENSOR_VIEW_HPP
+
+#include <array>
+#include <type_traits>
+#include <stdexcept>
+
+#include <rmagine/types/Memory.hpp>
+#include <rmagine/types/shared_functions.h>
+
+namespace rmagine
+{
+
+/**
+ * @brief Non-owning, strided N-dimensional view on memory of type MemT
+ *
+ * - shape and strides are given in number of elements
+ * - slicing, selecting and transposing only change shape, strides and
+ *   the start pointer. The data itself is never touched
+ * - the last dimension is the fastest running one for views created from
+ *   contiguous memory (row major)
+ *
+ * @tparam DataT  element type. Use const DataT for read-only views
+ * @tparam Dim    number of dimensions
+ * @tparam MemT   memory type, e.g. RAM or VRAM_CUDA
+ */
+template<typename DataT, unsigned int Dim, typename MemT = RAM>
+class TensorView {
+public:
+    static_assert(Dim > 0, "TensorView requires at least one dimension");
+
+    using DataType = DataT;
+    using MemType = MemT;
+    using Shape = std::array<size_t, Dim>;
+
+    TensorView() = delete;
+
+    /**
+     * @brief View contiguous (row major) memory with a certain shape
+     */
+    TensorView(DataT* mem, const Shape& shape);
+
+    /**
+     * @brief View memory with arbitrary strides
+     */
+    TensorView(DataT* mem, const Shape& shape, const Shape& strides);
+
+    /**
+     * @brief View a contiguous MemoryView. The number of elements
+     * described by shape must match the size of the MemoryView
+     */
+    template<typename MemDataT>
+    TensorView(const MemoryView<MemDataT, MemT>& mem, const Shape& shape);
+
+    /**
+     * @brief Copy the data of another view of same shape into this view
+     */
+    TensorView<DataT, Dim, MemT>& operator=(
+        const TensorView<DataT, Dim, MemT>& o);
+
+    template<typename DataT2>
+    TensorView<DataT, Dim, MemT>& operator=(
+        const TensorView<DataT2, Dim, MemT>& o);
+
+    static constexpr unsigned int dims()
+    {
+        return Dim;
+    }
+
+    RMAGINE_INLINE_FUNCTION
+    size_t shape(unsigned int d) const
+    {
+        return m_shape[d];
+    }
+
+    RMAGINE_INLINE_FUNCTION
+    size_t stride(unsigned int d) const
+    {
+        return m_strides[d];
+    }
+
+    Shape shape() const;
+
+    Shape strides() const;
+
+    /**
+     * @brief total number of elements covered by the view
+     */
+    RMAGINE_INLINE_FUNCTION
+    size_t size() const
+    {
+        size_t ret = 1;
+        for(unsigned int d=0; d<Dim; d++)
+        {
+            ret *= m_shape[d];
+        }
+        return ret;
+    }
+
+    RMAGINE_INLINE_FUNCTION
+    DataT* raw()
+    {
+        return m_mem;
+    }
+
+    RMAGINE_INLINE_FUNCTION
+    const DataT* raw() const
+    {
+        return m_mem;
+    }
+
+    template<typename... IdxT>
+    RMAGINE_INLINE_FUNCTION
+    size_t offset(IdxT... idx) const
+    {
+        static_assert(sizeof...(IdxT) == Dim, "Number of indices must match the dimension of the TensorView");
+        const size_t ids[Dim] = {static_cast<size_t>(idx)...};
+        size_t ret = 0;
+        for(unsigned int d=0; d<Dim; d++)
+        {
+            ret += ids[d] * m_strides[d];
+        }
+        return ret;
+    }
+
+    template<typename... IdxT>
+    RMAGINE_INLINE_FUNCTION
+    DataT& operator()(IdxT... idx)
+    {
+        return m_mem[offset(idx...)];
+    }
+
+    template<typename... IdxT>
+    RMAGINE_INLINE_FUNCTION
+    const DataT& operator()(IdxT... idx) const
+    {
+        return m_mem[offset(idx...)];
+    }
+
+    /**
+     * @brief Access element by its flat (row major) index
+     * with respect to the shape of this view
+     */
+    RMAGINE_INLINE_FUNCTION
+    DataT& at(size_t flat_id)
+    {
+        return m_mem[flatOffset(flat_id)];
+    }
+
+    RMAGINE_INLINE_FUNCTION
+    const DataT& at(size_t flat_id) const
+    {
+        return m_mem[flatOffset(flat_id)];
+    }
+
+    RMAGINE_INLINE_FUNCTION
+    size_t flatOffset(size_t flat_id) const
+    {
+        size_t off = 0;
+        for(int d = static_cast<int>(Dim) - 1; d >= 0; d--)
+        {
+            off += (flat_id % m_shape[d]) * m_strides[d];
+            flat_id /= m_shape[d];
+        }
+        return off;
+    }
+
+    /**
+     * @brief Restrict dimension d to the index range [idx_start, idx_end)
+     * taking every step-th element
+     */
+    TensorView<DataT, Dim, MemT> slice(
+        unsigned int d,
+        size_t idx_start,
+        size_t idx_end,
+        size_t step = 1) const;
+
+    /**
+     * @brief Fix the index of dimension d. The resulting view has one dimension less
+     *
+     * @code
+     * // all rows and columns of pose 5
+     * TensorView<float, 2> scan = T.select(0, 5);
+     * @endcode
+     */
+    template<unsigned int D = Dim>
+    typename std::enable_if<(D > 1), TensorView<DataT, Dim - 1, MemT> >::type
+    select(unsigned int d, size_t idx) const;
+
+    /**
+     * @brief Swap dimensions d1 and d2
+     */
+    TensorView<DataT, Dim, MemT> transpose(
+        unsigned int d1 = 0,
+        unsigned int d2 = Dim - 1) const;
+
+    /**
+     * @brief Reorder dimensions: new dimension i is old dimension order[i]
+     */
+    TensorView<DataT, Dim, MemT> permute(
+        const std::array<unsigned int, Dim>& order) const;
+
+    /**
+     * @brief true if the view covers a gapless row major block of memory
+     */
+    bool isContiguous() const;
+
+    /**
+     * @brief Flat 1D view. Only possible for contiguous views
+     */
+    MemoryView<DataT, MemT> flat() const;
+
+    template<typename DataT2, unsigned int Dim2, typename MemT2>
+    friend class TensorView;
+
+protected:
+    DataT* m_mem;
+    size_t m_shape[Dim];
+    size_t m_strides[Dim];
+};
+
+template<typename DataT, unsigned int Dim, typename MemT = RAM>
+using TensView = TensorView<DataT, Dim, MemT>;
+
+/**
+ * @brief Interpret a flat simulation buffer as a (pose x row x column) tensor
+ *
+ * Valid for every sensor model that stores its rays row by row
+ * (getBufferId(vid, hid) = vid * getWidth() + hid)
+ *
+ * @param mem    flat buffer of size N * model.size()
+ * @param model  sensor model used for the simulation
+ */
+template<typename DataT, typename MemT, typename ModelT>
+TensorView<DataT, 3, MemT> make_sensor_view(
+    MemoryView<DataT, MemT>& mem,
+    const ModelT& model);
+
+template<typename DataT, typename MemT, typename ModelT>
+TensorView<const DataT, 3, MemT> make_sensor_view(
+    const MemoryView<DataT, MemT>& mem,
+    const ModelT& model);
+
+/**
+ * @brief Copy the elements of a view into another view of same shape.
+ *
+ * - contiguous views: single memcpy
+ * - contiguous last dimension: one memcpy per row
+ * - otherwise: strided, vectorized element copy per row
+ *
+ * Rows are processed in parallel.
+ */
+template<typename SrcDataT, typename DataT, unsigned int Dim>
+void copy(
+    const TensorView<SrcDataT, Dim, RAM>& from,
+    TensorView<DataT, Dim, RAM>& to);
+
+/**
+ * @brief Gather the elements of a view into contiguous memory (row major)
+ */
+template<typename SrcDataT, typename DataT, unsigned int Dim>
+void copy(
+    const TensorView<SrcDataT, Dim, RAM>& from,
+    MemoryView<DataT, RAM>& to);
+
+} // namespace rmagine
+
+#include "TensorView.tcc"
+
+#endif // RMAGINE_TYPES_TENSOR_VIEW_HPP
@@ -0,0 +1,299 @@
+#include "TensorView.hpp"
+
+namespace rmagine
+{
+
+//// TENSOR VIEW
+template<typename DataT, unsigned int Dim, typename MemT>
+TensorView<DataT, Dim, MemT>::TensorView(DataT* mem, const Shape& shape)
+:m_mem(mem)
+{
+    size_t stride = 1;
+    for(int d = static_cast<int>(Dim) - 1; d >= 0; d--)
+    {
+        m_shape[d] = shape[d];
+        m_strides[d] = stride;
+        stride *= shape[d];
+    }
+}
+
+template<typename DataT, unsigned int Dim, typename MemT>
+TensorView<DataT, Dim, MemT>::TensorView(DataT* mem, const Shape& shape, const Shape& strides)
+:m_mem(mem)
+{
+    for(unsigned int d=0; d<Dim; d++)
+    {
+        m_shape[d] = shape[d];
+        m_strides[d] = strides[d];
+    }
+}
+
+template<typename DataT, unsigned int Dim, typename MemT>
+template<typename MemDataT>
+TensorView<DataT, Dim, MemT>::TensorView(const MemoryView<MemDataT, MemT>& mem, const Shape& shape)
+:TensorView(const_cast<MemDataT*>(mem.raw()), shape)
+{
+    static_assert(std::is_convertible<MemDataT*, DataT*>::value,
+        "TensorView: Cannot view memory of different data type");
+
+    if(size() != mem.size())
+    {
+        throw std::runtime_error("TensorView: shape does not match the size of the memory");
+    }
+}
+
+template<typename DataT, unsigned int Dim, typename MemT>
+TensorView<DataT, Dim, MemT>& TensorView<DataT, Dim, MemT>::operator=(
+    const TensorView<DataT, Dim, MemT>& o)
+{
+    copy(o, *this);
+    return *this;
+}
+
+template<typename DataT, unsigned int Dim, typename MemT>
+template<typename DataT2>
+TensorView<DataT, Dim, MemT>& TensorView<DataT, Dim, MemT>::operator=(
+    const TensorView<DataT2, Dim, MemT>& o)
+{
+    copy(o, *this);
+    return *this;
+}
+
+template<typename DataT, unsigned int Dim, typename MemT>
+typename TensorView<DataT, Dim, MemT>::Shape TensorView<DataT, Dim, MemT>::shape() const
+{
+    Shape ret;
+    for(unsigned int d=0; d<Dim; d++)
+    {
+        ret[d] = m_shape[d];
+    }
+    return ret;
+}
+
+template<typename DataT, unsigned int Dim, typename MemT>
+typename TensorView<DataT, Dim, MemT>::Shape TensorView<DataT, Dim, MemT>::strides() const
+{
+    Shape ret;
+    for(unsigned int d=0; d<Dim; d++)
+    {
+        ret[d] = m_strides[d];
+    }
+    return ret;
+}
+
+template<typename DataT, unsigned int Dim, typename MemT>
+TensorView<DataT, Dim, MemT> TensorView<DataT, Dim, MemT>::slice(
+    unsigned int d,
+    size_t idx_start,
+    size_t idx_end,
+    size_t step) const
+{
+    if(d >= Dim || idx_start > idx_end || idx_end > m_shape[d] || step == 0)
+    {
+        throw std::runtime_error("TensorView: invalid slice");
+    }
+
+    Shape shape_new = shape();
+    Shape strides_new = strides();
+    shape_new[d] = (idx_end - idx_start + step - 1) / step;
+    strides_new[d] *= step;
+
+    return TensorView<DataT, Dim, MemT>(m_mem + idx_start * m_strides[d], shape_new, strides_new);
+}
+
+template<typename DataT, unsigned int Dim, typename MemT>
+template<unsigned int D>
+typename std::enable_if<(D > 1), TensorView<DataT, Dim - 1, MemT> >::type
+TensorView<DataT, Dim, MemT>::select(unsigned int d, size_t idx) const
+{
+    if(d >= Dim || idx >= m_shape[d])
+    {
+        throw std::runtime_error("TensorView: invalid select");
+    }
+
+    typename TensorView<DataT, Dim - 1, MemT>::Shape shape_new;
+    typename TensorView<DataT, Dim - 1, MemT>::Shape strides_new;
+
+    unsigned int j = 0;
+    for(unsigned int i=0; i<Dim; i++)
+    {
+        if(i != d)
+        {
+            shape_new[j] = m_shape[i];
+            strides_new[j] = m_strides[i];
+            j++;
+        }
+    }
+
+    return TensorView<DataT, Dim - 1, MemT>(m_mem + idx * m_strides[d], shape_new, strides_new);
+}
+
+template<typename DataT, unsigned int Dim, typename MemT>
+TensorView<DataT, Dim, MemT> TensorView<DataT, Dim, MemT>::transpose(
+    unsigned int d1,
+    unsigned int d2) const
+{
+    if(d1 >= Dim || d2 >= Dim)
+    {
+        throw std::runtime_error("TensorView: invalid transpose");
+    }
+
+    Shape shape_new = shape();
+    Shape strides_new = strides();
+    std::swap(shape_new[d1], shape_new[d2]);
+    std::swap(strides_new[d1], strides_new[d2]);
+
+    return TensorView<DataT, Dim, MemT>(m_mem, shape_new, strides_new);
+}
+
+template<typename DataT, unsigned int Dim, typename MemT>
+TensorView<DataT, Dim, MemT> TensorView<DataT, Dim, MemT>::permute(
+    const std::array<unsigned int, Dim>& order) const
+{
+    Shape shape_new;
+    Shape strides_new;
+
+    bool used[Dim] = {};
+    for(unsigned int i=0; i<Dim; i++)
+    {
+        if(order[i] >= Dim || used[order[i]])
+        {
+            throw std::runtime_error("TensorView: invalid permutation");
+        }
+        used[order[i]] = true;
+        shape_new[i] = m_shape[order[i]];
+        strides_new[i] = m_strides[order[i]];
+    }
+
+    return TensorView<DataT, Dim, MemT>(m_mem, shape_new, strides_new);
+}
+
+template<typename DataT, unsigned int Dim, typename MemT>
+bool TensorView<DataT, Dim, MemT>::isContiguous() const
+{
+    size_t expected = 1;
+    for(int d = static_cast<int>(Dim) - 1; d >= 0; d--)
+    {
+        // dimensions of size 1 are never stepped through
+        if(m_shape[d] != 1 && m_strides[d] != expected)
+        {
+            return false;
+        }
+        expected *= m_shape[d];
+    }
+    return true;
+}
+
+template<typename DataT, unsigned int Dim, typename MemT>
+MemoryView<DataT, MemT> TensorView<DataT, Dim, MemT>::flat() const
+{
+    if(!isContiguous())
+    {
+        throw std::runtime_error("TensorView: flat() requires a contiguous view. Copy it first");
+    }
+    return MemoryView<DataT, MemT>(m_mem, size());
+}
+
+//// SENSOR VIEWS
+template<typename DataT, typename MemT, typename ModelT>
+TensorView<DataT, 3, MemT> make_sensor_view(
+    MemoryView<DataT, MemT>& mem,
+    const ModelT& model)
+{
+    const size_t N = mem.size() / model.size();
+    return TensorView<DataT, 3, MemT>(mem, {N, model.getHeight(), model.getWidth()});
+}
+
+template<typename DataT, typename MemT, typename ModelT>
+TensorView<const DataT, 3, MemT> make_sensor_view(
+    const MemoryView<DataT, MemT>& mem,
+    const ModelT& model)
+{
+    const size_t N = mem.size() / model.size();
+    return TensorView<const DataT, 3, MemT>(mem, {N, model.getHeight(), model.getWidth()});
+}
+
+//// COPY
+namespace detail
+{
+
+template<typename TensorT>
+inline size_t tensor_row_offset(const TensorT& T, size_t row)
+{
+    // offset of the first element of a row (last dimension)
+    size_t off = 0;
+    for(int d = static_cast<int>(TensorT::dims()) - 2; d >= 0; d--)
+    {
+        off += (row % T.shape(d)) * T.stride(d);
+        row /= T.shape(d);
+    }
+    return off;
+}
+
+} // namespace detail
+
+template<typename SrcDataT, typename DataT, unsigned int Dim>
+void copy(
+    const TensorView<SrcDataT, Dim, RAM>& from,
+    TensorView<DataT, Dim, RAM>& to)
+{
+    static_assert(std::is_same<typename std::remove_const<SrcDataT>::type, DataT>::value,
+        "TensorView copy: data types differ");
+
+    for(unsigned int d=0; d<Dim; d++)
+    {
+        if(from.shape(d) != to.shape(d))
+        {
+            throw std::runtime_error("TensorView copy: shapes differ");
+        }
+    }
+
+    const size_t N = from.size();
+    if(N == 0)
+    {
+        return;
+    }
+
+    if(from.isContiguous() && to.isContiguous())
+    {
+        std::memcpy(to.raw(), from.raw(), sizeof(DataT) * N);
+        return;
+    }
+
+    const size_t W = from.shape(Dim - 1);
+    const size_t Nrows = N / W;
+    const size_t stride_from = from.stride(Dim - 1);
+    const size_t stride_to = to.stride(Dim - 1);
+
+    const SrcDataT* src_base = from.raw();
+    DataT* dst_base = to.raw();
+
+    #pragma omp parallel for if(N > 4096)
+    for(size_t row = 0; row < Nrows; row++)
+    {
+        const SrcDataT* src = src_base + detail::tensor_row_offset(from, row);
+        DataT* dst = dst_base + detail::tensor_row_offset(to, row);
+
+        if(stride_from == 1 && stride_to == 1)
+        {
+            std::memcpy(dst, src, sizeof(DataT) * W);
+        } else {
+            #pragma omp simd
+            for(size_t i = 0; i < W; i++)
+            {
+                dst[i * stride_to] = src[i * stride_from];
+            }
+        }
+    }
+}
+
+template<typename SrcDataT, typename DataT, unsigned int Dim>
+void copy(
+    const TensorView<SrcDataT, Dim, RAM>& from,
+    MemoryView<DataT, RAM>& to)
+{
+    TensorView<DataT, Dim, RAM> to_tensor(to, from.shape());
+    copy(from, to_tensor);
+}
+
+} // namespace rmagine
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief Compile-time ray tables of sensor models
+ * 
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_TYPES_RAY_TABLE_H
+#define RMAGINE_TYPES_RAY_TABLE_H
+
+#include <rmagine/types/sensor_models.h>
+#include <rmagine/math/constexpr_math.h>
+#include <rmagine/util/exceptions.h>
+
+namespace rmagine
+{
+
+/**
+ * @brief Precomputed rays of a sensor with a fixed resolution. 
+ * 
+ * Same interface as O1DnModel, but without buffers: it can be built in a 
+ * constant expression with a fixed mounting transform baked in. 
+ * Tables are large, store them as static constexpr instead of on the stack:
+ * 
+ * @code
+ * static constexpr auto table = makeRayTable<16, 900>(vlp16_900(), Tsb);
+ * @endcode
+ */
+template<uint32_t Height, uint32_t Width>
+struct RayTable
+{
+    static constexpr char name[] = "RayTable";
+
+    // maximum and minimum allowed range
+    Interval range;
+
+    Vector orig;
+    Vector dirs[Height * Width];
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    uint32_t getWidth() const 
+    {
+        return Width;
+    }
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    uint32_t getHeight() const 
+    {
+        return Height;
+    }
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    uint32_t size() const 
+    {
+        return Width * Height;
+    }
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    uint32_t getBufferId(uint32_t vid, uint32_t hid) const 
+    {
+        return vid * Width + hid;
+    }
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    Vector getOrigin(uint32_t vid, uint32_t hid) const 
+    {
+        return orig;
+    }
+
+    RMAGINE_CONSTEXPR_FUNCTION
+    Vector getDirection(uint32_t vid, uint32_t hid) const 
+    {
+        return dirs[getBufferId(vid, hid)];
+    }
+};
+
+/**
+ * @brief Rays of a SphericalModel, transformed by a fixed transform Tsb
+ * 
+ * Height and Width have to match the model
+ */
+template<uint32_t Height, uint32_t Width>
+RMAGINE_CONSTEXPR_FUNCTION
+RayTable<Height, Width> makeRayTable(
+    const SphericalModel& model,
+    const Transform& Tsb = Transform::Identity())
+{
+    if(model.getHeight() != Height || model.getWidth() != Width)
+    {
+        RM_THROW(Exception, "makeRayTable: resolution of model does not match the table.");
+    }
+
+    // one sin/cos per row and per column
+    double cos_phi[Height] = {};
+    double sin_phi[Height] = {};
+    for(uint32_t vid=0; vid<Height; vid++)
+    {
+        const double phi = model.getPhi(vid);
+        cos_phi[vid] = cx::cos(phi);
+        sin_phi[vid] = cx::sin(phi);
+    }
+
+    double cos_theta[Width] = {};
+    double sin_theta[Width] = {};
+    for(uint32_t hid=0; hid<Width; hid++)
+    {
+        const double theta = model.getTheta(hid);
+        cos_theta[hid] = cx::cos(theta);
+        sin_theta[hid] = cx::sin(theta);
+    }
+
+    RayTable<Height, Width> table{};
+    table.range = model.range;
+    table.orig = Tsb.t;
+    for(uint32_t vid=0; vid<Height; vid++)
+    {
+        for(uint32_t hid=0; hid<Width; hid++)
+        {
+            const Vector dir{
+                static_cast<float>(cos_phi[vid] * cos_theta[hid]),
+                static_cast<float>(cos_phi[vid] * sin_theta[hid]),
+                static_cast<float>(sin_phi[vid])};
+            table.dirs[table.getBufferId(vid, hid)] = Tsb.R * dir;
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief Rays of a PinholeModel, transformed by a fixed transform Tsb
+ * 
+ * Height and Width have to match the model
+ */
+template<uint32_t Height, uint32_t Width>
+RMAGINE_CONSTEXPR_FUNCTION
+RayTable<Height, Width> makeRayTable(
+    const PinholeModel& model,
+    const Transform& Tsb = Transform::Identity())
+{
+    if(model.getHeight() != Height || model.getWidth() != Width)
+    {
+        RM_THROW(Exception, "makeRayTable: resolution of model does not match the table.");
+    }
+
+    RayTable<Height, Width> table{};
+    table.range = model.range;
+    table.orig = Tsb.t;
+    for(uint32_t vid=0; vid<Height; vid++)
+    {
+        for(uint32_t hid=0; hid<Width; hid++)
+        {
+            // see PinholeModel::getDirection
+            const double pX = (static_cast<double>(hid) - model.c[0]) / model.f[0];
+            const double pY = (static_cast<double>(vid) - model.c[1]) / model.f[1];
+            const double n = cx::sqrt(pX * pX + pY * pY + 1.0);
+            const Vector dir{
+                static_cast<float>(1.0 / n), 
+                static_cast<float>(-pX / n), 
+                static_cast<float>(-pY / n)};
+            table.dirs[table.getBufferId(vid, hid)] = Tsb.R * dir;
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief Copy a table to a O1DnModel, e.g. to use it with the simulators
+ */
+template<uint32_t Height, uint32_t Width>
+O1DnModel toO1DnModel(const RayTable<Height, Width>& table)
+{
+    O1DnModel model;
+    model.width = Width;
+    model.height = Height;
+    model.range = table.range;
+    model.orig = table.orig;
+    model.dirs.resize(table.size());
+    for(uint32_t i=0; i<table.size(); i++)
+    {
+        model.dirs[i] = table.dirs[i];
+    }
+    return model;
+}
+
+} // namespace rmagine
+
+#endif // RMAGINE_TYPES_RAY_TABLE_H
@@ -56,13 +56,13 @@ struct Interval {
     float min;
     float max;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     float invalidValue() const
     {
         return max + 1.0;
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     bool inside(const float& value) const 
     {
         return (value >= min && value <= max);
@@ -78,31 +78,32 @@ struct DiscreteInterval
     // total number of discrete values in this interval
     uint32_t size;
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     float max() const
     {
         // return value at last array entry
         return min + static_cast<float>(size - 1) * inc;
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     float getValue(uint32_t id) const
     {
         return min + static_cast<float>(id) * inc;
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     float operator[](uint32_t id) const 
     {
         return getValue(id);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     bool inside(const float& value) const 
     {
         return (value >= min && value <= max());
     }
 
+    RMAGINE_CONSTEXPR_FUNCTION
     static float IncFromMinMaxSize(float min, float max, uint32_t size)
     {
         return (max - min) / ( static_cast<float>(size - 1) );
@@ -130,31 +131,31 @@ struct SphericalModel
     // RANGE: range
     Interval range; // range is valid if <= range_max && >= range_min
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     uint32_t getWidth() const
     {
         return theta.size;
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     uint32_t getHeight() const
     {
         return phi.size;
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     uint32_t size() const
     {
         return getWidth() * getHeight();
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     float getPhi(uint32_t phi_id) const
     {
         return phi.getValue(phi_id);
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     float getTheta(uint32_t theta_id) const
     {
         return theta.getValue(theta_id);
@@ -168,13 +169,13 @@ struct SphericalModel
         return {cosf(phi_) * cosf(theta_), cosf(phi_) * sinf(theta_), sinf(phi_)};
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector getOrigin(uint32_t phi_id, uint32_t theta_id) const 
     {
         return {0.0, 0.0, 0.0};
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     uint32_t getBufferId(uint32_t phi_id, uint32_t theta_id) const 
     {
         return phi_id * theta.size + theta_id;
@@ -197,19 +198,19 @@ struct PinholeModel {
     // Center cx and cy
     float c[2];
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     uint32_t getWidth() const
     {
         return width;
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     uint32_t getHeight() const
     {
         return height;
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     uint32_t size() const
     {
         return getWidth() * getHeight();
@@ -238,13 +239,13 @@ struct PinholeModel {
         return {dir_optical.z, -dir_optical.x, -dir_optical.y};
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     Vector getOrigin(uint32_t phi_id, uint32_t theta_id) const 
     {
         return {0.0, 0.0, 0.0};
     }
 
-    RMAGINE_INLINE_FUNCTION
+    RMAGINE_CONSTEXPR_FUNCTION
     uint32_t getBufferId(uint32_t vid, uint32_t hid) const 
     {
         return vid * width + hid;
@@ -44,9 +44,12 @@
 #ifdef __CUDA_ARCH__
 #define RMAGINE_FUNCTION __host__ __device__
 #define RMAGINE_INLINE_FUNCTION __inline__ __host__ __device__ 
+#define RMAGINE_CONSTEXPR_FUNCTION constexpr __host__ __device__
 #else
 #define RMAGINE_FUNCTION
 #define RMAGINE_INLINE_FUNCTION inline
+// usable in constant expressions (implies inline)
+#define RMAGINE_CONSTEXPR_FUNCTION constexpr
 #endif
 
 #endif // RMAGINE_TYPES_SHARED_FUNCTIONS_H
\ No newline at end of file
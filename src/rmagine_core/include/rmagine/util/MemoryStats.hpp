@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief Opt-in bookkeeping of Memory allocations per memory type and tag
+ * 
+ * Every allocation, reallocation and free of a Memory object is recorded 
+ * when enabled, either by calling MemoryStats::enable() or by setting the
+ * environment variable RMAGINE_MEMORY_STATS=1. Allocations can be attributed
+ * to call sites by tagging them:
+ * 
+ * @code
+ * MemoryStats::enable();
+ * {
+ *     MemoryStatsTag tag("sim_loop");
+ *     auto ranges = sim->simulateRanges(Tbm);
+ * }
+ * MemoryStats::report();
+ * @endcode
+ *
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_UTIL_MEMORY_STATS_HPP
+#define RMAGINE_UTIL_MEMORY_STATS_HPP
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <iostream>
+
+namespace rmagine
+{
+
+struct MemoryStatsEntry
+{
+    // bytes currently allocated
+    size_t live_bytes = 0;
+    // maximum of live_bytes
+    size_t peak_bytes = 0;
+    size_t allocs = 0;
+    size_t reallocs = 0;
+    size_t frees = 0;
+};
+
+class MemoryStats
+{
+public:
+    /**
+     * @brief Start recording
+     * 
+     * @param report_on_exit print report() to std::cout at program exit
+     */
+    static void enable(bool report_on_exit = true);
+
+    static void disable();
+
+    static inline bool enabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Clear all recorded statistics. Live allocations are forgotten
+     */
+    static void reset();
+
+    // called by Memory
+    static void onAlloc(const char* mem_type, const void* ptr, size_t bytes);
+    static void onRealloc(const char* mem_type, const void* ptr_old, const void* ptr_new, size_t bytes);
+    static void onFree(const char* mem_type, const void* ptr);
+
+    /**
+     * @brief Statistics of all allocations of one memory type, e.g. "RAM" or "VRAM_CUDA"
+     */
+    static MemoryStatsEntry get(const std::string& mem_type);
+
+    /**
+     * @brief Statistics of allocations of one memory type done while tag was active
+     */
+    static MemoryStatsEntry get(const std::string& mem_type, const std::string& tag);
+
+    /**
+     * @brief memory type -> statistics
+     */
+    static std::map<std::string, MemoryStatsEntry> byMemType();
+
+    /**
+     * @brief (memory type, tag) -> statistics. Untagged allocations have an empty tag
+     */
+    static std::map<std::pair<std::string, std::string>, MemoryStatsEntry> byTag();
+
+    static void report(std::ostream& os = std::cout);
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+/**
+ * @brief Attributes all allocations of the current thread to a tag until 
+ * the object goes out of scope. Tags can be nested, the innermost one is used
+ */
+class MemoryStatsTag
+{
+public:
+    MemoryStatsTag(const std::string& tag);
+    ~MemoryStatsTag();
+
+    MemoryStatsTag(const MemoryStatsTag&) = delete;
+    MemoryStatsTag& operator=(const MemoryStatsTag&) = delete;
+
+    /**
+     * @brief innermost active tag of the calling thread. empty if none
+     */
+    static const std::string& current();
+
+private:
+    std::string m_tag_before;
+};
+
+} // namespace rmagine
+
+#endif // RMAGINE_UTIL_MEMORY_STATS_HPP
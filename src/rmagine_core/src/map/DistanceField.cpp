@@ -0,0 +1,341 @@
+#include "rmagine/map/DistanceField.hpp"
+#include "rmagine/util/exceptions.h"
+
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <algorithm>
+
+namespace rmagine
+{
+
+namespace 
+{
+
+// 21 bits per axis
+constexpr int64_t KEY_BIAS = 1 << 20;
+constexpr uint64_t KEY_MASK = (1ull << 21) - 1;
+
+constexpr char FILE_MAGIC[4] = {'R', 'M', 'D', 'F'};
+constexpr uint32_t FILE_VERSION = 1;
+
+inline int32_t floor_div(int32_t a, int32_t b)
+{
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+inline uint64_t pack_key(int32_t bx, int32_t by, int32_t bz)
+{
+    return  ((static_cast<uint64_t>(bx + KEY_BIAS) & KEY_MASK))
+          | ((static_cast<uint64_t>(by + KEY_BIAS) & KEY_MASK) << 21)
+          | ((static_cast<uint64_t>(bz + KEY_BIAS) & KEY_MASK) << 42);
+}
+
+inline void unpack_key(uint64_t key, int32_t& bx, int32_t& by, int32_t& bz)
+{
+    bx = static_cast<int32_t>(static_cast<int64_t>(key & KEY_MASK) - KEY_BIAS);
+    by = static_cast<int32_t>(static_cast<int64_t>((key >> 21) & KEY_MASK) - KEY_BIAS);
+    bz = static_cast<int32_t>(static_cast<int64_t>((key >> 42) & KEY_MASK) - KEY_BIAS);
+}
+
+constexpr size_t SY = DistanceField::BLOCK_SAMPLES;
+constexpr size_t SZ = DistanceField::BLOCK_SAMPLES * DistanceField::BLOCK_SAMPLES;
+
+} // anonymous namespace
+
+DistanceField::DistanceField(
+    float voxel_size, 
+    float band, 
+    bool is_signed)
+:m_voxel_size(voxel_size)
+,m_band(band)
+,m_signed(is_signed)
+{
+    if(!(voxel_size > 0.0))
+    {
+        RM_THROW(Exception, "DistanceField: voxel size has to be positive.");
+    }
+}
+
+uint64_t DistanceField::blockKeyOfCell(int32_t i, int32_t j, int32_t k)
+{
+    return pack_key(
+        floor_div(i, BLOCK_SIZE), 
+        floor_div(j, BLOCK_SIZE), 
+        floor_div(k, BLOCK_SIZE));
+}
+
+uint64_t DistanceField::blockKey(const Point& p) const
+{
+    return blockKeyOfCell(
+        static_cast<int32_t>(std::floor(p.x / m_voxel_size)),
+        static_cast<int32_t>(std::floor(p.y / m_voxel_size)),
+        static_cast<int32_t>(std::floor(p.z / m_voxel_size)));
+}
+
+void DistanceField::setBlocks(const std::vector<uint64_t>& keys)
+{
+    m_keys = keys;
+    std::sort(m_keys.begin(), m_keys.end());
+    m_keys.erase(std::unique(m_keys.begin(), m_keys.end()), m_keys.end());
+
+    m_block_ids.clear();
+    m_block_ids.reserve(m_keys.size());
+    for(size_t i=0; i<m_keys.size(); i++)
+    {
+        m_block_ids[m_keys[i]] = static_cast<uint32_t>(i);
+    }
+
+    m_samples.resize(m_keys.size() * BLOCK_VOLUME);
+    float* samples = m_samples.raw();
+    const float band = m_band;
+    #pragma omp parallel for
+    for(size_t i=0; i<m_samples.size(); i++)
+    {
+        samples[i] = band;
+    }
+}
+
+Point DistanceField::blockOrigin(size_t block_id) const
+{
+    int32_t bx, by, bz;
+    unpack_key(m_keys[block_id], bx, by, bz);
+    const float block_extent = m_voxel_size * static_cast<float>(BLOCK_SIZE);
+    return {
+        static_cast<float>(bx) * block_extent,
+        static_cast<float>(by) * block_extent,
+        static_cast<float>(bz) * block_extent
+    };
+}
+
+const float* DistanceField::findCell(
+    const Point& p, 
+    float& fx, float& fy, float& fz) const
+{
+    const float gx = p.x / m_voxel_size;
+    const float gy = p.y / m_voxel_size;
+    const float gz = p.z / m_voxel_size;
+
+    const float cx = std::floor(gx);
+    const float cy = std::floor(gy);
+    const float cz = std::floor(gz);
+
+    fx = gx - cx;
+    fy = gy - cy;
+    fz = gz - cz;
+
+    const int32_t i = static_cast<int32_t>(cx);
+    const int32_t j = static_cast<int32_t>(cy);
+    const int32_t k = static_cast<int32_t>(cz);
+
+    const int32_t bx = floor_div(i, BLOCK_SIZE);
+    const int32_t by = floor_div(j, BLOCK_SIZE);
+    const int32_t bz = floor_div(k, BLOCK_SIZE);
+
+    auto it = m_block_ids.find(pack_key(bx, by, bz));
+    if(it == m_block_ids.end())
+    {
+        return nullptr;
+    }
+
+    const size_t li = i - bx * BLOCK_SIZE;
+    const size_t lj = j - by * BLOCK_SIZE;
+    const size_t lk = k - bz * BLOCK_SIZE;
+    return blockSamples(it->second) + li + SY * lj + SZ * lk;
+}
+
+bool DistanceField::distance(const Point& p, float& d) const
+{
+    float fx, fy, fz;
+    const float* c = findCell(p, fx, fy, fz);
+    if(!c)
+    {
+        return false;
+    }
+
+    // interpolate along x, then y, then z
+    const float c00 = c[0]       + (c[1] - c[0]) * fx;
+    const float c10 = c[SY]      + (c[SY + 1] - c[SY]) * fx;
+    const float c01 = c[SZ]      + (c[SZ + 1] - c[SZ]) * fx;
+    const float c11 = c[SZ + SY] + (c[SZ + SY + 1] - c[SZ + SY]) * fx;
+
+    const float c0 = c00 + (c10 - c00) * fy;
+    const float c1 = c01 + (c11 - c01) * fy;
+
+    d = c0 + (c1 - c0) * fz;
+    return true;
+}
+
+bool DistanceField::distance(const Point& p, float& d, Vector& grad) const
+{
+    float fx, fy, fz;
+    const float* c = findCell(p, fx, fy, fz);
+    if(!c)
+    {
+        return false;
+    }
+
+    const float c000 = c[0],       c100 = c[1];
+    const float c010 = c[SY],      c110 = c[SY + 1];
+    const float c001 = c[SZ],      c101 = c[SZ + 1];
+    const float c011 = c[SZ + SY], c111 = c[SZ + SY + 1];
+
+    const float c00 = c000 + (c100 - c000) * fx;
+    const float c10 = c010 + (c110 - c010) * fx;
+    const float c01 = c001 + (c101 - c001) * fx;
+    const float c11 = c011 + (c111 - c011) * fx;
+
+    const float c0 = c00 + (c10 - c00) * fy;
+    const float c1 = c01 + (c11 - c01) * fy;
+
+    d = c0 + (c1 - c0) * fz;
+
+    // analytic derivatives of the trilinear interpolation
+    const float dx00 = c100 - c000;
+    const float dx10 = c110 - c010;
+    const float dx01 = c101 - c001;
+    const float dx11 = c111 - c011;
+    const float dx0 = dx00 + (dx10 - dx00) * fy;
+    const float dx1 = dx01 + (dx11 - dx01) * fy;
+
+    const float inv_voxel_size = 1.0f / m_voxel_size;
+    grad.x = (dx0 + (dx1 - dx0) * fz) * inv_voxel_size;
+    grad.y = ((c10 - c00) + ((c11 - c01) - (c10 - c00)) * fz) * inv_voxel_size;
+    grad.z = (c1 - c0) * inv_voxel_size;
+    return true;
+}
+
+void DistanceField::distances(
+    const MemoryView<Point, RAM>& ps,
+    MemoryView<float, RAM>& ds) const
+{
+    if(ds.size() != ps.size())
+    {
+        RM_THROW(Exception, "DistanceField::distances: sizes differ.");
+    }
+
+    #pragma omp parallel for
+    for(size_t i=0; i<ps.size(); i++)
+    {
+        float d;
+        ds[i] = distance(ps[i], d) ? d : std::numeric_limits<float>::quiet_NaN();
+    }
+}
+
+Memory<float, RAM> DistanceField::distances(
+    const MemoryView<Point, RAM>& ps) const
+{
+    Memory<float, RAM> ds(ps.size());
+    distances(ps, ds);
+    return ds;
+}
+
+void DistanceField::distances(
+    const MemoryView<Point, RAM>& ps,
+    MemoryView<float, RAM>& ds,
+    MemoryView<Vector, RAM>& grads) const
+{
+    if(ds.size() != ps.size() || grads.size() != ps.size())
+    {
+        RM_THROW(Exception, "DistanceField::distances: sizes differ.");
+    }
+
+    #pragma omp parallel for
+    for(size_t i=0; i<ps.size(); i++)
+    {
+        float d;
+        Vector grad;
+        if(distance(ps[i], d, grad))
+        {
+            ds[i] = d;
+            grads[i] = grad;
+        } else {
+            ds[i] = std::numeric_limits<float>::quiet_NaN();
+            grads[i] = Vector::NaN();
+        }
+    }
+}
+
+void DistanceField::save(const std::string& filename) const
+{
+    std::ofstream file(filename, std::ios::binary);
+    if(!file)
+    {
+        RM_THROW(Exception, "DistanceField::save: cannot open '" + filename + "'.");
+    }
+
+    const uint8_t is_signed = m_signed;
+    const uint64_t num_blocks = m_keys.size();
+
+    file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    file.write(reinterpret_cast<const char*>(&FILE_VERSION), sizeof(FILE_VERSION));
+    file.write(reinterpret_cast<const char*>(&m_voxel_size), sizeof(m_voxel_size));
+    file.write(reinterpret_cast<const char*>(&m_band), sizeof(m_band));
+    file.write(reinterpret_cast<const char*>(&is_signed), sizeof(is_signed));
+    file.write(reinterpret_cast<const char*>(&num_blocks), sizeof(num_blocks));
+    file.write(reinterpret_cast<const char*>(m_keys.data()), sizeof(uint64_t) * num_blocks);
+    file.write(reinterpret_cast<const char*>(m_samples.raw()), sizeof(float) * m_samples.size());
+
+    if(!file)
+    {
+        RM_THROW(Exception, "DistanceField::save: writing '" + filename + "' failed.");
+    }
+}
+
+DistanceField DistanceField::load(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if(!file)
+    {
+        RM_THROW(Exception, "DistanceField::load: cannot open '" + filename + "'.");
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    float voxel_size = 0.0;
+    float band = 0.0;
+    uint8_t is_signed = 0;
+    uint64_t num_blocks = 0;
+
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if(!file || !std::equal(magic, magic + 4, FILE_MAGIC) || version != FILE_VERSION)
+    {
+        RM_THROW(Exception, "DistanceField::load: '" + filename + "' is no distance field of version " + std::to_string(FILE_VERSION) + ".");
+    }
+
+    file.read(reinterpret_cast<char*>(&voxel_size), sizeof(voxel_size));
+    file.read(reinterpret_cast<char*>(&band), sizeof(band));
+    file.read(reinterpret_cast<char*>(&is_signed), sizeof(is_signed));
+    file.read(reinterpret_cast<char*>(&num_blocks), sizeof(num_blocks));
+    if(!file)
+    {
+        RM_THROW(Exception, "DistanceField::load: '" + filename + "' is truncated.");
+    }
+
+    // bound num_blocks by the file size before allocating
+    const std::streampos data_begin = file.tellg();
+    file.seekg(0, std::ios::end);
+    const uint64_t data_bytes = static_cast<uint64_t>(file.tellg() - data_begin);
+    file.seekg(data_begin);
+    const uint64_t block_bytes = sizeof(uint64_t) + sizeof(float) * BLOCK_VOLUME;
+    if(!file || num_blocks > data_bytes / block_bytes)
+    {
+        RM_THROW(Exception, "DistanceField::load: '" + filename + "' is truncated.");
+    }
+
+    DistanceField df(voxel_size, band, is_signed);
+    std::vector<uint64_t> keys(num_blocks);
+    file.read(reinterpret_cast<char*>(keys.data()), sizeof(uint64_t) * num_blocks);
+    df.setBlocks(keys);
+    file.read(reinterpret_cast<char*>(df.m_samples.raw()), sizeof(float) * df.m_samples.size());
+
+    if(!file)
+    {
+        RM_THROW(Exception, "DistanceField::load: '" + filename + "' is truncated.");
+    }
+
+    return df;
+}
+
+} // namespace rmagine
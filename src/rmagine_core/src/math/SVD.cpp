@@ -1,10 +1,431 @@
 #include "rmagine/math/SVD.hpp"
 #include "rmagine/types/Memory.hpp"
 #include <assert.h>
-#include <Eigen/Dense>
+#include <cmath>
+#include <algorithm>
 
 namespace rmagine {
 
+// Branch free 3x3 SVD
+// A. McAdams, A. Selle, R. Tamstorf, J. Teran, E. Sifakis: 
+// "Computing the Singular Value Decomposition of 3x3 matrices 
+//  with minimal branching and elementary floating point operations", 2011
+//
+// - symmetric eigenanalysis of A^T A with a fixed number of Jacobi sweeps.
+//   Rotations are approximate Givens rotations accumulated as quaternion
+// - B = A V, columns sorted by norm
+// - QR decomposition of B with Givens rotations: U = Q, S = diag(R)
+//
+// Every condition is expressed as select, so that the compiler can 
+// vectorize the kernel over multiple matrices.
+// U and V are rotations. The smallest singular value carries the sign of det(A)
+namespace svd3
+{
+
+// the kernel must be inlined into the vectorized lane loop
+#if defined(__GNUC__)
+#define SVD3_INLINE inline __attribute__((always_inline))
+#else
+#define SVD3_INLINE inline
+#endif
+
+static constexpr float GAMMA = 5.828427124f; // 3 + sqrt(8)
+static constexpr float CSTAR = 0.923879532f; // cos(pi/8)
+static constexpr float SSTAR = 0.3826834323f; // sin(pi/8)
+static constexpr float EPSILON = 1e-6f;
+// smallest argument of rsqrt()
+static constexpr float RSQRT_MIN = 1e-30f;
+static constexpr int SWEEPS = 5;
+
+static SVD3_INLINE float rsqrt(float x)
+{
+    return 1.0f / std::sqrt(x);
+}
+
+// c ? a : b as arithmetic blend. Keeps the compiler from 
+// turning selects into branches, which would prevent vectorization
+static SVD3_INLINE float select(bool c, float a, float b)
+{
+    const float w = static_cast<float>(c);
+    return w * a + (1.0f - w) * b;
+}
+
+static SVD3_INLINE void cond_swap(bool c, float& X, float& Y)
+{
+    const float Z = X;
+    X = select(c, Y, X);
+    Y = select(c, Z, Y);
+}
+
+static SVD3_INLINE void cond_neg_swap(bool c, float& X, float& Y)
+{
+    const float Z = -X;
+    X = select(c, Y, X);
+    Y = select(c, Z, Y);
+}
+
+static SVD3_INLINE void approx_givens_quaternion(
+    float a11, float a12, float a22, 
+    float& ch, float& sh)
+{
+    ch = 2.0f * (a11 - a22);
+    sh = a12;
+    const bool b = GAMMA * sh * sh < ch * ch;
+    // clamped: ch = sh = 0 for diagonal blocks. inf * 0 in select() would be NaN
+    const float w = rsqrt(std::max(ch * ch + sh * sh, RSQRT_MIN));
+    ch = select(b, w * ch, CSTAR);
+    sh = select(b, w * sh, SSTAR);
+}
+
+// (x,y,z) = (0,1,2), (1,2,0), (2,0,1) for (p,q) = (0,1), (1,2), (0,2)
+template<int x, int y, int z>
+static SVD3_INLINE void jacobi_conjugation(
+    float& s11,
+    float& s21, float& s22,
+    float& s31, float& s32, float& s33,
+    float* qV)
+{
+    float ch, sh;
+    approx_givens_quaternion(s11, s21, s22, ch, sh);
+
+    const float scale = ch * ch + sh * sh;
+    const float a = (ch * ch - sh * sh) / scale;
+    const float b = (2.0f * sh * ch) / scale;
+
+    const float t11 = s11;
+    const float t21 = s21, t22 = s22;
+    const float t31 = s31, t32 = s32, t33 = s33;
+
+    // S = Q^T S Q
+    s11 =  a * ( a * t11 + b * t21) + b * ( a * t21 + b * t22);
+    s21 =  a * (-b * t11 + a * t21) + b * (-b * t21 + a * t22);
+    s22 = -b * (-b * t11 + a * t21) + a * (-b * t21 + a * t22);
+    s31 =  a * t31 + b * t32;
+    s32 = -b * t31 + a * t32;
+    s33 =  t33;
+
+    // accumulate rotation
+    float tmp[3] = {qV[0] * sh, qV[1] * sh, qV[2] * sh};
+    sh *= qV[3];
+
+    qV[0] *= ch;
+    qV[1] *= ch;
+    qV[2] *= ch;
+    qV[3] *= ch;
+
+    qV[z] += sh;
+    qV[3] -= tmp[z];
+    qV[x] += tmp[y];
+    qV[y] -= tmp[x];
+
+    // cycle the matrix for the next (p,q)
+    const float n11 = s22;
+    const float n21 = s32, n22 = s33;
+    const float n31 = s21, n32 = s31, n33 = s11;
+    s11 = n11;
+    s21 = n21; s22 = n22;
+    s31 = n31; s32 = n32; s33 = n33;
+}
+
+// fixed number of Jacobi sweeps. unrolled at compile time
+template<int N>
+static SVD3_INLINE void sweep(
+    float& s11,
+    float& s21, float& s22,
+    float& s31, float& s32, float& s33,
+    float* qV)
+{
+    if constexpr(N > 0)
+    {
+        jacobi_conjugation<0, 1, 2>(s11, s21, s22, s31, s32, s33, qV);
+        jacobi_conjugation<1, 2, 0>(s11, s21, s22, s31, s32, s33, qV);
+        jacobi_conjugation<2, 0, 1>(s11, s21, s22, s31, s32, s33, qV);
+        sweep<N - 1>(s11, s21, s22, s31, s32, s33, qV);
+    }
+}
+
+static SVD3_INLINE void qr_givens_quaternion(float a1, float a2, float& ch, float& sh)
+{
+    // a1: pivot on diagonal, a2: lower triangular entry to annihilate
+    const float rho = std::sqrt(a1 * a1 + a2 * a2);
+    sh = select(rho > EPSILON, a2, 0.0f);
+    ch = std::fabs(a1) + std::fmax(rho, EPSILON);
+    const bool b = a1 < 0.0f;
+    cond_swap(b, sh, ch);
+    const float w = rsqrt(std::max(ch * ch + sh * sh, RSQRT_MIN));
+    ch *= w;
+    sh *= w;
+}
+
+/**
+ * @brief A = U * diag(s) * V^T
+ * 
+ * Inputs and outputs are row-wise named scalars: aij = A(i-1, j-1)
+ */
+static SVD3_INLINE void kernel(
+    float a11, float a12, float a13,
+    float a21, float a22, float a23,
+    float a31, float a32, float a33,
+    float& u11, float& u12, float& u13,
+    float& u21, float& u22, float& u23,
+    float& u31, float& u32, float& u33,
+    float& s1, float& s2, float& s3,
+    float& v11, float& v12, float& v13,
+    float& v21, float& v22, float& v23,
+    float& v31, float& v32, float& v33)
+{
+    // normal equations. symmetric: only lower triangle
+    float S11 = a11 * a11 + a21 * a21 + a31 * a31;
+    float S21 = a12 * a11 + a22 * a21 + a32 * a31;
+    float S22 = a12 * a12 + a22 * a22 + a32 * a32;
+    float S31 = a13 * a11 + a23 * a21 + a33 * a31;
+    float S32 = a13 * a12 + a23 * a22 + a33 * a32;
+    float S33 = a13 * a13 + a23 * a23 + a33 * a33;
+
+    // symmetric eigenanalysis
+    float qV[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+    sweep<SWEEPS>(S11, S21, S22, S31, S32, S33, qV);
+
+    // quaternion -> V
+    {
+        const float x = qV[0], y = qV[1], z = qV[2], w = qV[3];
+        const float qxx = x * x, qyy = y * y, qzz = z * z;
+        const float qxz = x * z, qxy = x * y, qyz = y * z;
+        const float qwx = w * x, qwy = w * y, qwz = w * z;
+
+        v11 = 1.0f - 2.0f * (qyy + qzz); v12 = 2.0f * (qxy - qwz);        v13 = 2.0f * (qxz + qwy);
+        v21 = 2.0f * (qxy + qwz);        v22 = 1.0f - 2.0f * (qxx + qzz); v23 = 2.0f * (qyz - qwx);
+        v31 = 2.0f * (qxz - qwy);        v32 = 2.0f * (qyz + qwx);        v33 = 1.0f - 2.0f * (qxx + qyy);
+    }
+
+    // B = A * V
+    float b11 = a11 * v11 + a12 * v21 + a13 * v31;
+    float b12 = a11 * v12 + a12 * v22 + a13 * v32;
+    float b13 = a11 * v13 + a12 * v23 + a13 * v33;
+    float b21 = a21 * v11 + a22 * v21 + a23 * v31;
+    float b22 = a21 * v12 + a22 * v22 + a23 * v32;
+    float b23 = a21 * v13 + a22 * v23 + a23 * v33;
+    float b31 = a31 * v11 + a32 * v21 + a33 * v31;
+    float b32 = a31 * v12 + a32 * v22 + a33 * v32;
+    float b33 = a31 * v13 + a32 * v23 + a33 * v33;
+
+    // sort columns by norm. negate one column per swap to keep det(V) = 1
+    {
+        float rho1 = b11 * b11 + b21 * b21 + b31 * b31;
+        float rho2 = b12 * b12 + b22 * b22 + b32 * b32;
+        float rho3 = b13 * b13 + b23 * b23 + b33 * b33;
+
+        bool c = rho1 < rho2;
+        cond_neg_swap(c, b11, b12); cond_neg_swap(c, v11, v12);
+        cond_neg_swap(c, b21, b22); cond_neg_swap(c, v21, v22);
+        cond_neg_swap(c, b31, b32); cond_neg_swap(c, v31, v32);
+        cond_swap(c, rho1, rho2);
+
+        c = rho1 < rho3;
+        cond_neg_swap(c, b11, b13); cond_neg_swap(c, v11, v13);
+        cond_neg_swap(c, b21, b23); cond_neg_swap(c, v21, v23);
+        cond_neg_swap(c, b31, b33); cond_neg_swap(c, v31, v33);
+        cond_swap(c, rho1, rho3);
+
+        c = rho2 < rho3;
+        cond_neg_swap(c, b12, b13); cond_neg_swap(c, v12, v13);
+        cond_neg_swap(c, b22, b23); cond_neg_swap(c, v22, v23);
+        cond_neg_swap(c, b32, b33); cond_neg_swap(c, v32, v33);
+    }
+
+    // QR decomposition of B
+    float ch1, sh1, ch2, sh2, ch3, sh3;
+    float a, b;
+    float r11, r12, r13, r21, r22, r23, r31, r32, r33;
+
+    // first givens rotation (ch,0,0,sh)
+    qr_givens_quaternion(b11, b21, ch1, sh1);
+    a = 1.0f - 2.0f * sh1 * sh1;
+    b = 2.0f * ch1 * sh1;
+    r11 =  a * b11 + b * b21; r12 =  a * b12 + b * b22; r13 =  a * b13 + b * b23;
+    r21 = -b * b11 + a * b21; r22 = -b * b12 + a * b22; r23 = -b * b13 + a * b23;
+    r31 = b31;                r32 = b32;                r33 = b33;
+
+    // second givens rotation (ch,0,-sh,0)
+    qr_givens_quaternion(r11, r31, ch2, sh2);
+    a = 1.0f - 2.0f * sh2 * sh2;
+    b = 2.0f * ch2 * sh2;
+    b11 =  a * r11 + b * r31; b12 =  a * r12 + b * r32; b13 =  a * r13 + b * r33;
+    b21 = r21;                b22 = r22;                b23 = r23;
+    b31 = -b * r11 + a * r31; b32 = -b * r12 + a * r32; b33 = -b * r13 + a * r33;
+
+    // third givens rotation (ch,sh,0,0)
+    qr_givens_quaternion(b22, b32, ch3, sh3);
+    a = 1.0f - 2.0f * sh3 * sh3;
+    b = 2.0f * ch3 * sh3;
+    s1 = b11;
+    s2 = a * b22 + b * b32;
+    s3 = -b * b23 + a * b33;
+
+    // U = Q1 * Q2 * Q3
+    const float sh12 = sh1 * sh1;
+    const float sh22 = sh2 * sh2;
+    const float sh32 = sh3 * sh3;
+
+    u11 = (-1.0f + 2.0f * sh12) * (-1.0f + 2.0f * sh22);
+    u12 = 4.0f * ch2 * ch3 * (-1.0f + 2.0f * sh12) * sh2 * sh3 + 2.0f * ch1 * sh1 * (-1.0f + 2.0f * sh32);
+    u13 = 4.0f * ch1 * ch3 * sh1 * sh3 - 2.0f * ch2 * (-1.0f + 2.0f * sh12) * sh2 * (-1.0f + 2.0f * sh32);
+
+    u21 = 2.0f * ch1 * sh1 * (1.0f - 2.0f * sh22);
+    u22 = -8.0f * ch1 * ch2 * ch3 * sh1 * sh2 * sh3 + (-1.0f + 2.0f * sh12) * (-1.0f + 2.0f * sh32);
+    u23 = -2.0f * ch3 * sh3 + 4.0f * sh1 * (ch3 * sh1 * sh3 + ch1 * ch2 * sh2 * (-1.0f + 2.0f * sh32));
+
+    u31 = 2.0f * ch2 * sh2;
+    u32 = 2.0f * ch3 * (1.0f - 2.0f * sh22) * sh3;
+    u33 = (-1.0f + 2.0f * sh22) * (-1.0f + 2.0f * sh32);
+}
+
+// number of matrices processed together in the batched versions
+static constexpr size_t LANES = 8;
+
+/**
+ * @brief Batched kernel: matrices are transposed into structure of arrays
+ * blocks of LANES matrices. The kernel is vectorized over the lanes
+ * 
+ * @param out_func(size_t id, const float* u, const float* s, const float* v)
+ *   u, v: row-wise 3x3. Called for every matrix
+ */
+template<typename OutFuncT>
+static void batched(
+    const MemoryView<Matrix3x3, RAM>& As,
+    OutFuncT out_func)
+{
+    const size_t N = As.size();
+    const size_t Ngroups = (N + LANES - 1) / LANES;
+
+    #pragma omp parallel for
+    for(size_t g=0; g<Ngroups; g++)
+    {
+        const size_t id_b = g * LANES;
+        const size_t n = std::min(LANES, N - id_b);
+
+        alignas(32) float A[9][LANES];
+        alignas(32) float U[9][LANES];
+        alignas(32) float S[3][LANES];
+        alignas(32) float V[9][LANES];
+
+        for(size_t l=0; l<LANES; l++)
+        {
+            // pad incomplete groups with the identity
+            const Matrix3x3 M = (l < n) ? As[id_b + l] : Matrix3x3::Identity();
+            for(int i=0; i<3; i++)
+            {
+                for(int j=0; j<3; j++)
+                {
+                    A[i * 3 + j][l] = M(i, j);
+                }
+            }
+        }
+
+        #pragma omp simd
+        for(size_t l=0; l<LANES; l++)
+        {
+            // outputs in registers, stored once at the end
+            float u11, u12, u13, u21, u22, u23, u31, u32, u33;
+            float s1, s2, s3;
+            float v11, v12, v13, v21, v22, v23, v31, v32, v33;
+
+            kernel(
+                A[0][l], A[1][l], A[2][l],
+                A[3][l], A[4][l], A[5][l],
+                A[6][l], A[7][l], A[8][l],
+                u11, u12, u13, u21, u22, u23, u31, u32, u33,
+                s1, s2, s3,
+                v11, v12, v13, v21, v22, v23, v31, v32, v33);
+
+            U[0][l] = u11; U[1][l] = u12; U[2][l] = u13;
+            U[3][l] = u21; U[4][l] = u22; U[5][l] = u23;
+            U[6][l] = u31; U[7][l] = u32; U[8][l] = u33;
+            S[0][l] = s1; S[1][l] = s2; S[2][l] = s3;
+            V[0][l] = v11; V[1][l] = v12; V[2][l] = v13;
+            V[3][l] = v21; V[4][l] = v22; V[5][l] = v23;
+            V[6][l] = v31; V[7][l] = v32; V[8][l] = v33;
+        }
+
+        for(size_t l=0; l<n; l++)
+        {
+            float u[9], s[3], v[9];
+            for(int k=0; k<9; k++)
+            {
+                u[k] = U[k][l];
+                v[k] = V[k][l];
+            }
+            for(int k=0; k<3; k++)
+            {
+                s[k] = S[k][l];
+            }
+            out_func(id_b + l, u, s, v);
+        }
+    }
+}
+
+static inline void single(
+    const Matrix3x3& A,
+    float* u, float* s, float* v)
+{
+    kernel(
+        A(0,0), A(0,1), A(0,2),
+        A(1,0), A(1,1), A(1,2),
+        A(2,0), A(2,1), A(2,2),
+        u[0], u[1], u[2],
+        u[3], u[4], u[5],
+        u[6], u[7], u[8],
+        s[0], s[1], s[2],
+        v[0], v[1], v[2],
+        v[3], v[4], v[5],
+        v[6], v[7], v[8]);
+}
+
+static inline void to_matrix(const float* m, Matrix3x3& M)
+{
+    for(int i=0; i<3; i++)
+    {
+        for(int j=0; j<3; j++)
+        {
+            M(i, j) = m[i * 3 + j];
+        }
+    }
+}
+
+// JacobiSVD convention: non-negative singular values. 
+// Move the sign of s3 to the last column of U
+static inline void to_usv(
+    const float* u, const float* s, const float* v,
+    Matrix3x3& U, Vector& S, Matrix3x3& V)
+{
+    const float sign = (s[2] < 0.0f) ? -1.0f : 1.0f;
+    to_matrix(u, U);
+    U(0, 2) *= sign;
+    U(1, 2) *= sign;
+    U(2, 2) *= sign;
+    S = {s[0], s[1], s[2] * sign};
+    to_matrix(v, V);
+}
+
+// R = U * V^T
+static inline Matrix3x3 to_rotation(const float* u, const float* v)
+{
+    Matrix3x3 R;
+    for(int i=0; i<3; i++)
+    {
+        for(int j=0; j<3; j++)
+        {
+            R(i, j) = u[i * 3 + 0] * v[j * 3 + 0] 
+                    + u[i * 3 + 1] * v[j * 3 + 1] 
+                    + u[i * 3 + 2] * v[j * 3 + 2];
+        }
+    }
+    return R;
+}
+
+#undef SVD3_INLINE
+
+} // namespace svd3
 
 SVD::SVD()
 {
@@ -22,15 +443,8 @@ void SVD::calcUV(
     Matrix3x3& U,
     Matrix3x3& V) const
 {
-    // reinterpret cast: data order is the same
-    // TODO: test eigen mapping. this could be a cleaner solution
-    const Eigen::Matrix3f* Aeig = reinterpret_cast<const Eigen::Matrix3f*>(&A);
-    Eigen::Matrix3f* Ueig = reinterpret_cast<Eigen::Matrix3f*>(&U);
-    Eigen::Matrix3f* Veig = reinterpret_cast<Eigen::Matrix3f*>(&V);
-    
-    Eigen::JacobiSVD<Eigen::Matrix3f> svd(Aeig[0], Eigen::ComputeFullU | Eigen::ComputeFullV);
-    Ueig[0] = svd.matrixU();
-    Veig[0] = svd.matrixV();
+    Vector S;
+    calcUSV(A, U, S, V);
 }
 
 void SVD::calcUSV(const Matrix3x3& A,
@@ -38,15 +452,9 @@ void SVD::calcUSV(const Matrix3x3& A,
     Vector& S,
     Matrix3x3& V) const
 {
-    const Eigen::Matrix3f* Aeig = reinterpret_cast<const Eigen::Matrix3f*>(&A);
-    Eigen::Matrix3f* Ueig = reinterpret_cast<Eigen::Matrix3f*>(&U);
-    Eigen::Vector3f* Seig = reinterpret_cast<Eigen::Vector3f*>(&S);
-    Eigen::Matrix3f* Veig = reinterpret_cast<Eigen::Matrix3f*>(&V);
-    
-    Eigen::JacobiSVD<Eigen::Matrix3f> svd(Aeig[0], Eigen::ComputeFullU | Eigen::ComputeFullV);
-    Ueig[0] = svd.matrixU();
-    Seig[0] = svd.singularValues();
-    Veig[0] = svd.matrixV();
+    float u[9], s[3], v[9];
+    svd3::single(A, u, s, v);
+    svd3::to_usv(u, s, v, U, S, V);
 }
 
 void SVD::calcUV(
@@ -54,12 +462,11 @@ void SVD::calcUV(
     MemoryView<Matrix3x3, RAM>& Us,
     MemoryView<Matrix3x3, RAM>& Vs) const
 {
-    #pragma omp parallel for
-    for(size_t i=0; i<As.size(); i++)
+    svd3::batched(As, [&](size_t id, const float* u, const float* s, const float* v)
     {
-        // map to eigen
-        calcUV(As[i], Us[i], Vs[i]);
-    }
+        Vector S;
+        svd3::to_usv(u, s, v, Us[id], S, Vs[id]);
+    });
 }
 
 void SVD::calcUSV(const MemoryView<Matrix3x3, RAM>& As,
@@ -67,12 +474,37 @@ void SVD::calcUSV(const MemoryView<Matrix3x3, RAM>& As,
         MemoryView<Vector, RAM>& Ss,
         MemoryView<Matrix3x3, RAM>& Vs) const
 {
-    #pragma omp parallel for
-    for(size_t i=0; i<As.size(); i++)
+    svd3::batched(As, [&](size_t id, const float* u, const float* s, const float* v)
     {
-        // map to eigen
-        calcUSV(As[i], Us[i], Ss[i], Vs[i]);
-    }
+        svd3::to_usv(u, s, v, Us[id], Ss[id], Vs[id]);
+    });
+}
+
+Matrix3x3 SVD::kabsch(const Matrix3x3& C) const
+{
+    float u[9], s[3], v[9];
+    svd3::single(C, u, s, v);
+    return svd3::to_rotation(u, v);
+}
+
+void SVD::kabsch(
+    const MemoryView<Matrix3x3, RAM>& Cs,
+    MemoryView<Matrix3x3, RAM>& Rs) const
+{
+    svd3::batched(Cs, [&](size_t id, const float* u, const float*, const float* v)
+    {
+        Rs[id] = svd3::to_rotation(u, v);
+    });
+}
+
+void SVD::kabsch(
+    const MemoryView<Matrix3x3, RAM>& Cs,
+    MemoryView<Quaternion, RAM>& Rs) const
+{
+    svd3::batched(Cs, [&](size_t id, const float* u, const float*, const float* v)
+    {
+        Rs[id] = svd3::to_rotation(u, v);
+    });
 }
 
-} // namespace rmagine
\ No newline at end of file
+} // namespace rmagine
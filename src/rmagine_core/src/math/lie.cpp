@@ -0,0 +1,139 @@
+#include "rmagine/math/lie.h"
+#include "rmagine/util/exceptions.h"
+
+#include <algorithm>
+
+namespace rmagine
+{
+
+// elementwise op over two inputs, size 1 inputs are broadcast
+template<typename In1T, typename In2T, typename ResT, typename OpT>
+static void lie_generic(
+    const MemoryView<In1T, RAM>& A,
+    const MemoryView<In2T, RAM>& B,
+    MemoryView<ResT, RAM>& C,
+    OpT op)
+{
+    const size_t N = C.size();
+    if((A.size() != N && A.size() != 1) || (B.size() != N && B.size() != 1))
+    {
+        RM_THROW(Exception, "Lie group op: sizes of inputs and output do not match.");
+    }
+
+    const size_t sa = (A.size() == 1 ? 0 : 1);
+    const size_t sb = (B.size() == 1 ? 0 : 1);
+    const In1T* a = A.raw();
+    const In2T* b = B.raw();
+    ResT* c = C.raw();
+
+    #pragma omp parallel for simd schedule(static)
+    for(size_t i=0; i<N; i++)
+    {
+        c[i] = op(a[i * sa], b[i * sb]);
+    }
+}
+
+template<typename InT, typename ResT, typename OpT>
+static void lie_generic(
+    const MemoryView<InT, RAM>& A,
+    MemoryView<ResT, RAM>& C,
+    OpT op)
+{
+    lie_generic(A, A, C, [op](const InT& a, const InT&) { return op(a); });
+}
+
+void so3Exp(
+    const MemoryView<Vector, RAM>& w,
+    MemoryView<Quaternion, RAM>& q)
+{
+    lie_generic(w, q, [](const Vector& x) { return so3Exp(x); });
+}
+
+Memory<Quaternion, RAM> so3Exp(
+    const MemoryView<Vector, RAM>& w)
+{
+    Memory<Quaternion, RAM> q(w.size());
+    so3Exp(w, q);
+    return q;
+}
+
+void so3Log(
+    const MemoryView<Quaternion, RAM>& q,
+    MemoryView<Vector, RAM>& w)
+{
+    lie_generic(q, w, [](const Quaternion& x) { return so3Log(x); });
+}
+
+Memory<Vector, RAM> so3Log(
+    const MemoryView<Quaternion, RAM>& q)
+{
+    Memory<Vector, RAM> w(q.size());
+    so3Log(q, w);
+    return w;
+}
+
+void se3Exp(
+    const MemoryView<Vector6, RAM>& xi,
+    MemoryView<Transform, RAM>& T)
+{
+    lie_generic(xi, T, [](const Vector6& x) { return se3Exp(x); });
+}
+
+Memory<Transform, RAM> se3Exp(
+    const MemoryView<Vector6, RAM>& xi)
+{
+    Memory<Transform, RAM> T(xi.size());
+    se3Exp(xi, T);
+    return T;
+}
+
+void se3Log(
+    const MemoryView<Transform, RAM>& T,
+    MemoryView<Vector6, RAM>& xi)
+{
+    lie_generic(T, xi, [](const Transform& x) { return se3Log(x); });
+}
+
+Memory<Vector6, RAM> se3Log(
+    const MemoryView<Transform, RAM>& T)
+{
+    Memory<Vector6, RAM> xi(T.size());
+    se3Log(T, xi);
+    return xi;
+}
+
+void boxplus(
+    const MemoryView<Transform, RAM>& T,
+    const MemoryView<Vector6, RAM>& xi,
+    MemoryView<Transform, RAM>& Tr)
+{
+    lie_generic(T, xi, Tr, [](const Transform& a, const Vector6& b) { return boxplus(a, b); });
+}
+
+Memory<Transform, RAM> boxplus(
+    const MemoryView<Transform, RAM>& T,
+    const MemoryView<Vector6, RAM>& xi)
+{
+    Memory<Transform, RAM> Tr(std::max(T.size(), xi.size()));
+    boxplus(T, xi, Tr);
+    return Tr;
+}
+
+void boxminus(
+    const MemoryView<Transform, RAM>& T1,
+    const MemoryView<Transform, RAM>& T2,
+    MemoryView<Vector6, RAM>& xi)
+{
+    lie_generic(T1, T2, xi, [](const Transform& a, const Transform& b) { return boxminus(a, b); });
+}
+
+Memory<Vector6, RAM> boxminus(
+    const MemoryView<Transform, RAM>& T1,
+    const MemoryView<Transform, RAM>& T2)
+{
+    Memory<Vector6, RAM> xi(std::max(T1.size(), T2.size()));
+    boxminus(T1, T2, xi);
+    return xi;
+}
+
+} // namespace rmagine
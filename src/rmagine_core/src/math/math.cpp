@@ -1,8 +1,13 @@
 #include "rmagine/math/math.h"
+#include "rmagine/math/simd.h"
+#include "reduce_batched.h"
 
 #include "rmagine/util/prints.h"
+#include "rmagine/util/exceptions.h"
 
 #include <cassert>
+#include <vector>
+#include <algorithm>
 
 namespace rmagine {
 
@@ -48,6 +53,48 @@ void mult1xN_generic(
     }
 }
 
+// the SIMD kernels with the sizes of the per-element loops above: 
+// the output may be larger than the number of results
+template<typename DataT>
+static MemoryView<DataT, RAM> head(const MemoryView<DataT, RAM>& X, size_t N)
+{
+    if(X.size() < N)
+    {
+        RM_THROW(Exception, "mult - memory has less elements than required.");
+    }
+    return X(0, N);
+}
+
+template<typename In1T, typename In2T, typename ResT>
+void multNxN_simd(
+    const MemoryView<In1T, RAM>& A,
+    const MemoryView<In2T, RAM>& B,
+    MemoryView<ResT, RAM>& C)
+{
+    MemoryView<ResT, RAM> C_ = head(C, A.size());
+    simd::mult(A, head(B, A.size()), C_);
+}
+
+template<typename In1T, typename In2T, typename ResT>
+void multNx1_simd(
+    const MemoryView<In1T, RAM>& A,
+    const MemoryView<In2T, RAM>& B,
+    MemoryView<ResT, RAM>& C)
+{
+    MemoryView<ResT, RAM> C_ = head(C, A.size());
+    simd::mult(A, head(B, 1), C_);
+}
+
+template<typename In1T, typename In2T, typename ResT>
+void mult1xN_simd(
+    const MemoryView<In1T, RAM>& A,
+    const MemoryView<In2T, RAM>& B,
+    MemoryView<ResT, RAM>& C)
+{
+    MemoryView<ResT, RAM> C_ = head(C, B.size());
+    simd::mult(head(A, 1), B, C_);
+}
+
 template<typename In1T, typename In2T, typename ResT>
 void addNxN_generic(
     const MemoryView<In1T, RAM>& A,
@@ -149,7 +196,7 @@ void multNxN(
     const MemoryView<Vector, RAM>& b, 
     MemoryView<Vector, RAM>& c)
 {
-    multNxN_generic(A, b, c);
+    multNxN_simd(A, b, c);
 }
 
 Memory<Vector, RAM> multNxN(
@@ -166,7 +213,7 @@ void multNxN(
     const MemoryView<Transform, RAM>& T2,
     MemoryView<Transform, RAM>& Tr)
 {
-    multNxN_generic(T1, T2, Tr);
+    multNxN_simd(T1, T2, Tr);
 }
 
 Memory<Transform, RAM> multNxN(
@@ -183,7 +230,7 @@ void multNxN(
     const MemoryView<Vector, RAM>& x,
     MemoryView<Vector, RAM>& c)
 {
-    multNxN_generic(T, x, c);
+    multNxN_simd(T, x, c);
 }
 
 Memory<Vector, RAM> multNxN(
@@ -217,7 +264,7 @@ void multNxN(
     const MemoryView<Vector, RAM>& x,
     MemoryView<Vector, RAM>& c)
 {
-    multNxN_generic(M, x, c);
+    multNxN_simd(M, x, c);
 }
 
 Memory<Vector, RAM> multNxN(
@@ -254,7 +301,7 @@ void multNx1(
     const MemoryView<Vector, RAM>& b, 
     MemoryView<Vector, RAM>& C)
 {
-    multNx1_generic(A, b, C);
+    multNx1_simd(A, b, C);
 }
 
 Memory<Vector, RAM> multNx1(
@@ -271,7 +318,7 @@ void multNx1(
     const MemoryView<Transform, RAM>& t2,
     MemoryView<Transform, RAM>& Tr)
 {
-    multNx1_generic(T1, t2, Tr);
+    multNx1_simd(T1, t2, Tr);
 }
 
 Memory<Transform, RAM> multNx1(
@@ -288,7 +335,7 @@ void multNx1(
     const MemoryView<Vector, RAM>& x,
     MemoryView<Vector, RAM>& C)
 {
-    multNx1_generic(T, x, C);
+    multNx1_simd(T, x, C);
 }
 
 Memory<Vector, RAM> multNx1(
@@ -322,7 +369,7 @@ void multNx1(
     const MemoryView<Vector, RAM>& x,
     MemoryView<Vector, RAM>& C)
 {
-    multNx1_generic(M, x, C);
+    multNx1_simd(M, x, C);
 }
 
 Memory<Vector, RAM> multNx1(
@@ -359,7 +406,7 @@ void mult1xN(
     const MemoryView<Vector, RAM>& B, 
     MemoryView<Vector, RAM>& C)
 {
-    mult1xN_generic(a, B, C);
+    mult1xN_simd(a, B, C);
 }
 
 Memory<Vector, RAM> mult1xN(
@@ -376,7 +423,7 @@ void mult1xN(
     const MemoryView<Transform, RAM>& T2,
     MemoryView<Transform, RAM>& Tr)
 {
-    mult1xN_generic(t1, T2, Tr);
+    mult1xN_simd(t1, T2, Tr);
 }
 
 Memory<Transform, RAM> mult1xN(
@@ -393,7 +440,7 @@ void mult1xN(
     const MemoryView<Vector, RAM>& X,
     MemoryView<Vector, RAM>& C)
 {
-    mult1xN_generic(t, X, C);
+    mult1xN_simd(t, X, C);
 }
 
 Memory<Vector, RAM> mult1xN(
@@ -427,7 +474,7 @@ void mult1xN(
     const MemoryView<Vector, RAM>& X,
     MemoryView<Vector, RAM>& C)
 {
-    mult1xN_generic(m, X, C);
+    mult1xN_simd(m, X, C);
 }
 
 Memory<Vector, RAM> mult1xN(
@@ -624,16 +671,46 @@ void pack(
 
 ////////
 // #sum, #mean 
+
+// Reductions are computed on fixed size blocks. Each block is accumulated 
+// in double precision, the block results are combined pairwise. 
+// The block size does not depend on the number of threads
+// -> results are bitwise reproducible. One batch of reduce_batched
+template<typename AccT, typename BlockFuncT>
+static AccT reduce_blocks(size_t N, BlockFuncT block_func)
+{
+    AccT res = AccT::Zeros();
+    reduce_batched<AccT>(1, N, AccT::Zeros(), block_func, 
+        [&res](size_t, const AccT& acc) {
+            res = acc;
+        });
+    return res;
+}
+
+static Vector3_<double> sum_stable(
+    const MemoryView<Vector, RAM>& X)
+{
+    const Vector* data = X.raw();
+    return reduce_blocks<Vector3_<double> >(X.size(), 
+        [data](size_t id_b, size_t id_e)
+    {
+        double sx = 0.0, sy = 0.0, sz = 0.0;
+        #pragma omp simd reduction(+:sx,sy,sz)
+        for(size_t i=id_b; i<id_e; i++)
+        {
+            sx += data[i].x;
+            sy += data[i].y;
+            sz += data[i].z;
+        }
+        return Vector3_<double>{sx, sy, sz};
+    });
+}
+
 void sum(
     const MemoryView<Vector, RAM>& X, 
     MemoryView<Vector, RAM>& res)
 {
-    Vector s = {0, 0, 0};
-    for(unsigned int i=0; i<X.size(); i++)
-    {
-        s += X[i];
-    }
-    res[0] = s;
+    res[0] = sum_stable(X).cast<float>();
 }
 
 Memory<Vector, RAM> sum(
@@ -648,8 +725,8 @@ void mean(
     const MemoryView<Vector, RAM>& X,
     MemoryView<Vector, RAM>& res)
 {
-    sum(X, res);
-    res[0] /= static_cast<float>(X.size());
+    const Vector3_<double> s = sum_stable(X);
+    res[0] = (s / static_cast<double>(X.size())).cast<float>();
 }
 
 Memory<Vector, RAM> mean(
@@ -667,25 +744,40 @@ void cov(
     const MemoryView<Vector, RAM>& v2,
     MemoryView<Matrix3x3, RAM>& C)
 {
-    Matrix3x3 S;
-    S.setZeros();
-    
-    for(unsigned int i=0; i<v1.size(); i++)
-    {
-        const Vector& a = v1[i];
-        const Vector& b = v2[i];
-        S(0,0) += a.x * b.x;
-        S(1,0) += a.x * b.y;
-        S(2,0) += a.x * b.z;
-        S(0,1) += a.y * b.x;
-        S(1,1) += a.y * b.y;
-        S(2,1) += a.y * b.z;
-        S(0,2) += a.z * b.x;
-        S(1,2) += a.z * b.y;
-        S(2,2) += a.z * b.z;
-    }
+    const Vector* a = v1.raw();
+    const Vector* b = v2.raw();
 
-    C[0] = S / static_cast<float>(v1.size());
+    const Matrix_<double, 3, 3> S = reduce_blocks<Matrix_<double, 3, 3> >(v1.size(), 
+        [a, b](size_t id_b, size_t id_e)
+    {
+        double s00 = 0.0, s01 = 0.0, s02 = 0.0;
+        double s10 = 0.0, s11 = 0.0, s12 = 0.0;
+        double s20 = 0.0, s21 = 0.0, s22 = 0.0;
+
+        #pragma omp simd reduction(+:s00,s01,s02,s10,s11,s12,s20,s21,s22)
+        for(size_t i=id_b; i<id_e; i++)
+        {
+            const double ax = a[i].x, ay = a[i].y, az = a[i].z;
+            const double bx = b[i].x, by = b[i].y, bz = b[i].z;
+            s00 += ax * bx;
+            s10 += ax * by;
+            s20 += ax * bz;
+            s01 += ay * bx;
+            s11 += ay * by;
+            s21 += ay * bz;
+            s02 += az * bx;
+            s12 += az * by;
+            s22 += az * bz;
+        }
+
+        Matrix_<double, 3, 3> Sb;
+        Sb(0,0) = s00; Sb(0,1) = s01; Sb(0,2) = s02;
+        Sb(1,0) = s10; Sb(1,1) = s11; Sb(1,2) = s12;
+        Sb(2,0) = s20; Sb(2,1) = s21; Sb(2,2) = s22;
+        return Sb;
+    });
+
+    C[0] = (S / static_cast<double>(v1.size())).cast<float>();
 }
 
 Memory<Matrix3x3, RAM> cov(
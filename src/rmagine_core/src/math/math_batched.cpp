@@ -0,0 +1,497 @@
+#include "rmagine/math/math_batched.h"
+#include "reduce_batched.h"
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+namespace rmagine
+{
+
+// sum of the vectors with mask_func(i) == true. Selects instead of 
+// multiplying with 0/1: masked out elements may be NaN (misses)
+template<typename MaskFuncT>
+static Vector3_<double> sum_vectors(
+    const Vector* data, size_t id_b, size_t id_e, MaskFuncT mask_func)
+{
+    double sx = 0.0, sy = 0.0, sz = 0.0;
+    #pragma omp simd reduction(+:sx,sy,sz)
+    for(size_t i=id_b; i<id_e; i++)
+    {
+        const bool use = mask_func(i);
+        sx += use ? static_cast<double>(data[i].x) : 0.0;
+        sy += use ? static_cast<double>(data[i].y) : 0.0;
+        sz += use ? static_cast<double>(data[i].z) : 0.0;
+    }
+    return {sx, sy, sz};
+}
+
+// sum of outer products a * b^T with mask_func(i) == true, with the memory layout of cov()
+template<typename MaskFuncT>
+static Matrix_<double, 3, 3> sum_outer(
+    const Vector* a, const Vector* b, size_t id_b, size_t id_e, MaskFuncT mask_func)
+{
+    double s00 = 0.0, s01 = 0.0, s02 = 0.0;
+    double s10 = 0.0, s11 = 0.0, s12 = 0.0;
+    double s20 = 0.0, s21 = 0.0, s22 = 0.0;
+
+    #pragma omp simd reduction(+:s00,s01,s02,s10,s11,s12,s20,s21,s22)
+    for(size_t i=id_b; i<id_e; i++)
+    {
+        const bool use = mask_func(i);
+        const double ax = use ? a[i].x : 0.0, ay = use ? a[i].y : 0.0, az = use ? a[i].z : 0.0;
+        const double bx = use ? b[i].x : 0.0, by = use ? b[i].y : 0.0, bz = use ? b[i].z : 0.0;
+        s00 += ax * bx;
+        s10 += ax * by;
+        s20 += ax * bz;
+        s01 += ay * bx;
+        s11 += ay * by;
+        s21 += ay * bz;
+        s02 += az * bx;
+        s12 += az * by;
+        s22 += az * bz;
+    }
+
+    Matrix_<double, 3, 3> S;
+    S(0,0) = s00; S(0,1) = s01; S(0,2) = s02;
+    S(1,0) = s10; S(1,1) = s11; S(1,2) = s12;
+    S(2,0) = s20; S(2,1) = s21; S(2,2) = s22;
+    return S;
+}
+
+struct MaskedVectorSum 
+{
+    Vector3_<double> s;
+    uint64_t n;
+
+    MaskedVectorSum& operator+=(const MaskedVectorSum& o)
+    {
+        s += o.s;
+        n += o.n;
+        return *this;
+    }
+};
+
+struct MaskedOuterSum 
+{
+    Matrix_<double, 3, 3> S;
+    uint64_t n;
+
+    MaskedOuterSum& operator+=(const MaskedOuterSum& o)
+    {
+        S += o.S;
+        n += o.n;
+        return *this;
+    }
+};
+
+template<typename MaskT>
+static void sum_batched_masked(
+    const MemoryView<Vector, RAM>& data,
+    const MemoryView<MaskT, RAM>& mask,
+    MemoryView<Vector, RAM>& sums)
+{
+    const size_t batchSize = data.size() / sums.size();
+    const Vector* d = data.raw();
+    const MaskT* m = mask.raw();
+
+    reduce_batched<Vector3_<double> >(sums.size(), batchSize, Vector3_<double>::Zeros(),
+        [d, m](size_t id_b, size_t id_e) {
+            return sum_vectors(d, id_b, id_e, [m](size_t i) { return m[i] != 0; });
+        },
+        [&sums](size_t b, const Vector3_<double>& s) {
+            sums[b] = s.cast<float>();
+        });
+}
+
+//////////
+// #sumBatched
+void sumBatched(
+    const MemoryView<Vector, RAM>& data,
+    MemoryView<Vector, RAM>& sums)
+{
+    const size_t batchSize = data.size() / sums.size();
+    const Vector* d = data.raw();
+
+    reduce_batched<Vector3_<double> >(sums.size(), batchSize, Vector3_<double>::Zeros(),
+        [d](size_t id_b, size_t id_e) {
+            return sum_vectors(d, id_b, id_e, [](size_t) { return true; });
+        },
+        [&sums](size_t b, const Vector3_<double>& s) {
+            sums[b] = s.cast<float>();
+        });
+}
+
+Memory<Vector, RAM> sumBatched(
+    const MemoryView<Vector, RAM>& data,
+    size_t batchSize)
+{
+    Memory<Vector, RAM> sums(data.size() / batchSize);
+    sumBatched(data, sums);
+    return sums;
+}
+
+void sumBatched(
+    const MemoryView<Matrix3x3, RAM>& data,
+    MemoryView<Matrix3x3, RAM>& sums)
+{
+    const size_t batchSize = data.size() / sums.size();
+    const Matrix3x3* d = data.raw();
+
+    reduce_batched<Matrix_<double, 3, 3> >(sums.size(), batchSize, Matrix_<double, 3, 3>::Zeros(),
+        [d](size_t id_b, size_t id_e) {
+            Matrix_<double, 3, 3> S = Matrix_<double, 3, 3>::Zeros();
+            for(size_t i=id_b; i<id_e; i++)
+            {
+                S += d[i].cast<double>();
+            }
+            return S;
+        },
+        [&sums](size_t b, const Matrix_<double, 3, 3>& S) {
+            sums[b] = S.cast<float>();
+        });
+}
+
+Memory<Matrix3x3, RAM> sumBatched(
+    const MemoryView<Matrix3x3, RAM>& data,
+    size_t batchSize)
+{
+    Memory<Matrix3x3, RAM> sums(data.size() / batchSize);
+    sumBatched(data, sums);
+    return sums;
+}
+
+void sumBatched(
+    const MemoryView<float, RAM>& data,
+    MemoryView<float, RAM>& sums)
+{
+    const size_t batchSize = data.size() / sums.size();
+    const float* d = data.raw();
+
+    reduce_batched<double>(sums.size(), batchSize, 0.0,
+        [d](size_t id_b, size_t id_e) {
+            double s = 0.0;
+            #pragma omp simd reduction(+:s)
+            for(size_t i=id_b; i<id_e; i++)
+            {
+                s += d[i];
+            }
+            return s;
+        },
+        [&sums](size_t b, double s) {
+            sums[b] = s;
+        });
+}
+
+Memory<float, RAM> sumBatched(
+    const MemoryView<float, RAM>& data,
+    size_t batchSize)
+{
+    Memory<float, RAM> sums(data.size() / batchSize);
+    sumBatched(data, sums);
+    return sums;
+}
+
+void sumBatched(
+    const MemoryView<unsigned int, RAM>& data,
+    MemoryView<unsigned int, RAM>& sums)
+{
+    const size_t batchSize = data.size() / sums.size();
+    const unsigned int* d = data.raw();
+
+    reduce_batched<uint64_t>(sums.size(), batchSize, 0,
+        [d](size_t id_b, size_t id_e) {
+            uint64_t s = 0;
+            #pragma omp simd reduction(+:s)
+            for(size_t i=id_b; i<id_e; i++)
+            {
+                s += d[i];
+            }
+            return s;
+        },
+        [&sums](size_t b, uint64_t s) {
+            sums[b] = s;
+        });
+}
+
+Memory<unsigned int, RAM> sumBatched(
+    const MemoryView<unsigned int, RAM>& data,
+    size_t batchSize)
+{
+    Memory<unsigned int, RAM> sums(data.size() / batchSize);
+    sumBatched(data, sums);
+    return sums;
+}
+
+//////////
+// #sumBatched masked
+void sumBatched(
+    const MemoryView<Vector, RAM>& data,
+    const MemoryView<bool, RAM>& mask,
+    MemoryView<Vector, RAM>& sums)
+{
+    sum_batched_masked(data, mask, sums);
+}
+
+Memory<Vector, RAM> sumBatched(
+    const MemoryView<Vector, RAM>& data,
+    const MemoryView<bool, RAM>& mask,
+    size_t batchSize)
+{
+    Memory<Vector, RAM> sums(data.size() / batchSize);
+    sumBatched(data, mask, sums);
+    return sums;
+}
+
+void sumBatched(
+    const MemoryView<Vector, RAM>& data,
+    const MemoryView<unsigned int, RAM>& mask,
+    MemoryView<Vector, RAM>& sums)
+{
+    sum_batched_masked(data, mask, sums);
+}
+
+Memory<Vector, RAM> sumBatched(
+    const MemoryView<Vector, RAM>& data,
+    const MemoryView<unsigned int, RAM>& mask,
+    size_t batchSize)
+{
+    Memory<Vector, RAM> sums(data.size() / batchSize);
+    sumBatched(data, mask, sums);
+    return sums;
+}
+
+void sumBatched(
+    const MemoryView<Vector, RAM>& data,
+    const MemoryView<uint8_t, RAM>& mask,
+    MemoryView<Vector, RAM>& sums)
+{
+    sum_batched_masked(data, mask, sums);
+}
+
+Memory<Vector, RAM> sumBatched(
+    const MemoryView<Vector, RAM>& data,
+    const MemoryView<uint8_t, RAM>& mask,
+    size_t batchSize)
+{
+    Memory<Vector, RAM> sums(data.size() / batchSize);
+    sumBatched(data, mask, sums);
+    return sums;
+}
+
+void countBatched(
+    const MemoryView<uint8_t, RAM>& mask,
+    MemoryView<unsigned int, RAM>& counts)
+{
+    const size_t batchSize = mask.size() / counts.size();
+    const uint8_t* m = mask.raw();
+
+    reduce_batched<uint64_t>(counts.size(), batchSize, 0,
+        [m](size_t id_b, size_t id_e) {
+            uint64_t n = 0;
+            #pragma omp simd reduction(+:n)
+            for(size_t i=id_b; i<id_e; i++)
+            {
+                n += (m[i] != 0);
+            }
+            return n;
+        },
+        [&counts](size_t b, uint64_t n) {
+            counts[b] = n;
+        });
+}
+
+Memory<unsigned int, RAM> countBatched(
+    const MemoryView<uint8_t, RAM>& mask,
+    size_t batchSize)
+{
+    Memory<unsigned int, RAM> counts(mask.size() / batchSize);
+    countBatched(mask, counts);
+    return counts;
+}
+
+//////////
+// #meanBatched
+void meanBatched(
+    const MemoryView<Vector, RAM>& data,
+    MemoryView<Vector, RAM>& means)
+{
+    const size_t batchSize = data.size() / means.size();
+    const Vector* d = data.raw();
+
+    reduce_batched<Vector3_<double> >(means.size(), batchSize, Vector3_<double>::Zeros(),
+        [d](size_t id_b, size_t id_e) {
+            return sum_vectors(d, id_b, id_e, [](size_t) { return true; });
+        },
+        [&means, batchSize](size_t b, const Vector3_<double>& s) {
+            means[b] = (batchSize > 0) ? (s / static_cast<double>(batchSize)).cast<float>() : Vector::Zeros();
+        });
+}
+
+Memory<Vector, RAM> meanBatched(
+    const MemoryView<Vector, RAM>& data,
+    size_t batchSize)
+{
+    Memory<Vector, RAM> means(data.size() / batchSize);
+    meanBatched(data, means);
+    return means;
+}
+
+void meanBatched(
+    const MemoryView<float, RAM>& data,
+    MemoryView<float, RAM>& means)
+{
+    sumBatched(data, means);
+    const float batchSize = data.size() / means.size();
+    for(size_t i=0; i<means.size(); i++)
+    {
+        means[i] /= batchSize;
+    }
+}
+
+Memory<float, RAM> meanBatched(
+    const MemoryView<float, RAM>& data,
+    size_t batchSize)
+{
+    Memory<float, RAM> means(data.size() / batchSize);
+    meanBatched(data, means);
+    return means;
+}
+
+void meanBatched(
+    const MemoryView<Vector, RAM>& data,
+    const MemoryView<uint8_t, RAM>& mask,
+    MemoryView<Vector, RAM>& means)
+{
+    const size_t batchSize = data.size() / means.size();
+    const Vector* d = data.raw();
+    const uint8_t* m = mask.raw();
+
+    reduce_batched<MaskedVectorSum>(means.size(), batchSize, MaskedVectorSum{Vector3_<double>::Zeros(), 0},
+        [d, m](size_t id_b, size_t id_e) {
+            MaskedVectorSum res;
+            res.s = sum_vectors(d, id_b, id_e, [m](size_t i) { return m[i] != 0; });
+            res.n = 0;
+            for(size_t i=id_b; i<id_e; i++)
+            {
+                res.n += (m[i] != 0);
+            }
+            return res;
+        },
+        [&means](size_t b, const MaskedVectorSum& acc) {
+            means[b] = (acc.n > 0) ? (acc.s / static_cast<double>(acc.n)).cast<float>() : Vector::Zeros();
+        });
+}
+
+Memory<Vector, RAM> meanBatched(
+    const MemoryView<Vector, RAM>& data,
+    const MemoryView<uint8_t, RAM>& mask,
+    size_t batchSize)
+{
+    Memory<Vector, RAM> means(data.size() / batchSize);
+    meanBatched(data, mask, means);
+    return means;
+}
+
+////////
+// #covBatched
+void covBatched(
+    const MemoryView<Vector, RAM>& m1, 
+    const MemoryView<Vector, RAM>& m2,
+    MemoryView<Matrix3x3, RAM>& covs)
+{
+    const size_t batchSize = m1.size() / covs.size();
+    const Vector* a = m1.raw();
+    const Vector* b = m2.raw();
+
+    reduce_batched<Matrix_<double, 3, 3> >(covs.size(), batchSize, Matrix_<double, 3, 3>::Zeros(),
+        [a, b](size_t id_b, size_t id_e) {
+            return sum_outer(a, b, id_b, id_e, [](size_t) { return true; });
+        },
+        [&covs, batchSize](size_t bid, const Matrix_<double, 3, 3>& S) {
+            covs[bid] = (batchSize > 0) ? (S / static_cast<double>(batchSize)).cast<float>() : Matrix3x3::Zeros();
+        });
+}
+
+Memory<Matrix3x3, RAM> covBatched(
+    const MemoryView<Vector, RAM>& m1, 
+    const MemoryView<Vector, RAM>& m2,
+    unsigned int batchSize)
+{
+    Memory<Matrix3x3, RAM> covs(m1.size() / batchSize);
+    covBatched(m1, m2, covs);
+    return covs;
+}
+
+void covBatched(
+    const MemoryView<Vector, RAM>& m1, 
+    const MemoryView<Vector, RAM>& m2,
+    const MemoryView<bool, RAM>& corr,
+    const MemoryView<unsigned int, RAM>& ncorr,
+    MemoryView<Matrix3x3, RAM>& covs)
+{
+    const size_t batchSize = m1.size() / covs.size();
+    const Vector* a = m1.raw();
+    const Vector* b = m2.raw();
+    const bool* c = corr.raw();
+
+    reduce_batched<Matrix_<double, 3, 3> >(covs.size(), batchSize, Matrix_<double, 3, 3>::Zeros(),
+        [a, b, c](size_t id_b, size_t id_e) {
+            return sum_outer(a, b, id_b, id_e, [c](size_t i) { return c[i]; });
+        },
+        [&covs, &ncorr](size_t bid, const Matrix_<double, 3, 3>& S) {
+            covs[bid] = (ncorr[bid] > 0) ? (S / static_cast<double>(ncorr[bid])).cast<float>() : Matrix3x3::Zeros();
+        });
+}
+
+Memory<Matrix3x3, RAM> covBatched(
+    const MemoryView<Vector, RAM>& m1, 
+    const MemoryView<Vector, RAM>& m2,
+    const MemoryView<bool, RAM>& corr,
+    const MemoryView<unsigned int, RAM>& ncorr,
+    unsigned int batchSize)
+{
+    Memory<Matrix3x3, RAM> covs(m1.size() / batchSize);
+    covBatched(m1, m2, corr, ncorr, covs);
+    return covs;
+}
+
+void covBatched(
+    const MemoryView<Vector, RAM>& m1, 
+    const MemoryView<Vector, RAM>& m2,
+    const MemoryView<uint8_t, RAM>& mask,
+    MemoryView<Matrix3x3, RAM>& covs)
+{
+    const size_t batchSize = m1.size() / covs.size();
+    const Vector* a = m1.raw();
+    const Vector* b = m2.raw();
+    const uint8_t* m = mask.raw();
+
+    reduce_batched<MaskedOuterSum>(covs.size(), batchSize, MaskedOuterSum{Matrix_<double, 3, 3>::Zeros(), 0},
+        [a, b, m](size_t id_b, size_t id_e) {
+            MaskedOuterSum res;
+            res.S = sum_outer(a, b, id_b, id_e, [m](size_t i) { return m[i] != 0; });
+            res.n = 0;
+            for(size_t i=id_b; i<id_e; i++)
+            {
+                res.n += (m[i] != 0);
+            }
+            return res;
+        },
+        [&covs](size_t bid, const MaskedOuterSum& acc) {
+            covs[bid] = (acc.n > 0) ? (acc.S / static_cast<double>(acc.n)).cast<float>() : Matrix3x3::Zeros();
+        });
+}
+
+Memory<Matrix3x3, RAM> covBatched(
+    const MemoryView<Vector, RAM>& m1, 
+    const MemoryView<Vector, RAM>& m2,
+    const MemoryView<uint8_t, RAM>& mask,
+    unsigned int batchSize)
+{
+    Memory<Matrix3x3, RAM> covs(m1.size() / batchSize);
+    covBatched(m1, m2, mask, covs);
+    return covs;
+}
+
+} // namespace rmagine
@@ -0,0 +1,72 @@
+#ifndef RMAGINE_MATH_REDUCE_BATCHED_H
+#define RMAGINE_MATH_REDUCE_BATCHED_H
+
+// Segmented reductions over flat buffers. Shared by math.cpp, math_batched.cpp
+// and registration.cpp
+
+#include <vector>
+#include <algorithm>
+
+namespace rmagine
+{
+
+// Batches larger than this are split into blocks that are reduced in parallel
+// and combined pairwise afterwards
+static constexpr size_t BATCH_BLOCK_SIZE = 2048;
+
+/**
+ * @brief Reduce every batch of a flat buffer
+ * 
+ * @param block_func  AccT(size_t id_begin, size_t id_end): reduction of one block
+ * @param res_func    void(size_t batch_id, const AccT& acc): writes the result of a batch
+ */
+template<typename AccT, typename BlockFuncT, typename ResFuncT>
+static void reduce_batched(
+    size_t Nbatches,
+    size_t batchSize,
+    const AccT& zero,
+    BlockFuncT block_func,
+    ResFuncT res_func)
+{
+    if(batchSize <= BATCH_BLOCK_SIZE)
+    {
+        #pragma omp parallel for schedule(static)
+        for(size_t b=0; b<Nbatches; b++)
+        {
+            const size_t id_b = b * batchSize;
+            res_func(b, (batchSize > 0) ? block_func(id_b, id_b + batchSize) : zero);
+        }
+        return;
+    }
+
+    const size_t Nblocks = (batchSize + BATCH_BLOCK_SIZE - 1) / BATCH_BLOCK_SIZE;
+    std::vector<AccT> partial(Nbatches * Nblocks);
+
+    #pragma omp parallel for schedule(static)
+    for(size_t i=0; i<partial.size(); i++)
+    {
+        const size_t b = i / Nblocks;
+        const size_t block = i % Nblocks;
+        const size_t id_b = b * batchSize + block * BATCH_BLOCK_SIZE;
+        const size_t id_e = b * batchSize + std::min(batchSize, (block + 1) * BATCH_BLOCK_SIZE);
+        partial[i] = block_func(id_b, id_e);
+    }
+
+    #pragma omp parallel for schedule(static)
+    for(size_t b=0; b<Nbatches; b++)
+    {
+        AccT* p = &partial[b * Nblocks];
+        for(size_t stride = 1; stride < Nblocks; stride *= 2)
+        {
+            for(size_t i = 0; i + stride < Nblocks; i += 2 * stride)
+            {
+                p[i] += p[i + stride];
+            }
+        }
+        res_func(b, p[0]);
+    }
+}
+
+} // namespace rmagine
+
+#endif // RMAGINE_MATH_REDUCE_BATCHED_H
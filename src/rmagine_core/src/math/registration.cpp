@@ -0,0 +1,278 @@
+#include "rmagine/math/registration.h"
+#include "rmagine/math/SVD.hpp"
+#include "rmagine/util/exceptions.h"
+#include "reduce_batched.h"
+
+#include <Eigen/Dense>
+#include <cmath>
+
+namespace rmagine
+{
+
+static void check_sizes(
+    size_t Ndata, size_t Nmodel, size_t Nmask, size_t Nposes)
+{
+    if(Ndata != Nmodel || Ndata != Nmask)
+    {
+        RM_THROW(Exception, "Registration: correspondence buffers differ in size.");
+    }
+    if(Nposes == 0 || Ndata % Nposes != 0)
+    {
+        RM_THROW(Exception, "Registration: buffer size is not a multiple of the number of poses.");
+    }
+}
+
+struct PointMeansSum
+{
+    Vector3_<double> d;
+    Vector3_<double> m;
+    uint64_t n;
+
+    PointMeansSum& operator+=(const PointMeansSum& o)
+    {
+        d += o.d;
+        m += o.m;
+        n += o.n;
+        return *this;
+    }
+};
+
+struct CrossCovSum
+{
+    Matrix_<double, 3, 3> C;
+
+    CrossCovSum& operator+=(const CrossCovSum& o)
+    {
+        C += o.C;
+        return *this;
+    }
+};
+
+void umeyamaBatched(
+    const MemoryView<Vector, RAM>& dataset,
+    const MemoryView<Vector, RAM>& model,
+    const MemoryView<uint8_t, RAM>& mask,
+    MemoryView<Transform, RAM>& Tcorr)
+{
+    check_sizes(dataset.size(), model.size(), mask.size(), Tcorr.size());
+    const size_t Nposes = Tcorr.size();
+    const size_t batchSize = dataset.size() / Nposes;
+
+    const Vector* d = dataset.raw();
+    const Vector* m = model.raw();
+    const uint8_t* w = mask.raw();
+
+    // 1. means of valid correspondences
+    std::vector<PointMeansSum> means(Nposes);
+    reduce_batched(Nposes, batchSize, 
+        PointMeansSum{Vector3_<double>::Zeros(), Vector3_<double>::Zeros(), 0},
+        [&](size_t id_b, size_t id_e) {
+            double dx = 0.0, dy = 0.0, dz = 0.0;
+            double mx = 0.0, my = 0.0, mz = 0.0;
+            uint64_t n = 0;
+            #pragma omp simd reduction(+:dx,dy,dz,mx,my,mz,n)
+            for(size_t i=id_b; i<id_e; i++)
+            {
+                // select, not multiply: misses may be NaN
+                const bool use = (w[i] != 0);
+                dx += use ? d[i].x : 0.0; dy += use ? d[i].y : 0.0; dz += use ? d[i].z : 0.0;
+                mx += use ? m[i].x : 0.0; my += use ? m[i].y : 0.0; mz += use ? m[i].z : 0.0;
+                n += use;
+            }
+            return PointMeansSum{{dx, dy, dz}, {mx, my, mz}, n};
+        },
+        [&](size_t b, const PointMeansSum& s) {
+            means[b] = s;
+            if(s.n > 0)
+            {
+                means[b].d /= static_cast<double>(s.n);
+                means[b].m /= static_cast<double>(s.n);
+            }
+        });
+
+    // 2. cross covariance of centered correspondences (layout of cov(dataset, model))
+    const SVD svd;
+    reduce_batched(Nposes, batchSize, 
+        CrossCovSum{Matrix_<double, 3, 3>::Zeros()},
+        [&](size_t id_b, size_t id_e) {
+            const PointMeansSum& mb = means[id_b / batchSize];
+            double s00 = 0.0, s01 = 0.0, s02 = 0.0;
+            double s10 = 0.0, s11 = 0.0, s12 = 0.0;
+            double s20 = 0.0, s21 = 0.0, s22 = 0.0;
+            #pragma omp simd reduction(+:s00,s01,s02,s10,s11,s12,s20,s21,s22)
+            for(size_t i=id_b; i<id_e; i++)
+            {
+                const bool use = (w[i] != 0);
+                const double ax = use ? d[i].x - mb.d.x : 0.0;
+                const double ay = use ? d[i].y - mb.d.y : 0.0;
+                const double az = use ? d[i].z - mb.d.z : 0.0;
+                const double bx = use ? m[i].x - mb.m.x : 0.0;
+                const double by = use ? m[i].y - mb.m.y : 0.0;
+                const double bz = use ? m[i].z - mb.m.z : 0.0;
+                s00 += bx * ax; s01 += bx * ay; s02 += bx * az;
+                s10 += by * ax; s11 += by * ay; s12 += by * az;
+                s20 += bz * ax; s21 += bz * ay; s22 += bz * az;
+            }
+            CrossCovSum ret;
+            ret.C(0,0) = s00; ret.C(0,1) = s01; ret.C(0,2) = s02;
+            ret.C(1,0) = s10; ret.C(1,1) = s11; ret.C(1,2) = s12;
+            ret.C(2,0) = s20; ret.C(2,1) = s21; ret.C(2,2) = s22;
+            return ret;
+        },
+        [&](size_t b, const CrossCovSum& s) {
+            Transform T = Transform::Identity();
+            T.stamp = 0;
+            if(means[b].n >= 3)
+            {
+                const Matrix3x3 C = (s.C / static_cast<double>(means[b].n)).cast<float>();
+                const Matrix3x3 R = svd.kabsch(C);
+                T.R = R;
+                // t = mean_m - R * mean_d
+                T.t = means[b].m.cast<float>() - R * means[b].d.cast<float>();
+            }
+            Tcorr[b] = T;
+        });
+}
+
+Memory<Transform, RAM> umeyamaBatched(
+    const MemoryView<Vector, RAM>& dataset,
+    const MemoryView<Vector, RAM>& model,
+    const MemoryView<uint8_t, RAM>& mask,
+    unsigned int batchSize)
+{
+    Memory<Transform, RAM> Tcorr(dataset.size() / batchSize);
+    umeyamaBatched(dataset, model, mask, Tcorr);
+    return Tcorr;
+}
+
+// normal equations of point to plane: J = [d x n, n], r = n * (d - m)
+struct PointToPlaneSum
+{
+    double H[21]; // upper triangle of J^T J, row-wise
+    double g[6];  // J^T r
+    uint64_t n;
+
+    PointToPlaneSum& operator+=(const PointToPlaneSum& o)
+    {
+        for(size_t k=0; k<21; k++)
+        {
+            H[k] += o.H[k];
+        }
+        for(size_t k=0; k<6; k++)
+        {
+            g[k] += o.g[k];
+        }
+        n += o.n;
+        return *this;
+    }
+};
+
+void pointToPlaneBatched(
+    const MemoryView<Vector, RAM>& dataset,
+    const MemoryView<Vector, RAM>& model,
+    const MemoryView<Vector, RAM>& model_normals,
+    const MemoryView<uint8_t, RAM>& mask,
+    MemoryView<Transform, RAM>& Tcorr)
+{
+    check_sizes(dataset.size(), model.size(), mask.size(), Tcorr.size());
+    if(model_normals.size() != model.size())
+    {
+        RM_THROW(Exception, "Registration: normals differ in size.");
+    }
+    const size_t Nposes = Tcorr.size();
+    const size_t batchSize = dataset.size() / Nposes;
+
+    const Vector* d = dataset.raw();
+    const Vector* m = model.raw();
+    const Vector* nrm = model_normals.raw();
+    const uint8_t* w = mask.raw();
+
+    PointToPlaneSum zero;
+    std::fill(zero.H, zero.H + 21, 0.0);
+    std::fill(zero.g, zero.g + 6, 0.0);
+    zero.n = 0;
+
+    reduce_batched(Nposes, batchSize, zero,
+        [&](size_t id_b, size_t id_e) {
+            PointToPlaneSum s = zero;
+            for(size_t i=id_b; i<id_e; i++)
+            {
+                if(w[i] == 0)
+                {
+                    continue;
+                }
+                const Vector3_<double> di = d[i].cast<double>();
+                const Vector3_<double> ni = nrm[i].cast<double>();
+                const Vector3_<double> dxn = di.cross(ni);
+                const double J[6] = {dxn.x, dxn.y, dxn.z, ni.x, ni.y, ni.z};
+                const double r = ni.dot(di - m[i].cast<double>());
+
+                size_t k = 0;
+                for(size_t a=0; a<6; a++)
+                {
+                    for(size_t c=a; c<6; c++)
+                    {
+                        s.H[k++] += J[a] * J[c];
+                    }
+                    s.g[a] += J[a] * r;
+                }
+                s.n++;
+            }
+            return s;
+        },
+        [&](size_t b, const PointToPlaneSum& s) {
+            Transform T = Transform::Identity();
+            T.stamp = 0;
+            if(s.n >= 6)
+            {
+                Eigen::Matrix<double, 6, 6> H;
+                Eigen::Matrix<double, 6, 1> g;
+                size_t k = 0;
+                for(size_t a=0; a<6; a++)
+                {
+                    for(size_t c=a; c<6; c++)
+                    {
+                        H(a, c) = s.H[k];
+                        H(c, a) = s.H[k];
+                        k++;
+                    }
+                    g(a) = s.g[a];
+                }
+
+                const Eigen::LDLT<Eigen::Matrix<double, 6, 6> > ldlt(H);
+                if(ldlt.info() == Eigen::Success && ldlt.isPositive())
+                {
+                    const Eigen::Matrix<double, 6, 1> x = ldlt.solve(-g);
+                    
+                    // rotation: axis angle of the small angle solution
+                    const Eigen::Vector3d omega = x.head<3>();
+                    const double angle = omega.norm();
+                    if(angle > 1e-12)
+                    {
+                        const Eigen::Vector3d axis = omega / angle;
+                        const double sa = std::sin(angle / 2.0);
+                        T.R.x = axis.x() * sa;
+                        T.R.y = axis.y() * sa;
+                        T.R.z = axis.z() * sa;
+                        T.R.w = std::cos(angle / 2.0);
+                    }
+                    T.t = {static_cast<float>(x(3)), static_cast<float>(x(4)), static_cast<float>(x(5))};
+                }
+            }
+            Tcorr[b] = T;
+        });
+}
+
+Memory<Transform, RAM> pointToPlaneBatched(
+    const MemoryView<Vector, RAM>& dataset,
+    const MemoryView<Vector, RAM>& model,
+    const MemoryView<Vector, RAM>& model_normals,
+    const MemoryView<uint8_t, RAM>& mask,
+    unsigned int batchSize)
+{
+    Memory<Transform, RAM> Tcorr(dataset.size() / batchSize);
+    pointToPlaneBatched(dataset, model, model_normals, mask, Tcorr);
+    return Tcorr;
+}
+
+} // namespace rmagine
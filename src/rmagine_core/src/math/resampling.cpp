@@ -0,0 +1,292 @@
+#include "rmagine/math/resampling.h"
+#include "rmagine/math/primitives.h"
+#include "rmagine/util/exceptions.h"
+#include "reduce_batched.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace rmagine
+{
+
+struct MaxAcc
+{
+    double v;
+
+    MaxAcc& operator+=(const MaxAcc& o)
+    {
+        v = std::max(v, o.v);
+        return *this;
+    }
+};
+
+struct SumAcc
+{
+    double s;
+    double s2;
+
+    SumAcc& operator+=(const SumAcc& o)
+    {
+        s += o.s;
+        s2 += o.s2;
+        return *this;
+    }
+};
+
+// reduction of the whole buffer as one batch (blocked, pairwise -> deterministic)
+template<typename AccT, typename BlockFuncT>
+static AccT reduce_all(size_t N, const AccT& zero, BlockFuncT block_func)
+{
+    AccT res = zero;
+    reduce_batched(1, N, zero, block_func, 
+        [&](size_t, const AccT& acc) { res = acc; });
+    return res;
+}
+
+static double max_value(const MemoryView<float, RAM>& x)
+{
+    const float* p = x.raw();
+    return reduce_all(x.size(), MaxAcc{-std::numeric_limits<double>::infinity()},
+        [p](size_t id_b, size_t id_e) {
+            float m = -std::numeric_limits<float>::infinity();
+            #pragma omp simd reduction(max:m)
+            for(size_t i=id_b; i<id_e; i++)
+            {
+                m = std::max(m, p[i]);
+            }
+            return MaxAcc{m};
+        }).v;
+}
+
+static SumAcc sum_values(const MemoryView<float, RAM>& x, double offset, bool exponential)
+{
+    const float* p = x.raw();
+    return reduce_all(x.size(), SumAcc{0.0, 0.0},
+        [=](size_t id_b, size_t id_e) {
+            double s = 0.0, s2 = 0.0;
+            for(size_t i=id_b; i<id_e; i++)
+            {
+                const double v = exponential ? std::exp(p[i] - offset) : static_cast<double>(p[i]);
+                s += v;
+                s2 += v * v;
+            }
+            return SumAcc{s, s2};
+        });
+}
+
+double logSumExp(
+    const MemoryView<float, RAM>& log_weights)
+{
+    if(log_weights.size() == 0)
+    {
+        return -std::numeric_limits<double>::infinity();
+    }
+
+    const double m = max_value(log_weights);
+    if(!std::isfinite(m))
+    {
+        // all -inf (or any +inf)
+        return m;
+    }
+    return m + std::log(sum_values(log_weights, m, true).s);
+}
+
+double normalizeLogWeights(
+    const MemoryView<float, RAM>& log_weights,
+    MemoryView<float, RAM>& weights)
+{
+    if(weights.size() != log_weights.size())
+    {
+        RM_THROW(Exception, "normalizeLogWeights: sizes differ.");
+    }
+
+    const double lse = logSumExp(log_weights);
+    const float* lw = log_weights.raw();
+    float* w = weights.raw();
+
+    if(lse == -std::numeric_limits<double>::infinity())
+    {
+        // every weight is zero: exp(-inf - -inf) would be NaN. Nothing 
+        // prefers one sample over another -> uniform
+        const float uniform = 1.0f / static_cast<float>(weights.size());
+        #pragma omp parallel for schedule(static)
+        for(size_t i=0; i<weights.size(); i++)
+        {
+            w[i] = uniform;
+        }
+        return lse;
+    }
+
+    if(!std::isfinite(lse))
+    {
+        RM_THROW(Exception, "normalizeLogWeights: log weights contain +inf or NaN.");
+    }
+
+    #pragma omp parallel for schedule(static)
+    for(size_t i=0; i<weights.size(); i++)
+    {
+        w[i] = static_cast<float>(std::exp(lw[i] - lse));
+    }
+    return lse;
+}
+
+double normalizeWeights(
+    MemoryView<float, RAM>& weights)
+{
+    const double s = sum_values(weights, 0.0, false).s;
+    if(s > 0.0)
+    {
+        const float inv = static_cast<float>(1.0 / s);
+        float* w = weights.raw();
+
+        #pragma omp parallel for schedule(static)
+        for(size_t i=0; i<weights.size(); i++)
+        {
+            w[i] *= inv;
+        }
+    }
+    return s;
+}
+
+double effectiveSampleSize(
+    const MemoryView<float, RAM>& weights)
+{
+    const SumAcc acc = sum_values(weights, 0.0, false);
+    if(acc.s2 <= 0.0)
+    {
+        return 0.0;
+    }
+    return acc.s * acc.s / acc.s2;
+}
+
+// counter based uniform random number in [0, 1): independent of the thread layout
+static inline double uniform(uint64_t seed, uint64_t counter)
+{
+    // splitmix64
+    uint64_t z = seed + (counter + 1) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z = z ^ (z >> 31);
+    return static_cast<double>(z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// outputs j are placed at (j + U_j) / M on the CDF of the weights
+template<typename OffsetFuncT>
+static void resample(
+    const MemoryView<float, RAM>& weights,
+    MemoryView<unsigned int, RAM>& ancestors,
+    OffsetFuncT offset_func)
+{
+    const size_t N = weights.size();
+    const size_t M = ancestors.size();
+    if(N == 0)
+    {
+        if(M > 0)
+        {
+            RM_THROW(Exception, "resample: no particles to draw from.");
+        }
+        return;
+    }
+
+    // inclusive CDF in double
+    Memory<double, RAM> cdf(N);
+    const float* w = weights.raw();
+    #pragma omp parallel for schedule(static)
+    for(size_t i=0; i<N; i++)
+    {
+        cdf[i] = std::max(static_cast<double>(w[i]), 0.0);
+    }
+    const double total = inclusive_scan(cdf, cdf);
+    if(!(total > 0.0))
+    {
+        RM_THROW(Exception, "resample: sum of weights is not positive.");
+    }
+
+    // chunks of outputs: binary search for the start, then walk the CDF
+    const size_t chunk_size = 4096;
+    const size_t Nchunks = (M + chunk_size - 1) / chunk_size;
+    const double* c = cdf.raw();
+    unsigned int* a = ancestors.raw();
+
+    #pragma omp parallel for schedule(static)
+    for(size_t chunk=0; chunk<Nchunks; chunk++)
+    {
+        const size_t j_b = chunk * chunk_size;
+        const size_t j_e = std::min(M, j_b + chunk_size);
+
+        const double u_b = (static_cast<double>(j_b) + offset_func(j_b)) / static_cast<double>(M) * total;
+        size_t i = std::upper_bound(c, c + N, u_b) - c;
+
+        for(size_t j=j_b; j<j_e; j++)
+        {
+            const double u = (static_cast<double>(j) + offset_func(j)) / static_cast<double>(M) * total;
+            while(i < N - 1 && c[i] <= u)
+            {
+                i++;
+            }
+            a[j] = static_cast<unsigned int>(std::min(i, N - 1));
+        }
+    }
+}
+
+void resampleSystematic(
+    const MemoryView<float, RAM>& weights,
+    MemoryView<unsigned int, RAM>& ancestors,
+    uint64_t seed)
+{
+    const double U = uniform(seed, 0);
+    resample(weights, ancestors, [U](size_t) { return U; });
+}
+
+void resampleStratified(
+    const MemoryView<float, RAM>& weights,
+    MemoryView<unsigned int, RAM>& ancestors,
+    uint64_t seed)
+{
+    resample(weights, ancestors, [seed](size_t j) { return uniform(seed, j); });
+}
+
+void resampleSystematic(
+    const MemoryView<Transform, RAM>& particles,
+    const MemoryView<float, RAM>& weights,
+    MemoryView<Transform, RAM>& particles_out,
+    uint64_t seed)
+{
+    Memory<unsigned int, RAM> ancestors(particles_out.size());
+    resampleSystematic(weights, ancestors, seed);
+    gather(particles, ancestors, particles_out);
+}
+
+Memory<Transform, RAM> resampleSystematic(
+    const MemoryView<Transform, RAM>& particles,
+    const MemoryView<float, RAM>& weights,
+    uint64_t seed)
+{
+    Memory<Transform, RAM> particles_out(particles.size());
+    resampleSystematic(particles, weights, particles_out, seed);
+    return particles_out;
+}
+
+void resampleStratified(
+    const MemoryView<Transform, RAM>& particles,
+    const MemoryView<float, RAM>& weights,
+    MemoryView<Transform, RAM>& particles_out,
+    uint64_t seed)
+{
+    Memory<unsigned int, RAM> ancestors(particles_out.size());
+    resampleStratified(weights, ancestors, seed);
+    gather(particles, ancestors, particles_out);
+}
+
+Memory<Transform, RAM> resampleStratified(
+    const MemoryView<Transform, RAM>& particles,
+    const MemoryView<float, RAM>& weights,
+    uint64_t seed)
+{
+    Memory<Transform, RAM> particles_out(particles.size());
+    resampleStratified(particles, weights, particles_out, seed);
+    return particles_out;
+}
+
+} // namespace rmagine
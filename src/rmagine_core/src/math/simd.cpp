@@ -0,0 +1,277 @@
+#include "rmagine/math/simd.h"
+#include "rmagine/util/exceptions.h"
+
+#include "simd_kernels.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+namespace rmagine
+{
+namespace simd
+{
+
+RMAGINE_SIMD_DEFINE_KERNELS(scalar, float)
+
+// elements per parallel block
+static constexpr size_t SIMD_BLOCK_SIZE = 4096;
+
+Level detect()
+{
+    static const Level best = []() {
+        Level l = Level::SCALAR;
+        #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        #if defined(RMAGINE_SIMD_AVX2)
+        if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        {
+            l = Level::AVX2;
+        }
+        #endif // RMAGINE_SIMD_AVX2
+        #if defined(RMAGINE_SIMD_AVX512)
+        if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("fma"))
+        {
+            l = Level::AVX512;
+        }
+        #endif // RMAGINE_SIMD_AVX512
+        #endif
+        return l;
+    }();
+    return best;
+}
+
+static Level level_from_env()
+{
+    Level l = detect();
+    const char* env = std::getenv("RMAGINE_SIMD");
+    if(env != nullptr)
+    {
+        if(strcmp(env, "scalar") == 0)
+        {
+            l = std::min(l, Level::SCALAR);
+        } else if(strcmp(env, "avx2") == 0) {
+            l = std::min(l, Level::AVX2);
+        }
+    }
+    return l;
+}
+
+static std::atomic<Level>& current_level()
+{
+    static std::atomic<Level> l(level_from_env());
+    return l;
+}
+
+Level level()
+{
+    return current_level().load(std::memory_order_relaxed);
+}
+
+void setLevel(Level l)
+{
+    current_level().store(std::min(l, detect()), std::memory_order_relaxed);
+}
+
+const char* name(Level l)
+{
+    switch(l)
+    {
+        case Level::AVX512: return "avx512";
+        case Level::AVX2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+template<unsigned int KA, unsigned int KB, unsigned int KR>
+using KernelFunc = void(*)(
+    const Streams<KA>&, const Streams<KB>&, const Streams<KR>&, size_t, size_t);
+
+template<typename T>
+struct NonDeduced
+{
+    using type = T;
+};
+
+template<unsigned int KA, unsigned int KB, unsigned int KR>
+static void launch(
+    KernelFunc<KA, KB, KR> f_scalar,
+    typename NonDeduced<KernelFunc<KA, KB, KR> >::type f_avx2,
+    typename NonDeduced<KernelFunc<KA, KB, KR> >::type f_avx512,
+    const Streams<KA>& A, 
+    const Streams<KB>& B, 
+    const Streams<KR>& R,
+    size_t N)
+{
+    KernelFunc<KA, KB, KR> f = f_scalar;
+    #if defined(RMAGINE_SIMD_AVX512)
+    if(level() == Level::AVX512)
+    {
+        f = f_avx512;
+    }
+    #endif // RMAGINE_SIMD_AVX512
+    #if defined(RMAGINE_SIMD_AVX2)
+    if(level() == Level::AVX2)
+    {
+        f = f_avx2;
+    }
+    #endif // RMAGINE_SIMD_AVX2
+
+    const size_t Nblocks = (N + SIMD_BLOCK_SIZE - 1) / SIMD_BLOCK_SIZE;
+    #pragma omp parallel for schedule(static) if(Nblocks > 1)
+    for(size_t b=0; b<Nblocks; b++)
+    {
+        f(A, B, R, b * SIMD_BLOCK_SIZE, std::min(N, (b + 1) * SIMD_BLOCK_SIZE));
+    }
+}
+
+// kernels of instruction sets that were not compiled are never selected
+#if defined(RMAGINE_SIMD_AVX2)
+#define RMAGINE_SIMD_AVX2_KERNEL(KERNEL) avx2::KERNEL
+#else
+#define RMAGINE_SIMD_AVX2_KERNEL(KERNEL) nullptr
+#endif // RMAGINE_SIMD_AVX2
+
+#if defined(RMAGINE_SIMD_AVX512)
+#define RMAGINE_SIMD_AVX512_KERNEL(KERNEL) avx512::KERNEL
+#else
+#define RMAGINE_SIMD_AVX512_KERNEL(KERNEL) nullptr
+#endif // RMAGINE_SIMD_AVX512
+
+#define RMAGINE_SIMD_LAUNCH(KERNEL, A, B, R, N) \
+    launch(scalar::KERNEL, \
+        RMAGINE_SIMD_AVX2_KERNEL(KERNEL), \
+        RMAGINE_SIMD_AVX512_KERNEL(KERNEL), \
+        A, B, R, N)
+
+static size_t broadcast_size(size_t Na, size_t Nb, size_t Nr)
+{
+    const size_t N = (Na == 1 ? Nb : Na);
+    if((Na != 1 && Nb != 1 && Na != Nb) || Nr != N)
+    {
+        RM_THROW(Exception, "simd::mult - sizes of inputs and output do not match.");
+    }
+    return N;
+}
+
+template<typename T>
+static size_t stride(const MemoryView<T, RAM>& X, size_t floats)
+{
+    return (X.size() == 1 ? 0 : floats);
+}
+
+static VectorStreams streams(const MemoryView<Vector, RAM>& X)
+{
+    float* p = const_cast<float*>(&X.raw()->x);
+    return {{p, p + 1, p + 2}, stride(X, sizeof(Vector) / sizeof(float))};
+}
+
+static VectorStreams streams(const VectorSoAView& X)
+{
+    return {{X.x, X.y, X.z}, (X.size == 1 ? 0u : 1u)};
+}
+
+static QuaternionStreams streams(const MemoryView<Quaternion, RAM>& Q)
+{
+    float* p = const_cast<float*>(&Q.raw()->x);
+    return {{p, p + 1, p + 2, p + 3}, stride(Q, sizeof(Quaternion) / sizeof(float))};
+}
+
+static MatrixStreams streams(const MemoryView<Matrix3x3, RAM>& M)
+{
+    float* p = const_cast<float*>(&M.raw()->data[0][0]);
+    return {{p, p + 1, p + 2, p + 3, p + 4, p + 5, p + 6, p + 7, p + 8}, 
+        stride(M, sizeof(Matrix3x3) / sizeof(float))};
+}
+
+static TransformStreams streams(const MemoryView<Transform, RAM>& T)
+{
+    Transform* t = const_cast<Transform*>(T.raw());
+    return {{&t->R.x, &t->R.y, &t->R.z, &t->R.w, &t->t.x, &t->t.y, &t->t.z}, 
+        stride(T, sizeof(Transform) / sizeof(float))};
+}
+
+static_assert(sizeof(Vector) == 3 * sizeof(float), "simd: unexpected Vector layout");
+static_assert(sizeof(Quaternion) == 4 * sizeof(float), "simd: unexpected Quaternion layout");
+static_assert(sizeof(Matrix3x3) == 9 * sizeof(float), "simd: unexpected Matrix3x3 layout");
+static_assert(sizeof(Transform) % sizeof(float) == 0, "simd: unexpected Transform layout");
+
+/////////
+// AoS
+
+void mult(
+    const MemoryView<Quaternion, RAM>& Q,
+    const MemoryView<Vector, RAM>& X,
+    MemoryView<Vector, RAM>& Y)
+{
+    const size_t N = broadcast_size(Q.size(), X.size(), Y.size());
+    RMAGINE_SIMD_LAUNCH(mult_qv, streams(Q), streams(X), streams(Y), N);
+}
+
+void mult(
+    const MemoryView<Matrix3x3, RAM>& M,
+    const MemoryView<Vector, RAM>& X,
+    MemoryView<Vector, RAM>& Y)
+{
+    const size_t N = broadcast_size(M.size(), X.size(), Y.size());
+    RMAGINE_SIMD_LAUNCH(mult_mv, streams(M), streams(X), streams(Y), N);
+}
+
+void mult(
+    const MemoryView<Transform, RAM>& T,
+    const MemoryView<Vector, RAM>& X,
+    MemoryView<Vector, RAM>& Y)
+{
+    const size_t N = broadcast_size(T.size(), X.size(), Y.size());
+    RMAGINE_SIMD_LAUNCH(mult_tv, streams(T), streams(X), streams(Y), N);
+}
+
+void mult(
+    const MemoryView<Transform, RAM>& T1,
+    const MemoryView<Transform, RAM>& T2,
+    MemoryView<Transform, RAM>& Tr)
+{
+    const size_t N = broadcast_size(T1.size(), T2.size(), Tr.size());
+    RMAGINE_SIMD_LAUNCH(mult_tt, streams(T1), streams(T2), streams(Tr), N);
+
+    #pragma omp parallel for if(N > SIMD_BLOCK_SIZE)
+    for(size_t i=0; i<N; i++)
+    {
+        // same as Transform::mult: the stamp of T1
+        Tr[i].stamp = T1[T1.size() == 1 ? 0 : i].stamp;
+    }
+}
+
+/////////
+// SoA
+
+void mult(
+    const MemoryView<Quaternion, RAM>& Q,
+    const VectorSoAView& X,
+    const VectorSoAView& Y)
+{
+    const size_t N = broadcast_size(Q.size(), X.size, Y.size);
+    RMAGINE_SIMD_LAUNCH(mult_qv, streams(Q), streams(X), streams(Y), N);
+}
+
+void mult(
+    const MemoryView<Matrix3x3, RAM>& M,
+    const VectorSoAView& X,
+    const VectorSoAView& Y)
+{
+    const size_t N = broadcast_size(M.size(), X.size, Y.size);
+    RMAGINE_SIMD_LAUNCH(mult_mv, streams(M), streams(X), streams(Y), N);
+}
+
+void mult(
+    const MemoryView<Transform, RAM>& T,
+    const VectorSoAView& X,
+    const VectorSoAView& Y)
+{
+    const size_t N = broadcast_size(T.size(), X.size, Y.size);
+    RMAGINE_SIMD_LAUNCH(mult_tv, streams(T), streams(X), streams(Y), N);
+}
+
+} // namespace simd
+} // namespace rmagine
@@ -0,0 +1,12 @@
+// compiled with -mavx2 -mfma. Only called if the CPU supports it
+#include "simd_kernels.h"
+
+namespace rmagine
+{
+namespace simd
+{
+
+RMAGINE_SIMD_DEFINE_KERNELS(avx2, __m256)
+
+} // namespace simd
+} // namespace rmagine
@@ -0,0 +1,12 @@
+// compiled with -mavx512f -mfma. Only called if the CPU supports it
+#include "simd_kernels.h"
+
+namespace rmagine
+{
+namespace simd
+{
+
+RMAGINE_SIMD_DEFINE_KERNELS(avx512, __m512)
+
+} // namespace simd
+} // namespace rmagine
@@ -0,0 +1,283 @@
+#ifndef RMAGINE_MATH_SIMD_KERNELS_H
+#define RMAGINE_MATH_SIMD_KERNELS_H
+
+// Kernels of simd.h. This header is compiled once per instruction set 
+// (simd.cpp, simd_avx2.cpp, simd_avx512.cpp) with different compiler flags.
+// Everything except the entry points must stay in the anonymous namespace: 
+// otherwise the linker may pick e.g. an AVX-512 instance for the scalar path.
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__)
+// vector types as template arguments
+#pragma GCC diagnostic ignored "-Wignored-attributes"
+#endif
+
+namespace rmagine
+{
+namespace simd
+{
+
+/**
+ * Component k of element i is located at c[k][i * stride]
+ * - AoS: c = {&v[0].x, &v[0].y, &v[0].z}, stride = 3
+ * - SoA: c = {x, y, z}, stride = 1
+ * - stride 0: broadcast of a single element
+ */
+template<unsigned int K>
+struct Streams
+{
+    float* c[K];
+    size_t stride;
+};
+
+// Quaternion: x,y,z,w. Transform: qx,qy,qz,qw,tx,ty,tz. Matrix3x3: column-major
+using QuaternionStreams = Streams<4>;
+using MatrixStreams = Streams<9>;
+using TransformStreams = Streams<7>;
+using VectorStreams = Streams<3>;
+
+#define RMAGINE_SIMD_DECLARE_KERNELS(NS) \
+namespace NS { \
+void mult_qv(const QuaternionStreams& A, const VectorStreams& B, const VectorStreams& R, size_t begin, size_t end); \
+void mult_mv(const MatrixStreams& A, const VectorStreams& B, const VectorStreams& R, size_t begin, size_t end); \
+void mult_tv(const TransformStreams& A, const VectorStreams& B, const VectorStreams& R, size_t begin, size_t end); \
+void mult_tt(const TransformStreams& A, const TransformStreams& B, const TransformStreams& R, size_t begin, size_t end); \
+} 
+
+RMAGINE_SIMD_DECLARE_KERNELS(scalar)
+RMAGINE_SIMD_DECLARE_KERNELS(avx2)
+RMAGINE_SIMD_DECLARE_KERNELS(avx512)
+
+namespace 
+{
+
+template<typename V>
+struct Pack;
+
+template<>
+struct Pack<float>
+{
+    static constexpr size_t W = 1;
+
+    static inline float load(const float* p, size_t /*stride*/)
+    {
+        return *p;
+    }
+
+    static inline void store(float v, float* p, size_t /*stride*/)
+    {
+        *p = v;
+    }
+};
+
+#if defined(__AVX2__)
+template<>
+struct Pack<__m256>
+{
+    static constexpr size_t W = 8;
+
+    static inline __m256i index(size_t stride)
+    {
+        const int s = static_cast<int>(stride);
+        return _mm256_setr_epi32(0, s, 2 * s, 3 * s, 4 * s, 5 * s, 6 * s, 7 * s);
+    }
+
+    static inline __m256 load(const float* p, size_t stride)
+    {
+        if(stride == 0)
+        {
+            return _mm256_set1_ps(*p);
+        }
+        if(stride == 1)
+        {
+            return _mm256_loadu_ps(p);
+        }
+        return _mm256_i32gather_ps(p, index(stride), 4);
+    }
+
+    static inline void store(__m256 v, float* p, size_t stride)
+    {
+        if(stride == 1)
+        {
+            _mm256_storeu_ps(p, v);
+            return;
+        }
+        // no scatter in AVX2
+        alignas(32) float tmp[W];
+        _mm256_store_ps(tmp, v);
+        for(size_t l=0; l<W; l++)
+        {
+            p[l * stride] = tmp[l];
+        }
+    }
+};
+#endif // __AVX2__
+
+#if defined(__AVX512F__)
+template<>
+struct Pack<__m512>
+{
+    static constexpr size_t W = 16;
+
+    static inline __m512i index(size_t stride)
+    {
+        const int s = static_cast<int>(stride);
+        return _mm512_mullo_epi32(
+            _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), 
+            _mm512_set1_epi32(s));
+    }
+
+    static inline __m512 load(const float* p, size_t stride)
+    {
+        if(stride == 0)
+        {
+            return _mm512_set1_ps(*p);
+        }
+        if(stride == 1)
+        {
+            return _mm512_loadu_ps(p);
+        }
+        return _mm512_i32gather_ps(index(stride), p, 4);
+    }
+
+    static inline void store(__m512 v, float* p, size_t stride)
+    {
+        if(stride == 1)
+        {
+            _mm512_storeu_ps(p, v);
+            return;
+        }
+        _mm512_i32scatter_ps(p, index(stride), v, 4);
+    }
+};
+#endif // __AVX512F__
+
+// Operations on components. V is float or a vector register type
+// supporting the arithmetic operators (GCC/Clang vector extensions)
+
+struct QuaternionVectorOp
+{
+    template<typename V>
+    inline void operator()(const V* q, const V* v, V* r) const
+    {
+        // unit quaternion: t = 2 * (q_xyz x v), r = v + w * t + q_xyz x t
+        const V tx = (q[1] * v[2] - q[2] * v[1]) * 2.0f;
+        const V ty = (q[2] * v[0] - q[0] * v[2]) * 2.0f;
+        const V tz = (q[0] * v[1] - q[1] * v[0]) * 2.0f;
+        r[0] = v[0] + q[3] * tx + (q[1] * tz - q[2] * ty);
+        r[1] = v[1] + q[3] * ty + (q[2] * tx - q[0] * tz);
+        r[2] = v[2] + q[3] * tz + (q[0] * ty - q[1] * tx);
+    }
+};
+
+struct MatrixVectorOp
+{
+    template<typename V>
+    inline void operator()(const V* m, const V* v, V* r) const
+    {
+        // column-major: m[col * 3 + row]
+        r[0] = m[0] * v[0] + m[3] * v[1] + m[6] * v[2];
+        r[1] = m[1] * v[0] + m[4] * v[1] + m[7] * v[2];
+        r[2] = m[2] * v[0] + m[5] * v[1] + m[8] * v[2];
+    }
+};
+
+struct TransformVectorOp
+{
+    template<typename V>
+    inline void operator()(const V* T, const V* v, V* r) const
+    {
+        QuaternionVectorOp()(T, v, r);
+        r[0] = r[0] + T[4];
+        r[1] = r[1] + T[5];
+        r[2] = r[2] + T[6];
+    }
+};
+
+struct TransformTransformOp
+{
+    template<typename V>
+    inline void operator()(const V* T1, const V* T2, V* r) const
+    {
+        // R = R1 * R2, t = R1 * t2 + t1
+        r[0] = T1[3] * T2[0] + T1[0] * T2[3] + T1[1] * T2[2] - T1[2] * T2[1];
+        r[1] = T1[3] * T2[1] - T1[0] * T2[2] + T1[1] * T2[3] + T1[2] * T2[0];
+        r[2] = T1[3] * T2[2] + T1[0] * T2[1] - T1[1] * T2[0] + T1[2] * T2[3];
+        r[3] = T1[3] * T2[3] - T1[0] * T2[0] - T1[1] * T2[1] - T1[2] * T2[2];
+        TransformVectorOp()(T1, T2 + 4, r + 4);
+    }
+};
+
+template<typename V, typename OpT, unsigned int KA, unsigned int KB, unsigned int KR>
+inline void run(
+    const Streams<KA>& A, 
+    const Streams<KB>& B, 
+    const Streams<KR>& R, 
+    size_t begin, size_t end)
+{
+    const OpT op{};
+    constexpr size_t W = Pack<V>::W;
+
+    size_t i = begin;
+    for(; i + W <= end; i += W)
+    {
+        V a[KA], b[KB], r[KR];
+        for(unsigned int k=0; k<KA; k++)
+        {
+            a[k] = Pack<V>::load(A.c[k] + i * A.stride, A.stride);
+        }
+        for(unsigned int k=0; k<KB; k++)
+        {
+            b[k] = Pack<V>::load(B.c[k] + i * B.stride, B.stride);
+        }
+        op(a, b, r);
+        for(unsigned int k=0; k<KR; k++)
+        {
+            Pack<V>::store(r[k], R.c[k] + i * R.stride, R.stride);
+        }
+    }
+
+    // remainder
+    for(; i < end; i++)
+    {
+        float a[KA], b[KB], r[KR];
+        for(unsigned int k=0; k<KA; k++)
+        {
+            a[k] = A.c[k][i * A.stride];
+        }
+        for(unsigned int k=0; k<KB; k++)
+        {
+            b[k] = B.c[k][i * B.stride];
+        }
+        op(a, b, r);
+        for(unsigned int k=0; k<KR; k++)
+        {
+            R.c[k][i * R.stride] = r[k];
+        }
+    }
+}
+
+} // anonymous namespace
+
+#define RMAGINE_SIMD_DEFINE_KERNELS(NS, V) \
+namespace NS { \
+void mult_qv(const QuaternionStreams& A, const VectorStreams& B, const VectorStreams& R, size_t begin, size_t end) \
+{ run<V, QuaternionVectorOp>(A, B, R, begin, end); } \
+void mult_mv(const MatrixStreams& A, const VectorStreams& B, const VectorStreams& R, size_t begin, size_t end) \
+{ run<V, MatrixVectorOp>(A, B, R, begin, end); } \
+void mult_tv(const TransformStreams& A, const VectorStreams& B, const VectorStreams& R, size_t begin, size_t end) \
+{ run<V, TransformVectorOp>(A, B, R, begin, end); } \
+void mult_tt(const TransformStreams& A, const TransformStreams& B, const TransformStreams& R, size_t begin, size_t end) \
+{ run<V, TransformTransformOp>(A, B, R, begin, end); } \
+} 
+
+} // namespace simd
+} // namespace rmagine
+
+#endif // RMAGINE_MATH_SIMD_KERNELS_H
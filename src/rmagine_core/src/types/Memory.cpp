@@ -1,5 +1,145 @@
 #include "rmagine/types/Memory.hpp"
 
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
 namespace rmagine {
 
-} // namespace rmagine
\ No newline at end of file
+namespace {
+
+std::atomic<RamPlacement> g_placement{RamPlacement::DEFAULT};
+std::atomic<size_t> g_placement_min_bytes{16 * 1024 * 1024};
+
+size_t page_size()
+{
+#if defined(__linux__)
+    const long ret = sysconf(_SC_PAGESIZE);
+    if(ret > 0)
+    {
+        return ret;
+    }
+#endif
+    return 4096;
+}
+
+#if defined(__linux__)
+
+// from linux/mempolicy.h
+constexpr int RM_MPOL_INTERLEAVE = 3;
+
+/**
+ * @brief Bit mask of online NUMA nodes. Parsed from sysfs, e.g. "0-1,3"
+ */
+std::vector<unsigned long> numa_online_nodes()
+{
+    std::vector<unsigned long> mask;
+
+    std::ifstream f("/sys/devices/system/node/online");
+    std::string line;
+    if(!f || !std::getline(f, line))
+    {
+        return mask;
+    }
+
+    const size_t bits = sizeof(unsigned long) * 8;
+    std::stringstream ss(line);
+    std::string range;
+    while(std::getline(ss, range, ','))
+    {
+        size_t first, last;
+        const size_t sep = range.find('-');
+        try {
+            first = std::stoul(range.substr(0, sep));
+            last = (sep == std::string::npos) ? first : std::stoul(range.substr(sep + 1));
+        } catch(...) {
+            continue;
+        }
+
+        for(size_t node = first; node <= last; node++)
+        {
+            if(node / bits >= mask.size())
+            {
+                mask.resize(node / bits + 1, 0);
+            }
+            mask[node / bits] |= (1UL << (node % bits));
+        }
+    }
+
+    return mask;
+}
+
+void interleave_pages(void* mem, size_t bytes)
+{
+    static const std::vector<unsigned long> nodes = numa_online_nodes();
+    if(nodes.empty())
+    {
+        return;
+    }
+    // best effort: if the kernel does not support it, pages fall back to first touch
+    syscall(SYS_mbind, mem, bytes, RM_MPOL_INTERLEAVE, 
+        nodes.data(), nodes.size() * sizeof(unsigned long) * 8 + 1, 0);
+}
+
+#endif // defined(__linux__)
+
+} // anonymous namespace
+
+void RAM::setPlacement(RamPlacement placement, size_t min_bytes)
+{
+    g_placement_min_bytes = min_bytes;
+    g_placement = placement;
+}
+
+RamPlacement RAM::placement()
+{
+    return g_placement;
+}
+
+bool RAM::placed(size_t bytes)
+{
+    return g_placement != RamPlacement::DEFAULT 
+        && bytes > 0
+        && bytes >= g_placement_min_bytes;
+}
+
+void* RAM::allocPlaced(size_t bytes)
+{
+    const size_t page = page_size();
+    const size_t bytes_aligned = (bytes + page - 1) / page * page;
+
+    void* ret = nullptr;
+    if(posix_memalign(&ret, page, bytes_aligned) != 0)
+    {
+        return nullptr;
+    }
+
+#if defined(__linux__)
+    if(g_placement == RamPlacement::INTERLEAVE)
+    {
+        interleave_pages(ret, bytes_aligned);
+    }
+#endif
+
+    // first touch: one write per page. static schedule -> thread t 
+    // owns the same contiguous part of the buffer as in the simulators
+    volatile char* pages = static_cast<char*>(ret);
+    const long Npages = bytes_aligned / page;
+    #pragma omp parallel for schedule(static)
+    for(long i=0; i<Npages; i++)
+    {
+        pages[i * page] = 0;
+    }
+
+    return ret;
+}
+
+} // namespace rmagine
@@ -3,70 +3,6 @@
 namespace rmagine
 {
 
-SphericalModel vlp16_900()
-{
-    SphericalModel model;
-    model.theta.min = -M_PI;
-    model.theta.inc = (360.0 / 900.0) * DEG_TO_RAD_F;
-    model.theta.size = 900;
-
-    model.phi.min = -15.0 * DEG_TO_RAD_F;
-    model.phi.inc = 2.0 * DEG_TO_RAD_F;
-    model.phi.size = 16;
-    
-    model.range.min = 0.5;
-    model.range.max = 130.0;
-    return model;
-}
-
-SphericalModel vlp16_360()
-{
-    SphericalModel model;
-    model.theta.min = -M_PI;
-    model.theta.inc = 1.0 * DEG_TO_RAD_F;
-    model.theta.size = 360;
-
-    model.phi.min = -15.0 * DEG_TO_RAD_F;
-    model.phi.inc = 2.0 * DEG_TO_RAD_F;
-    model.phi.size = 16;
-    
-    model.range.min = 0.5;
-    model.range.max = 130.0;
-    return model;
-}
-
-
-SphericalModel example_spherical()
-{
-    SphericalModel model;
-    model.theta.min = -M_PI;
-    model.theta.inc = 0.4 * M_PI / 180.0;
-    model.theta.size = 900;
-    
-    model.phi.min = -15.0 * M_PI / 180.0;
-    model.phi.inc = 2.0 * M_PI / 180.0;
-    model.phi.size = 16;
-    
-    model.range.min = 0.0;
-    model.range.max = 100.0;
-
-    return model;
-}
-
-PinholeModel example_pinhole()
-{
-    PinholeModel model;
-    model.width = 200;
-    model.height = 150;
-    model.c[0] = 100.0; // ~ half of width
-    model.c[1] = 75.0; // ~ half of height
-    model.f[0] = 100.0;
-    model.f[1] = 100.0;
-    model.range.min = 0.0;
-    model.range.max = 100.0;
-    return model;
-}
-
 O1DnModel example_o1dn()
 {
     O1DnModel model;
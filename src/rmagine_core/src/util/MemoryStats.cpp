@@ -0,0 +1,285 @@
+#include "rmagine/util/MemoryStats.hpp"
+
+#include <mutex>
+#include <unordered_map>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+
+namespace rmagine
+{
+
+namespace {
+
+struct Allocation
+{
+    std::string mem_type;
+    std::string tag;
+    size_t bytes;
+};
+
+struct StatsState
+{
+    std::mutex mutex;
+    std::map<std::string, MemoryStatsEntry> by_mem_type;
+    std::map<std::pair<std::string, std::string>, MemoryStatsEntry> by_tag;
+    std::unordered_map<const void*, Allocation> live;
+    bool report_on_exit = false;
+};
+
+StatsState& state()
+{
+    // never destructed: Memory objects with static storage duration
+    // may still be freed after this translation unit is torn down
+    static StatsState* s = new StatsState;
+    return *s;
+}
+
+thread_local std::string t_tag;
+
+void add_bytes(MemoryStatsEntry& e, size_t bytes)
+{
+    e.live_bytes += bytes;
+    if(e.live_bytes > e.peak_bytes)
+    {
+        e.peak_bytes = e.live_bytes;
+    }
+}
+
+void sub_bytes(MemoryStatsEntry& e, size_t bytes)
+{
+    e.live_bytes -= std::min(e.live_bytes, bytes);
+}
+
+std::string format_bytes(size_t bytes)
+{
+    const char* units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+    double val = static_cast<double>(bytes);
+    unsigned int unit = 0;
+    while(val >= 1024.0 && unit < 4)
+    {
+        val /= 1024.0;
+        unit++;
+    }
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(unit > 0 ? 2 : 0) << val << " " << units[unit];
+    return ss.str();
+}
+
+void print_entry(std::ostream& os, const std::string& name, const MemoryStatsEntry& e)
+{
+    os << "- " << std::left << std::setw(30) << name
+       << " live: " << std::setw(12) << format_bytes(e.live_bytes)
+       << " peak: " << std::setw(12) << format_bytes(e.peak_bytes)
+       << " allocs: " << std::setw(8) << e.allocs
+       << " reallocs: " << std::setw(8) << e.reallocs
+       << " frees: " << e.frees << std::endl;
+}
+
+void report_at_exit()
+{
+    if(state().report_on_exit)
+    {
+        MemoryStats::report(std::cout);
+    }
+}
+
+// RMAGINE_MEMORY_STATS=1 enables the statistics at program start
+struct EnvInit
+{
+    EnvInit()
+    {
+        const char* env = std::getenv("RMAGINE_MEMORY_STATS");
+        if(env && std::strcmp(env, "0") != 0 && std::strlen(env) > 0)
+        {
+            MemoryStats::enable(true);
+        }
+    }
+};
+
+} // anonymous namespace
+
+std::atomic<bool> MemoryStats::s_enabled{false};
+
+static EnvInit env_init;
+
+void MemoryStats::enable(bool report_on_exit)
+{
+    StatsState& s = state();
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if(report_on_exit && !s.report_on_exit)
+        {
+            s.report_on_exit = true;
+            std::atexit(report_at_exit);
+        }
+    }
+    s_enabled = true;
+}
+
+void MemoryStats::disable()
+{
+    s_enabled = false;
+    StatsState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.report_on_exit = false;
+}
+
+void MemoryStats::reset()
+{
+    StatsState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.by_mem_type.clear();
+    s.by_tag.clear();
+    s.live.clear();
+}
+
+void MemoryStats::onAlloc(const char* mem_type, const void* ptr, size_t bytes)
+{
+    if(ptr == nullptr)
+    {
+        return;
+    }
+
+    StatsState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    MemoryStatsEntry& e_type = s.by_mem_type[mem_type];
+    MemoryStatsEntry& e_tag = s.by_tag[{mem_type, t_tag}];
+    e_type.allocs++;
+    e_tag.allocs++;
+    add_bytes(e_type, bytes);
+    add_bytes(e_tag, bytes);
+
+    s.live[ptr] = {mem_type, t_tag, bytes};
+}
+
+void MemoryStats::onRealloc(
+    const char* mem_type, 
+    const void* ptr_old, 
+    const void* ptr_new, 
+    size_t bytes)
+{
+    StatsState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    // a realloc is attributed to the tag active at the time of the realloc
+    MemoryStatsEntry& e_type = s.by_mem_type[mem_type];
+    MemoryStatsEntry& e_tag = s.by_tag[{mem_type, t_tag}];
+    e_type.reallocs++;
+    e_tag.reallocs++;
+
+    auto it = s.live.find(ptr_old);
+    if(it != s.live.end())
+    {
+        sub_bytes(e_type, it->second.bytes);
+        sub_bytes(s.by_tag[{it->second.mem_type, it->second.tag}], it->second.bytes);
+        s.live.erase(it);
+    }
+
+    if(ptr_new != nullptr)
+    {
+        add_bytes(e_type, bytes);
+        add_bytes(e_tag, bytes);
+        s.live[ptr_new] = {mem_type, t_tag, bytes};
+    }
+}
+
+void MemoryStats::onFree(const char* mem_type, const void* ptr)
+{
+    StatsState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    auto it = s.live.find(ptr);
+    if(it == s.live.end())
+    {
+        // allocated before recording started
+        return;
+    }
+
+    MemoryStatsEntry& e_type = s.by_mem_type[mem_type];
+    MemoryStatsEntry& e_tag = s.by_tag[{it->second.mem_type, it->second.tag}];
+    e_type.frees++;
+    e_tag.frees++;
+    sub_bytes(e_type, it->second.bytes);
+    sub_bytes(e_tag, it->second.bytes);
+    s.live.erase(it);
+}
+
+MemoryStatsEntry MemoryStats::get(const std::string& mem_type)
+{
+    StatsState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto it = s.by_mem_type.find(mem_type);
+    if(it == s.by_mem_type.end())
+    {
+        return MemoryStatsEntry();
+    }
+    return it->second;
+}
+
+MemoryStatsEntry MemoryStats::get(const std::string& mem_type, const std::string& tag)
+{
+    StatsState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto it = s.by_tag.find({mem_type, tag});
+    if(it == s.by_tag.end())
+    {
+        return MemoryStatsEntry();
+    }
+    return it->second;
+}
+
+std::map<std::string, MemoryStatsEntry> MemoryStats::byMemType()
+{
+    StatsState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.by_mem_type;
+}
+
+std::map<std::pair<std::string, std::string>, MemoryStatsEntry> MemoryStats::byTag()
+{
+    StatsState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.by_tag;
+}
+
+void MemoryStats::report(std::ostream& os)
+{
+    const auto mem_types = byMemType();
+    const auto tags = byTag();
+
+    os << "Rmagine Memory Statistics" << std::endl;
+    for(const auto& elem : mem_types)
+    {
+        print_entry(os, elem.first, elem.second);
+        for(const auto& tag_elem : tags)
+        {
+            if(tag_elem.first.first == elem.first)
+            {
+                const std::string& tag = tag_elem.first.second;
+                print_entry(os, "  " + (tag.empty() ? std::string("<untagged>") : tag), tag_elem.second);
+            }
+        }
+    }
+}
+
+MemoryStatsTag::MemoryStatsTag(const std::string& tag)
+:m_tag_before(t_tag)
+{
+    t_tag = tag;
+}
+
+MemoryStatsTag::~MemoryStatsTag()
+{
+    t_tag = m_tag_before;
+}
+
+const std::string& MemoryStatsTag::current()
+{
+    return t_tag;
+}
+
+} // namespace rmagine
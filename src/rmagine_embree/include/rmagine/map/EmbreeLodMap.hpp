@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief EmbreeLodMap
+ *
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_MAP_EMBREE_LOD_MAP_HPP
+#define RMAGINE_MAP_EMBREE_LOD_MAP_HPP
+
+#include "VersionedEmbreeMap.hpp"
+
+#include <rmagine/types/Memory.hpp>
+#include <rmagine/math/types.h>
+
+#include <vector>
+#include <mutex>
+
+namespace rmagine
+{
+
+struct EmbreeLodMapSettings
+{
+    /**
+     * @brief Tolerated geometric error per meter of distance to the closest pose. 
+     * The coarsest level with error <= error_budget * distance is selected. 
+     * 0 always selects the original meshes, larger values trade simulation 
+     * accuracy for speed.
+     */
+    float error_budget = 0.001;
+
+    /**
+     * @brief Settings of the top-level scene that instances the levels
+     */
+    EmbreeSceneSettings scene;
+};
+
+/**
+ * @brief Map that selects a level of detail for every mesh by its distance
+ * to the sensor poses.
+ * 
+ * Objects are the top-level meshes with levels of detail 
+ * (see make_embree_lods()) and the top-level instances of scenes that 
+ * contain such meshes. Every object is instanced once per level. Level k 
+ * of an instanced scene uses level k of each of its meshes, or the 
+ * coarsest one; its error grows with the instance's scale. update() swaps 
+ * the instances of objects whose level changes in a new version of the 
+ * top-level scene. All other geometries are added as they are.
+ * 
+ * @code
+ * EmbreeMapPtr map = import_embree_map("map.ply");
+ * make_embree_lods(map->scene, {0.01, 0.05, 0.2});
+ * 
+ * EmbreeLodMapPtr lod_map = std::make_shared<EmbreeLodMap>(map->scene);
+ * sim.setMap(lod_map);
+ * 
+ * // every cycle
+ * lod_map->update(Tbm);
+ * sim.simulate(Tbm, res);
+ * @endcode
+ */
+class EmbreeLodMap
+: public VersionedEmbreeMap
+{
+public:
+    /**
+     * @brief Starts with the original meshes
+     */
+    EmbreeLodMap(
+        EmbreeScenePtr scene,
+        EmbreeLodMapSettings settings = {});
+
+    ~EmbreeLodMap();
+
+    /**
+     * @brief Select the levels for the poses Tbm in the background
+     * 
+     * @return version with the selected levels
+     */
+    std::future<uint64_t> update(const MemoryView<Transform, RAM>& Tbm);
+
+    std::future<uint64_t> update(const Transform& Tbm);
+
+    inline EmbreeLodMapSettings settings() const
+    {
+        return m_settings;
+    }
+
+    /**
+     * @brief number of meshes and instances with levels of detail
+     */
+    size_t numObjects() const;
+
+    /**
+     * @brief selected level of every object. 0: original mesh
+     */
+    std::vector<unsigned int> levels() const;
+
+private:
+    struct Object
+    {
+        // in map coordinates
+        AABB bounds;
+        // error and instance of every level, level 0 is the original mesh
+        std::vector<float> errors;
+        std::vector<EmbreeInstancePtr> instances;
+    };
+
+    EmbreeScenePtr build(EmbreeMapPtr map, const Memory<Transform, RAM>& Tbm);
+
+    EmbreeLodMapSettings m_settings;
+    std::vector<Object> m_objects;
+
+    // written by the background thread only, read by levels()
+    mutable std::mutex m_levels_mutex;
+    std::vector<unsigned int> m_levels;
+};
+
+using EmbreeLodMapPtr = std::shared_ptr<EmbreeLodMap>;
+
+} // namespace rmagine
+
+#endif // RMAGINE_MAP_EMBREE_LOD_MAP_HPP
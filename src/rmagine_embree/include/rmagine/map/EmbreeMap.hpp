@@ -46,6 +46,7 @@
 
 #include <iostream>
 #include <vector>
+#include <limits>
 #include <set>
 #include <unordered_set>
 
@@ -62,6 +63,7 @@
 #include "embree/EmbreeScene.hpp"
 #include "embree/EmbreeMesh.hpp"
 #include "embree/EmbreeInstance.hpp"
+#include "embree/embree_cache.h"
 
 
 namespace rmagine 
@@ -76,6 +78,42 @@ public:
 
     Point closestPoint(const Point& qp);
 
+    /**
+     * @brief Closest point on the surface for a single point
+     * 
+     * @param context    point query contexts are not thread safe: one per thread
+     * @param max_radius only search within this radius around qp
+     * @return ClosestPointResult with geomID == RTC_INVALID_GEOMETRY_ID if nothing was found
+     */
+    ClosestPointResult closestPoint(
+        const Point& qp, 
+        RTCPointQueryContext& context,
+        float max_radius = std::numeric_limits<float>::max()) const;
+
+    /**
+     * @brief Closest points on the surface for a batch of points, in parallel
+     * 
+     * Fills every attribute of the bundle that has memory:
+     * - Hits: 1 if a surface was found within max_radius
+     * - Ranges: distance to the closest point
+     * - Points: closest points
+     * - Normals: normals of the closest faces
+     * - FaceIds, GeomIds, ObjectIds: ids of the closest faces
+     * 
+     * Misses get NaN points/normals, std::numeric_limits<float>::max() ranges 
+     * and invalid ids.
+     */
+    template<typename BundleT>
+    void closestPoints(
+        const MemoryView<Point, RAM>& qps,
+        BundleT& res,
+        float max_radius = std::numeric_limits<float>::max()) const;
+
+    template<typename BundleT>
+    BundleT closestPoints(
+        const MemoryView<Point, RAM>& qps,
+        float max_radius = std::numeric_limits<float>::max()) const;
+
     EmbreeDevicePtr device;
     EmbreeScenePtr scene;
 
@@ -90,10 +128,20 @@ public:
 
 using EmbreeMapPtr = std::shared_ptr<EmbreeMap>;
 
+/**
+ * @brief Import a map from any mesh file Assimp can read or from 
+ * a scene cache written by save_embree_scene() (see embree_cache.h).
+ * Scene caches are memory-mapped instead of parsed.
+ */
 static EmbreeMapPtr import_embree_map(
     const std::string& meshfile,
     EmbreeDevicePtr device = embree_default_device())
 {
+    if(is_embree_scene_cache(meshfile))
+    {
+        return std::make_shared<EmbreeMap>(load_embree_scene(meshfile, device));
+    }
+
     AssimpIO io;
 
     // aiProcess_GenNormals does not work!
@@ -125,4 +173,6 @@ static EmbreeMapPtr importEmbreeMap(
 
 } // namespace rmagine
 
+#include "EmbreeMap.tcc"
+
 #endif // RMAGINE_MAP_EMBREE_MAP_HPP
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "EmbreeMap.hpp"
+#include <rmagine/simulation/SimulationResults.hpp>
+#include <rmagine/simulation/embree_common.h>
+
+namespace rmagine
+{
+
+template<typename BundleT>
+void EmbreeMap::closestPoints(
+    const MemoryView<Point, RAM>& qps,
+    BundleT& res,
+    float max_radius) const
+{
+    SimulationFlags flags = SimulationFlags::Zero();
+    set_simulation_flags_<RAM>(res, flags);
+
+    #pragma omp parallel
+    {
+        // the context holds the instance stack of a query: one per thread
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+
+        #pragma omp for schedule(dynamic, 64)
+        for(size_t i = 0; i < qps.size(); i++)
+        {
+            const ClosestPointResult cp = closestPoint(qps[i], context, max_radius);
+            const bool found = (cp.geomID != RTC_INVALID_GEOMETRY_ID);
+
+            if constexpr(BundleT::template has<Hits<RAM> >())
+            {
+                if(flags.hits)
+                {
+                    res.Hits<RAM>::hits[i] = found;
+                }
+            }
+
+            if constexpr(BundleT::template has<Ranges<RAM> >())
+            {
+                if(flags.ranges)
+                {
+                    res.Ranges<RAM>::ranges[i] = cp.d;
+                }
+            }
+
+            if constexpr(BundleT::template has<Points<RAM> >())
+            {
+                if(flags.points)
+                {
+                    res.Points<RAM>::points[i] = (found ? cp.p : Point::NaN());
+                }
+            }
+
+            if constexpr(BundleT::template has<Normals<RAM> >())
+            {
+                if(flags.normals)
+                {
+                    res.Normals<RAM>::normals[i] = (found ? cp.n : Vector::NaN());
+                }
+            }
+
+            if constexpr(BundleT::template has<FaceIds<RAM> >())
+            {
+                if(flags.face_ids)
+                {
+                    res.FaceIds<RAM>::face_ids[i] = cp.primID;
+                }
+            }
+
+            if constexpr(BundleT::template has<GeomIds<RAM> >())
+            {
+                if(flags.geom_ids)
+                {
+                    res.GeomIds<RAM>::geom_ids[i] = cp.geomID;
+                }
+            }
+
+            if constexpr(BundleT::template has<ObjectIds<RAM> >())
+            {
+                if(flags.object_ids)
+                {
+                    // point queries are not supported for instances yet
+                    res.ObjectIds<RAM>::object_ids[i] = cp.geomID;
+                }
+            }
+        }
+    }
+}
+
+template<typename BundleT>
+BundleT EmbreeMap::closestPoints(
+    const MemoryView<Point, RAM>& qps,
+    float max_radius) const
+{
+    BundleT res;
+    resize_memory_bundle<RAM>(res, qps.size(), 1, 1);
+    closestPoints(qps, res, max_radius);
+    return res;
+}
+
+} // namespace rmagine
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief TiledEmbreeMap
+ *
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_MAP_TILED_EMBREE_MAP_HPP
+#define RMAGINE_MAP_TILED_EMBREE_MAP_HPP
+
+#include "VersionedEmbreeMap.hpp"
+
+#include <rmagine/types/Memory.hpp>
+#include <rmagine/math/types.h>
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+namespace rmagine
+{
+
+/**
+ * @brief Index of a tile in the xy-grid of a tiled map. 
+ * Tile (x, y) covers [x * tile_size, (x+1) * tile_size) x [y * tile_size, (y+1) * tile_size)
+ */
+struct TileId
+{
+    int32_t x;
+    int32_t y;
+
+    inline bool operator==(const TileId& o) const
+    {
+        return x == o.x && y == o.y;
+    }
+};
+
+struct TileIdHash
+{
+    inline size_t operator()(const TileId& id) const
+    {
+        return std::hash<uint64_t>()(
+            (static_cast<uint64_t>(static_cast<uint32_t>(id.x)) << 32) 
+            | static_cast<uint32_t>(id.y));
+    }
+};
+
+/**
+ * @brief Partition a scene into tiles of tile_size x tile_size meters (xy-plane) 
+ * and write them to a directory that can be opened by TiledEmbreeMap.
+ * 
+ * Every face goes to the tile of its centroid, so the geometry of a tile can 
+ * reach out of its square. The index stores the real bounds of every tile.
+ * Instances are flattened: 
+ * each tile contains plain meshes in map coordinates, one per source mesh 
+ * it overlaps. Every tile is a scene cache (see embree_cache.h), the directory 
+ * additionally contains an index file "tiles.idx".
+ * 
+ * @return number of written tiles
+ */
+size_t save_tiled_embree_map(
+    EmbreeScenePtr scene,
+    const std::string& directory,
+    float tile_size);
+
+struct TiledEmbreeMapSettings
+{
+    /**
+     * @brief Tiles whose geometry bounds are closer than range to any pose are loaded. 
+     * Should be the maximum range of the simulated sensors
+     */
+    float range = 100.0;
+
+    /**
+     * @brief Tiles that are not in range of the current poses are evicted, 
+     * least recently used first, as soon as the loaded tiles exceed this budget. 
+     * Tiles in range are never evicted.
+     * 
+     * The memory of a tile is approximated by the size of its file.
+     */
+    size_t memory_budget = 2ul * 1024 * 1024 * 1024;
+
+    /**
+     * @brief Settings of the top-level scene that instances the tiles
+     */
+    EmbreeSceneSettings scene;
+};
+
+/**
+ * @brief Out-of-core map: loads the tiles written by save_tiled_embree_map() 
+ * around the current poses and unloads distant ones.
+ * 
+ * Tiles are loaded on the background thread of VersionedEmbreeMap and 
+ * instanced into a new version of the top-level scene. Simulators use it 
+ * like every other versioned map:
+ * 
+ * @code
+ * TiledEmbreeMapPtr map = std::make_shared<TiledEmbreeMap>("tiles");
+ * SphereSimulatorEmbree sim;
+ * sim.setMap(map);
+ * 
+ * // every cycle
+ * map->update(Tbm);
+ * sim.simulate(Tbm, res);
+ * @endcode
+ * 
+ * Tiles that are still loading are missing in the current version. 
+ * Wait for the returned future if that is not acceptable.
+ */
+class TiledEmbreeMap
+: public VersionedEmbreeMap
+{
+public:
+    TiledEmbreeMap(
+        const std::string& directory,
+        TiledEmbreeMapSettings settings = {},
+        EmbreeDevicePtr device = embree_default_device());
+
+    ~TiledEmbreeMap();
+
+    /**
+     * @brief Request the tiles in range of the poses Tbm. 
+     * Loading, evicting and rebuilding the top-level scene are done in the background.
+     * 
+     * @return version that contains all tiles in range of Tbm
+     */
+    std::future<uint64_t> update(const MemoryView<Transform, RAM>& Tbm);
+
+    std::future<uint64_t> update(const Transform& Tbm);
+
+    inline TiledEmbreeMapSettings settings() const
+    {
+        return m_settings;
+    }
+
+    inline float tileSize() const
+    {
+        return m_tile_size;
+    }
+
+    TileId tileId(const Vector& p) const;
+
+    /**
+     * @brief number of tiles on disk
+     */
+    size_t numTiles() const;
+
+    /**
+     * @brief number of loaded tiles, including the ones of a version that is 
+     * about to be swapped in
+     */
+    size_t numLoadedTiles() const;
+
+    /**
+     * @brief approximate memory of the loaded tiles in bytes
+     */
+    size_t loadedBytes() const;
+
+private:
+    struct TileFile
+    {
+        std::string filename;
+        size_t bytes;
+        // bounds of the geometry, can exceed the tile's square
+        AABB bounds;
+    };
+
+    struct LoadedTile
+    {
+        EmbreeInstancePtr instance;
+        size_t bytes;
+        uint64_t last_used;
+    };
+
+    std::vector<TileId> tilesInRange(const MemoryView<Transform, RAM>& Tbm) const;
+
+    EmbreeScenePtr build(EmbreeMapPtr map, const std::vector<TileId>& tiles);
+
+    std::string m_directory;
+    TiledEmbreeMapSettings m_settings;
+    EmbreeDevicePtr m_device;
+
+    float m_tile_size;
+    // largest distance any tile's bounds reach out of its square in xy
+    float m_overhang;
+    std::unordered_map<TileId, TileFile, TileIdHash> m_files;
+
+    // written by the background thread only, read by the getters
+    mutable std::mutex m_loaded_mutex;
+    std::unordered_map<TileId, LoadedTile, TileIdHash> m_loaded;
+    size_t m_loaded_bytes = 0;
+    uint64_t m_clock = 0;
+};
+
+using TiledEmbreeMapPtr = std::shared_ptr<TiledEmbreeMap>;
+
+} // namespace rmagine
+
+#endif // RMAGINE_MAP_TILED_EMBREE_MAP_HPP
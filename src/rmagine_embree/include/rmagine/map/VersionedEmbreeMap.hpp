@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief VersionedEmbreeMap
+ *
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_MAP_VERSIONED_EMBREE_MAP_HPP
+#define RMAGINE_MAP_VERSIONED_EMBREE_MAP_HPP
+
+#include "EmbreeMap.hpp"
+
+#include <memory>
+#include <functional>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <chrono>
+
+namespace rmagine
+{
+
+/**
+ * @brief Sequence of map versions. New versions are built on a background 
+ * thread and swapped in atomically.
+ * 
+ * Readers take the current version with current() and keep it as long as 
+ * they need it. A version is never changed after it was swapped in, so 
+ * readers never wait for or race with a BVH build. Old versions are 
+ * destroyed by the background thread after their last reader released them.
+ * 
+ * Simulators take the current version at the beginning of every simulate call
+ * if they were given a VersionedEmbreeMap via setMap().
+ * 
+ * @code
+ * VersionedEmbreeMapPtr maps = std::make_shared<VersionedEmbreeMap>(import_embree_map("map.ply"));
+ * sim.setMap(maps);
+ * 
+ * // perception thread
+ * maps->update([obstacle](EmbreeMapPtr map) {
+ *     EmbreeScenePtr scene = map->scene->copy();
+ *     scene->add(obstacle);
+ *     scene->commit();
+ *     return scene;
+ * });
+ * @endcode
+ */
+class VersionedEmbreeMap
+{
+public:
+    /**
+     * @brief Builds the next version from the current one. 
+     * 
+     * Must return a new, committed scene and must not change the scene of the 
+     * current version: it may be traversed meanwhile. See EmbreeScene::copy()
+     * Returning the scene of the given map keeps the current version.
+     */
+    using Builder = std::function<EmbreeScenePtr(EmbreeMapPtr)>;
+
+    VersionedEmbreeMap(EmbreeMapPtr map);
+
+    /**
+     * @brief waits for all pending builds
+     */
+    ~VersionedEmbreeMap();
+
+    /**
+     * @brief The current version. Holding it keeps it alive and unchanged
+     */
+    EmbreeMapPtr current() const;
+
+    /**
+     * @brief Number of the current version. The initial map is version 0
+     */
+    uint64_t version() const;
+
+    /**
+     * @brief Build the next version on the background thread. 
+     * Builds are executed one after another in the order of the calls.
+     * 
+     * @return version number the new map got. Exceptions of the builder are 
+     *   passed to the future, the current version stays.
+     */
+    std::future<uint64_t> update(Builder builder);
+
+    /**
+     * @brief Swap in a map that was built elsewhere. 
+     * The map must not share geometries with a build running at the same time
+     * 
+     * @return version number of the map
+     */
+    uint64_t swap(EmbreeMapPtr map);
+
+    /**
+     * @brief Block until all pending builds are swapped in
+     */
+    void wait();
+
+private:
+
+    void work();
+
+    /**
+     * @brief Destroy retired versions that have no readers left. 
+     * 
+     * Versions share geometries, and destroying a scene changes the parents 
+     * of its geometries. Doing it on the worker thread keeps it from racing 
+     * with builds, which change the parents of the same geometries.
+     */
+    void release();
+
+    mutable std::mutex m_current_mutex;
+    EmbreeMapPtr m_current;
+    uint64_t m_version = 0;
+    // swapped out, possibly still used by readers
+    std::vector<EmbreeMapPtr> m_retired;
+
+    struct Task
+    {
+        Builder builder;
+        std::promise<uint64_t> promise;
+    };
+
+    std::mutex m_tasks_mutex;
+    std::condition_variable m_tasks_cv;
+    std::condition_variable m_idle_cv;
+    std::deque<Task> m_tasks;
+    bool m_busy = false;
+    bool m_stop = false;
+
+    std::thread m_worker;
+};
+
+using VersionedEmbreeMapPtr = std::shared_ptr<VersionedEmbreeMap>;
+
+/**
+ * @brief The map a simulator uses for one call: the current version of 
+ * versions if set, map otherwise
+ */
+inline EmbreeMapPtr current_map(
+    const EmbreeMapPtr& map, 
+    const VersionedEmbreeMapPtr& versions)
+{
+    return (versions ? versions->current() : map);
+}
+
+} // namespace rmagine
+
+#endif // RMAGINE_MAP_VERSIONED_EMBREE_MAP_HPP
@@ -51,6 +51,7 @@
 
 #include <rmagine/math/types.h>
 #include <rmagine/math/linalg.h>
+#include <rmagine/types/mesh_types.h>
 
 namespace rmagine
 {
@@ -65,14 +66,33 @@ struct ClosestPointResult
 
     float d;
     Point p;
+    // face normal
+    Vector n;
     unsigned int primID;
     unsigned int geomID;
 };
 
+/**
+ * @brief Raw buffers of a geometry for the point query callbacks.
+ * 
+ * faces == nullptr: geometry is not a mesh
+ */
+struct PointQueryGeometry
+{
+    const Face* faces = nullptr;
+    const Vertex* vertices = nullptr;
+};
+
 struct PointQueryUserData 
 {
-    EmbreeScenePtr* scene;
+    const EmbreeScenePtr* scene;
+    // indexed by geometry id. See EmbreeScene::pointQueryGeometries()
+    const PointQueryGeometry* geometries;
+    unsigned int num_geometries;
     ClosestPointResult* result;
+    // set by the callback if a candidate geometry is no mesh of the last commit.
+    // The callback runs per candidate and never reports itself
+    unsigned int unsupported_geomID = RTC_INVALID_GEOMETRY_ID;
 };
 
 
@@ -86,8 +106,14 @@ public:
 
     // embree fields
     void setQuality(RTCBuildQuality quality);
+    RTCBuildQuality quality() const;
     RTCGeometry handle() const;
 
+    inline EmbreeDevicePtr device() const 
+    {
+        return m_device;
+    }
+
     void setTransform(const Transform& T);
     Transform transform() const;
 
@@ -157,6 +183,11 @@ protected:
 
     Transform m_T;
     Vector3 m_S;
+
+    RTCBuildQuality m_quality = RTC_BUILD_QUALITY_MEDIUM;
+
+    // transform or scale changed since the last apply()
+    bool m_transform_changed = true;
 };
 
 } // namespace rmagine
@@ -50,6 +50,7 @@
 #include <rmagine/types/mesh_types.h>
 
 #include <memory>
+#include <vector>
 
 // #include <boost/function.hpp>
 #include <embree4/rtcore.h>
@@ -60,7 +61,15 @@
 namespace rmagine
 {
 
-
+/**
+ * @brief Simplified version of a mesh. See embree_lod.h
+ */
+struct EmbreeMeshLod
+{
+    // maximum distance of the simplified surface to the original one
+    float error;
+    EmbreeMeshPtr mesh;
+};
 
 /**
  * @brief EmbreeMesh
@@ -90,26 +99,64 @@ public:
     void init(unsigned int Nvertices, unsigned int Nfaces);
     void init(const aiMesh* amesh);
 
+    /**
+     * @brief Initialize on external buffers without copying them, e.g. a 
+     * memory-mapped scene cache (see embree_cache.h). 
+     * 
+     * Faces and vertices are shared with Embree directly, which reads 
+     * up to 16 bytes after the last vertex: the vertex buffer must be padded.
+     * The transform is reset to identity. The first apply() with another 
+     * transform moves the transformed data to own buffers.
+     * 
+     * @param vertex_normals  can be empty
+     * @param holder          keeps the buffers alive as long as the mesh uses them
+     */
+    void init(
+        MemoryView<Vertex, RAM> vertices,
+        MemoryView<Face, RAM> faces,
+        MemoryView<Vector, RAM> face_normals,
+        MemoryView<Vector, RAM> vertex_normals,
+        std::shared_ptr<void> holder);
+
     void initVertexNormals();
 
     bool closestPointFunc2(RTCPointQueryFunctionArguments* args);
 
     // PUBLIC ATTRIBUTES
-    MemoryView<Face, RAM> faces() const;
-    MemoryView<Vertex, RAM> vertices() const;
-    MemoryView<Vector, RAM> vertexNormals() const;
-    MemoryView<Vector, RAM> faceNormals() const;
+    // Writable access marks the whole buffer as changed for the next apply().
+    // Use the const versions for reading and setVertices() for partial updates
+    MemoryView<Face, RAM> faces();
+    MemoryView<Vertex, RAM> vertices();
+    MemoryView<Vector, RAM> vertexNormals();
+    MemoryView<Vector, RAM> faceNormals();
+
+    MemoryView<const Face, RAM> faces() const;
+    MemoryView<const Vertex, RAM> vertices() const;
+    MemoryView<const Vector, RAM> vertexNormals() const;
+    MemoryView<const Vector, RAM> faceNormals() const;
+
+    /**
+     * @brief Overwrite the vertices [offset, offset + vertices.size()).
+     * The next apply() only updates these vertices and the normals of their faces
+     */
+    void setVertices(
+        const MemoryView<Vertex, RAM>& vertices, 
+        unsigned int offset = 0);
     
     MemoryView<const Vertex, RAM> verticesTransformed() const;
-    
-    
-    
+    MemoryView<const Vector, RAM> faceNormalsTransformed() const;
+    MemoryView<const Vector, RAM> vertexNormalsTransformed() const;
+
 
     void computeFaceNormals();
 
     /**
-     * @brief Apply new Transform and Scale to buffers
+     * @brief Apply changes of transform, scale, vertices and normals to the buffers.
      * 
+     * Only changed data is updated: 
+     * - new transform or scale: all vertices and normals
+     * - setVertices(): the changed vertices and the normals of their faces
+     * - nothing changed: nothing to do
      */
     void apply();
 
@@ -118,6 +165,11 @@ public:
         return EmbreeGeometryType::MESH;
     }
 
+    /**
+     * @brief levels of detail, ascending error. 
+     * Filled by make_embree_lods(), selected by EmbreeLodMap
+     */
+    std::vector<EmbreeMeshLod> lods;
 
     // embree constructed buffers
 protected:
@@ -137,6 +189,23 @@ private:
     Memory<Vector, RAM> m_face_normals_transformed;
     Memory<Vector, RAM> m_vertex_normals_transformed;
 
+    void markVerticesChanged(unsigned int begin, unsigned int end);
+
+    /**
+     * @brief face ids of every vertex (CSR). Built on demand
+     */
+    void updateVertexFaces();
+
+    // changes since the last apply()
+    unsigned int m_vertices_changed_begin = 0;
+    unsigned int m_vertices_changed_end = 0;
+    bool m_normals_changed = true;
+    bool m_faces_changed = true;
+
+    // faces of vertex i: m_vertex_faces[m_vertex_faces_offsets[i] : m_vertex_faces_offsets[i+1]]
+    Memory<unsigned int, RAM> m_vertex_faces_offsets;
+    Memory<unsigned int, RAM> m_vertex_faces;
+
     // boost::function<bool (RTCPointQueryFunctionArguments*)> m_closest_point_func;
     RTCPointQueryFunction* m_closest_point_func_raw;
 
@@ -43,11 +43,13 @@
 
 #include "embree_definitions.h"
 #include "EmbreeDevice.hpp"
+#include "EmbreeGeometry.hpp"
 
 #include <embree4/rtcore.h>
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 #include <optional>
 #include <assimp/scene.h>
 
@@ -98,6 +100,11 @@ public:
 
     void setFlags(RTCSceneFlags flags);
 
+    inline EmbreeSceneSettings settings() const
+    {
+        return m_settings;
+    }
+
     unsigned int add(EmbreeGeometryPtr geom);
     std::optional<unsigned int> getOpt(const EmbreeGeometryPtr geom) const;
     std::optional<unsigned int> getOpt(const std::shared_ptr<const EmbreeGeometry> geom) const;
@@ -126,8 +133,28 @@ public:
 
     void commit();
 
+    /**
+     * @brief Flat table of geometry buffers indexed by geometry id, rebuilt on commit.
+     * 
+     * Used by the point query callbacks instead of looking up and casting the 
+     * geometry for every candidate primitive
+     */
+    inline const std::vector<PointQueryGeometry>& pointQueryGeometries() const
+    {
+        return m_pq_geometries;
+    }
+
     EmbreeInstancePtr instantiate();
 
+    /**
+     * @brief Shallow copy: a new, uncommitted scene with the same settings 
+     * and the same geometries under the same ids. 
+     * 
+     * Geometries are shared, not copied: changing one changes both scenes. 
+     * Adding and removing geometries only affects the copy.
+     */
+    EmbreeScenePtr copy() const;
+
     /**
      * @brief find all leaf geometries recursively
      * 
@@ -167,6 +194,19 @@ public:
      */
     void freeze();
 
+    /**
+     * @brief Counterpart of freeze() for rigidly moving objects: replaces a mesh 
+     * of this scene by an instance that takes over the mesh's transform and scale.
+     * 
+     * Moving the instance afterwards only changes a transform of the top-level
+     * scene, instead of rewriting all vertices and rebuilding the BVH of the mesh.
+     * The geometry id of the object can change.
+     * 
+     * @return the new instance. nullptr if the mesh is not part of this scene 
+     *   or is shared with other scenes
+     */
+    EmbreeInstancePtr makeRigid(EmbreeMeshPtr mesh);
+
     inline EmbreeDevicePtr device() const 
     {
         return m_device;
@@ -181,6 +221,10 @@ private:
 
     bool m_committed_once = false;
 
+    EmbreeSceneSettings m_settings;
+
+    std::vector<PointQueryGeometry> m_pq_geometries;
+
     RTCScene m_scene;
     EmbreeDevicePtr m_device;
 };
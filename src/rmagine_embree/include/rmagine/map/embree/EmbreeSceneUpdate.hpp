@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief EmbreeSceneUpdate
+ *
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_MAP_EMBREE_SCENE_UPDATE_HPP
+#define RMAGINE_MAP_EMBREE_SCENE_UPDATE_HPP
+
+#include "embree_definitions.h"
+#include "EmbreeScene.hpp"
+#include "EmbreeMesh.hpp"
+
+#include <rmagine/math/types.h>
+#include <rmagine/types/Memory.hpp>
+
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <optional>
+
+namespace rmagine
+{
+
+/**
+ * @brief Time in seconds of every phase of EmbreeSceneUpdate::commit()
+ */
+struct EmbreeSceneUpdateTimings
+{
+    // writing transforms and vertices to the buffers
+    double apply = 0.0;
+    // rtcCommitGeometry of the changed geometries
+    double commit_geometries = 0.0;
+    // rtcCommitScene of every affected scene, i.e. the BVH builds
+    double commit_scenes = 0.0;
+    double total = 0.0;
+};
+
+/**
+ * @brief Gathers changes of many geometries of a scene and applies them at once.
+ * 
+ * commit() applies and commits all changed geometries in parallel. Then 
+ * every affected scene is committed once, children before parents.
+ * 
+ * Deformations that keep the topology (new transforms or vertices of meshes) 
+ * are committed with RTC_BUILD_QUALITY_REFIT: the BVH of the mesh is refitted 
+ * instead of rebuilt. A refitted BVH gets worse with every refit, so a mesh
+ * is rebuilt at its own quality after max_refits refits. Keep the update object 
+ * alive between the transactions for this counting.
+ * 
+ * For high update rates use a scene with RTC_SCENE_FLAG_DYNAMIC and 
+ * RTC_BUILD_QUALITY_LOW.
+ * 
+ * @code
+ * EmbreeSceneUpdate update(scene);
+ * for(auto obj : obstacles)
+ * {
+ *     update.setTransform(obj, T_obj);
+ * }
+ * EmbreeSceneUpdateTimings timings = update.commit();
+ * @endcode
+ */
+class EmbreeSceneUpdate
+{
+public:
+    EmbreeSceneUpdate(
+        EmbreeScenePtr scene,
+        unsigned int max_refits = 16);
+
+    void setTransform(EmbreeGeometryPtr geom, const Transform& T);
+
+    void setScale(EmbreeGeometryPtr geom, const Vector3& S);
+
+    /**
+     * @brief Overwrite the vertices [offset, offset + vertices.size()) of a mesh.
+     * The vertices are copied.
+     */
+    void setVertices(
+        EmbreeMeshPtr mesh, 
+        const MemoryView<Vertex, RAM>& vertices, 
+        unsigned int offset = 0);
+
+    /**
+     * @brief Geometry was changed directly. It is applied and committed 
+     * with the others
+     * 
+     * @param topology_changed  faces were changed: the BVH of the geometry is rebuilt
+     */
+    void touch(EmbreeGeometryPtr geom, bool topology_changed = false);
+
+    inline EmbreeScenePtr scene() const
+    {
+        return m_scene;
+    }
+
+    /**
+     * @brief number of refits of a geometry since its last rebuild
+     */
+    unsigned int refits(EmbreeGeometryPtr geom) const;
+
+    /**
+     * @brief number of geometries with pending changes
+     */
+    size_t size() const;
+
+    /**
+     * @brief Apply all pending changes and commit the scene
+     */
+    EmbreeSceneUpdateTimings commit();
+
+    /**
+     * @brief Timings of the last commit
+     */
+    inline EmbreeSceneUpdateTimings timings() const
+    {
+        return m_timings;
+    }
+
+private:
+
+    struct Change
+    {
+        std::optional<Transform> T;
+        std::optional<Vector3> S;
+        std::vector<std::pair<unsigned int, Memory<Vertex, RAM> > > vertices;
+        bool topology_changed = false;
+    };
+
+    Change& change(EmbreeGeometryPtr geom);
+
+    EmbreeScenePtr m_scene;
+    unsigned int m_max_refits;
+
+    // insertion order is kept for deterministic processing
+    std::vector<EmbreeGeometryPtr> m_geometries;
+    std::unordered_map<EmbreeGeometryPtr, Change> m_changes;
+
+    // refits since the last rebuild
+    std::unordered_map<EmbreeGeometryWPtr, unsigned int> m_refits;
+
+    EmbreeSceneUpdateTimings m_timings;
+};
+
+using EmbreeSceneUpdatePtr = std::shared_ptr<EmbreeSceneUpdate>;
+
+} // namespace rmagine
+
+#endif // RMAGINE_MAP_EMBREE_SCENE_UPDATE_HPP
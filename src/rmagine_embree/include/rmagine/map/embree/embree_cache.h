@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief Binary cache of EmbreeScenes that is loaded via memory mapping
+ * 
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_MAP_EMBREE_CACHE_H
+#define RMAGINE_MAP_EMBREE_CACHE_H
+
+#include "EmbreeDevice.hpp"
+#include "EmbreeScene.hpp"
+
+#include <string>
+
+namespace rmagine
+{
+
+/**
+ * @brief Write a scene and everything it instances to a binary cache file.
+ * 
+ * Stored are the vertex, index and normal buffers of every mesh, instance
+ * transforms, names and the build settings of every scene. Mesh transforms
+ * are baked into the vertices. Meshes and scenes that are instanced several 
+ * times are written once. Geometries other than meshes and instances are skipped.
+ * 
+ * The file is written for the byte order of this machine.
+ */
+void save_embree_scene(
+    EmbreeScenePtr scene, 
+    const std::string& filename);
+
+/**
+ * @brief Load a scene from a cache file written by save_embree_scene().
+ * 
+ * The file is memory-mapped and its mesh buffers are shared with Embree 
+ * without copying, so only the BVHs are built at load time. Pages are 
+ * mapped copy-on-write: changing the meshes never modifies the file.
+ * 
+ * Geometry ids are assigned in the order of the original ids.
+ * 
+ * @return committed scene
+ */
+EmbreeScenePtr load_embree_scene(
+    const std::string& filename,
+    EmbreeDevicePtr device = embree_default_device());
+
+/**
+ * @brief true if the file starts like a scene cache written by save_embree_scene()
+ */
+bool is_embree_scene_cache(const std::string& filename);
+
+} // namespace rmagine
+
+#endif // RMAGINE_MAP_EMBREE_CACHE_H
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief Levels of detail for EmbreeMesh
+ *
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_MAP_EMBREE_LOD_H
+#define RMAGINE_MAP_EMBREE_LOD_H
+
+#include "EmbreeMesh.hpp"
+#include "EmbreeScene.hpp"
+
+#include <vector>
+
+namespace rmagine
+{
+
+/**
+ * @brief Simplify a mesh by quadric error edge collapses (Garland and Heckbert).
+ * 
+ * Edges are collapsed cheapest first until the next collapse would move the 
+ * surface by more than max_error. The error of a vertex is bounded by the 
+ * root of its summed squared distances to the planes of the original faces 
+ * it replaces. Mesh borders are constrained by planes perpendicular to their 
+ * faces, so they stay within max_error as well. Collapses that flip a face 
+ * or make the mesh non-manifold are rejected.
+ * 
+ * Name, transform and scale are copied, vertex normals are not.
+ * 
+ * @param error  if given, the largest error of all applied collapses
+ * @return applied, uncommitted mesh
+ */
+EmbreeMeshPtr simplify_mesh(
+    EmbreeMeshConstPtr mesh, 
+    float max_error,
+    float* error = nullptr);
+
+/**
+ * @brief Replace mesh->lods by one simplified mesh per maximum error. 
+ * Levels are simplified from the original mesh in parallel. Levels that 
+ * remove no more faces than the previous one are dropped.
+ * 
+ * @param max_errors positive and strictly ascending. Throws otherwise
+ */
+void make_embree_lods(
+    EmbreeMeshPtr mesh,
+    const std::vector<float>& max_errors);
+
+/**
+ * @brief make_embree_lods() for every mesh EmbreeLodMap can select levels for: 
+ * the meshes of the scene and of the scenes it instances directly. Meshes of 
+ * deeper nested instances are left as they are. 
+ * All meshes and levels are simplified in parallel.
+ */
+void make_embree_lods(
+    EmbreeScenePtr scene,
+    const std::vector<float>& max_errors);
+
+} // namespace rmagine
+
+#endif // RMAGINE_MAP_EMBREE_LOD_H
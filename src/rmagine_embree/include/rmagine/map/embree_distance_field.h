@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026, University Osnabrück
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University Osnabrück nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL University Osnabrück BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * 
+ * @brief Build sparse distance fields from EmbreeMaps
+ * 
+ * @date 19.10.2026
+ * @author Alexander Mock
+ * 
+ * @copyright Copyright (c) 2026, University Osnabrück. All rights reserved.
+ * This project is released under the 3-Clause BSD License.
+ * 
+ */
+
+#ifndef RMAGINE_MAP_EMBREE_DISTANCE_FIELD_H
+#define RMAGINE_MAP_EMBREE_DISTANCE_FIELD_H
+
+#include <rmagine/map/EmbreeMap.hpp>
+#include <rmagine/map/DistanceField.hpp>
+
+namespace rmagine
+{
+
+struct DistanceFieldSettings
+{
+    // grid spacing
+    float voxel_size = 0.1;
+    // distances are stored in blocks within this distance to the surface
+    // and truncated to [-band, band]
+    float band = 0.5;
+    // sign by ray parity (negative inside). Requires closed meshes
+    bool signed_distance = false;
+};
+
+/**
+ * @brief Build a DistanceField of all meshes of the map's top-level scene.
+ * 
+ * Parallel over blocks: distances by closest point queries, signs by 
+ * counting ray intersections.
+ */
+DistanceField make_distance_field(
+    EmbreeMapPtr map,
+    const DistanceFieldSettings& settings = {});
+
+} // namespace rmagine
+
+#endif // RMAGINE_MAP_EMBREE_DISTANCE_FIELD_H
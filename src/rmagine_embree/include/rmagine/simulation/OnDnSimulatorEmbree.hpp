@@ -42,6 +42,7 @@
 #define RMAGINE_SIMULATION_ONDN_SIMULATOR_EMBREE_HPP
 
 #include <rmagine/map/EmbreeMap.hpp>
+#include <rmagine/map/VersionedEmbreeMap.hpp>
 #include <rmagine/types/Memory.hpp>
 #include <rmagine/types/sensor_models.h>
 #include <rmagine/simulation/SimulationResults.hpp>
@@ -106,6 +107,12 @@ public:
 
     void setMap(EmbreeMapPtr map);
 
+    /**
+     * @brief Simulate on the current version of a versioned map. 
+     * Each simulate call uses the version that was current when it started.
+     */
+    void setMap(VersionedEmbreeMapPtr map);
+
     void setTsb(const MemoryView<Transform, RAM>& Tsb);
     void setTsb(const Transform& Tsb);
 
@@ -141,6 +148,7 @@ public:
 
 protected:
     EmbreeMapPtr m_map;
+    VersionedEmbreeMapPtr m_map_versions;
     
     RTCRayQueryContext  m_context;
     
@@ -21,6 +21,8 @@ void OnDnSimulatorEmbree::simulate(
     SimulationFlags flags = SimulationFlags::Zero();
     set_simulation_flags_<RAM>(ret, flags);
 
+    const EmbreeMapPtr map = current_map(m_map, m_map_versions);
+
     #pragma omp parallel for
     for(size_t pid = 0; pid < Tbm.size(); pid++)
     {
@@ -59,7 +61,7 @@ void OnDnSimulatorEmbree::simulate(
                 rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
                 rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
 
-                rtcIntersect1(m_map->scene->handle(), &rayhit);
+                rtcIntersect1(map->scene->handle(), &rayhit);
                 
                 if(rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID)
                 {
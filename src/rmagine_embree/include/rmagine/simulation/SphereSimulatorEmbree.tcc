@@ -21,6 +21,8 @@ void SphereSimulatorEmbree::simulate(
     SimulationFlags flags = SimulationFlags::Zero();
     set_simulation_flags_<RAM>(ret, flags);
 
+    const EmbreeMapPtr map = current_map(m_map, m_map_versions);
+
     #pragma omp parallel for
     for(size_t pid = 0; pid < Tbm.size(); pid++)
     {
@@ -56,7 +58,7 @@ void SphereSimulatorEmbree::simulate(
                 rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
                 rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
 
-                rtcIntersect1(m_map->scene->handle(), &rayhit);
+                rtcIntersect1(map->scene->handle(), &rayhit);
                 
                 if(rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID)
                 {
@@ -0,0 +1,301 @@
+#include "rmagine/map/EmbreeLodMap.hpp"
+
+#include "rmagine/map/embree/EmbreeMesh.hpp"
+#include "rmagine/map/embree/EmbreeInstance.hpp"
+
+#include <rmagine/util/exceptions.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+namespace rmagine
+{
+
+namespace
+{
+
+EmbreeInstancePtr make_level_instance(EmbreeMeshPtr mesh)
+{
+    mesh->commit();
+    EmbreeInstancePtr instance = mesh->instantiate();
+    instance->name = mesh->name;
+    instance->apply();
+    instance->commit();
+    return instance;
+}
+
+float distance(const AABB& box, const Vector& p)
+{
+    const float dx = std::max({box.min.x - p.x, 0.0f, p.x - box.max.x});
+    const float dy = std::max({box.min.y - p.y, 0.0f, p.y - box.max.y});
+    const float dz = std::max({box.min.z - p.z, 0.0f, p.z - box.max.z});
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+/**
+ * @brief Levels of a scene that is instanced at top level. Level k uses 
+ * level k of every mesh that has one, the coarsest level otherwise.
+ * Level 0 is the scene itself
+ */
+struct LevelScenes
+{
+    // in coordinates of the scene
+    AABB bounds;
+    std::vector<float> errors;
+    std::vector<EmbreeScenePtr> scenes;
+};
+
+LevelScenes make_level_scenes(EmbreeScenePtr scene)
+{
+    LevelScenes ret;
+    ret.bounds.init();
+
+    size_t num_levels = 1;
+    for(const auto& elem : scene->geometries())
+    {
+        if(EmbreeMeshConstPtr mesh = std::dynamic_pointer_cast<const EmbreeMesh>(elem.second))
+        {
+            for(const Vertex& v : mesh->verticesTransformed())
+            {
+                ret.bounds.expand(v);
+            }
+            num_levels = std::max(num_levels, mesh->lods.size() + 1);
+        }
+    }
+
+    ret.errors.push_back(0.0);
+    ret.scenes.push_back(scene);
+
+    for(size_t level = 1; level < num_levels; level++)
+    {
+        EmbreeScenePtr level_scene = std::make_shared<EmbreeScene>(scene->settings(), scene->device());
+        float error = 0.0;
+
+        for(const auto& elem : scene->geometries())
+        {
+            EmbreeMeshPtr mesh = std::dynamic_pointer_cast<EmbreeMesh>(elem.second);
+            if(!mesh || mesh->lods.empty())
+            {
+                // shared with the other levels
+                level_scene->add(elem.second);
+                continue;
+            }
+
+            const EmbreeMeshLod& lod = mesh->lods[std::min(level, mesh->lods.size()) - 1];
+            lod.mesh->commit();
+            level_scene->add(lod.mesh);
+            error = std::max(error, lod.error);
+        }
+
+        level_scene->commit();
+        ret.errors.push_back(error);
+        ret.scenes.push_back(level_scene);
+    }
+
+    return ret;
+}
+
+bool has_lods(EmbreeScenePtr scene)
+{
+    for(const auto& elem : scene->geometries())
+    {
+        EmbreeMeshConstPtr mesh = std::dynamic_pointer_cast<const EmbreeMesh>(elem.second);
+        if(mesh && !mesh->lods.empty())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+AABB transform_bounds(const AABB& box, const Matrix4x4& M)
+{
+    AABB ret;
+    ret.init();
+    for(unsigned int i=0; i<8; i++)
+    {
+        const Vector corner{
+            (i & 1) ? box.max.x : box.min.x,
+            (i & 2) ? box.max.y : box.min.y,
+            (i & 4) ? box.max.z : box.min.z};
+        ret.expand(M * corner);
+    }
+    return ret;
+}
+
+} // namespace
+
+EmbreeLodMap::EmbreeLodMap(
+    EmbreeScenePtr scene,
+    EmbreeLodMapSettings settings)
+:VersionedEmbreeMap([&]() {
+    EmbreeScenePtr top = std::make_shared<EmbreeScene>(settings.scene, scene->device());
+    top->commit();
+    return std::make_shared<EmbreeMap>(top);
+}())
+,m_settings(settings)
+{
+    EmbreeScenePtr top = std::make_shared<EmbreeScene>(m_settings.scene, scene->device());
+
+    // levels of scenes that are instanced several times are built once
+    std::unordered_map<EmbreeScenePtr, LevelScenes> level_scenes;
+
+    for(const auto& elem : scene->geometries())
+    {
+        if(EmbreeMeshPtr mesh = std::dynamic_pointer_cast<EmbreeMesh>(elem.second); mesh && !mesh->lods.empty())
+        {
+            Object object;
+            object.bounds.init();
+            for(const Vertex& v : mesh->verticesTransformed())
+            {
+                object.bounds.expand(v);
+            }
+
+            object.errors.push_back(0.0);
+            object.instances.push_back(make_level_instance(mesh));
+            for(const EmbreeMeshLod& lod : mesh->lods)
+            {
+                object.errors.push_back(lod.error);
+                object.instances.push_back(make_level_instance(lod.mesh));
+            }
+
+            top->add(object.instances[0]);
+            m_objects.push_back(object);
+        } else if(EmbreeInstancePtr inst = std::dynamic_pointer_cast<EmbreeInstance>(elem.second); inst && has_lods(inst->scene())) {
+            auto it = level_scenes.find(inst->scene());
+            if(it == level_scenes.end())
+            {
+                it = level_scenes.emplace(inst->scene(), make_level_scenes(inst->scene())).first;
+            }
+            const LevelScenes& levels = it->second;
+
+            // errors grow with the scale of the instance
+            const Vector3 S = inst->scale();
+            const float scale = std::max({std::fabs(S.x), std::fabs(S.y), std::fabs(S.z)});
+
+            Object object;
+            object.bounds = transform_bounds(levels.bounds, inst->matrix());
+            for(size_t level = 0; level < levels.scenes.size(); level++)
+            {
+                object.errors.push_back(levels.errors[level] * scale);
+
+                if(level == 0)
+                {
+                    object.instances.push_back(inst);
+                    continue;
+                }
+
+                EmbreeInstancePtr level_inst = std::make_shared<EmbreeInstance>(scene->device());
+                level_inst->set(levels.scenes[level]);
+                level_inst->name = inst->name;
+                level_inst->setTransform(inst->transform());
+                level_inst->setScale(S);
+                level_inst->apply();
+                level_inst->commit();
+                object.instances.push_back(level_inst);
+            }
+
+            top->add(object.instances[0]);
+            m_objects.push_back(object);
+        } else {
+            top->add(elem.second);
+        }
+    }
+
+    top->commit();
+    m_levels.resize(m_objects.size(), 0);
+    swap(std::make_shared<EmbreeMap>(top));
+}
+
+EmbreeLodMap::~EmbreeLodMap()
+{
+    // pending builds access the members of this class
+    wait();
+}
+
+size_t EmbreeLodMap::numObjects() const
+{
+    return m_objects.size();
+}
+
+std::vector<unsigned int> EmbreeLodMap::levels() const
+{
+    std::lock_guard<std::mutex> lock(m_levels_mutex);
+    return m_levels;
+}
+
+std::future<uint64_t> EmbreeLodMap::update(
+    const MemoryView<Transform, RAM>& Tbm)
+{
+    // copy: the poses may change before the build starts
+    Memory<Transform, RAM> Tbm_ = Tbm;
+    return VersionedEmbreeMap::update([this, Tbm_](EmbreeMapPtr map) {
+        return build(map, Tbm_);
+    });
+}
+
+std::future<uint64_t> EmbreeLodMap::update(
+    const Transform& Tbm)
+{
+    Memory<Transform, RAM> Tbm_(1);
+    Tbm_[0] = Tbm;
+    return update(Tbm_);
+}
+
+EmbreeScenePtr EmbreeLodMap::build(
+    EmbreeMapPtr map, 
+    const Memory<Transform, RAM>& Tbm)
+{
+    std::vector<unsigned int> levels(m_objects.size());
+
+    #pragma omp parallel for if(m_objects.size() > 1024)
+    for(size_t i=0; i<m_objects.size(); i++)
+    {
+        const Object& object = m_objects[i];
+
+        float d = std::numeric_limits<float>::infinity();
+        for(size_t j=0; j<Tbm.size(); j++)
+        {
+            d = std::min(d, distance(object.bounds, Tbm[j].t));
+        }
+
+        // coarsest level within the budget. errors are ascending
+        const float max_error = m_settings.error_budget * d;
+        unsigned int level = 0;
+        while(level + 1 < object.errors.size() && object.errors[level + 1] <= max_error)
+        {
+            level++;
+        }
+        levels[i] = level;
+    }
+
+    // only the background thread writes m_levels
+    if(levels == m_levels)
+    {
+        // keep the current version
+        return map->scene;
+    }
+
+    EmbreeScenePtr scene = map->scene->copy();
+    for(size_t i=0; i<m_objects.size(); i++)
+    {
+        if(levels[i] != m_levels[i])
+        {
+            scene->remove(m_objects[i].instances[m_levels[i]]);
+            scene->add(m_objects[i].instances[levels[i]]);
+        }
+    }
+    scene->commit();
+
+    {
+        std::lock_guard<std::mutex> lock(m_levels_mutex);
+        m_levels = levels;
+    }
+
+    return scene;
+}
+
+} // namespace rmagine
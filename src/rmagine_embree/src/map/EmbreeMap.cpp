@@ -8,6 +8,7 @@
 
 #include <map>
 #include <cassert>
+#include <atomic>
 
 namespace rmagine {
 
@@ -30,28 +31,44 @@ EmbreeMap::~EmbreeMap()
 
 Point EmbreeMap::closestPoint(const Point& qp)
 {
-    // std::cout << "TODO23: check if closestPoint is working after refactoring" << std::endl;
+    return closestPoint(qp, pq_context).p;
+}
+
+ClosestPointResult EmbreeMap::closestPoint(
+    const Point& qp, 
+    RTCPointQueryContext& context,
+    float max_radius) const
+{
     RTCPointQuery query;
     query.x = qp.x; 
     query.y = qp.y;
     query.z = qp.z;
-    query.radius = std::numeric_limits<float>::max();
+    query.radius = max_radius;
     query.time = 0.0;
 
     ClosestPointResult result;
 
+    const std::vector<PointQueryGeometry>& geometries = scene->pointQueryGeometries();
+
     PointQueryUserData user_data;
     user_data.scene = &scene;
+    user_data.geometries = geometries.data();
+    user_data.num_geometries = geometries.size();
     user_data.result = &result;
-    rtcPointQuery(scene->handle(), &query, &pq_context, nullptr, (void*)&user_data);
+    rtcPointQuery(scene->handle(), &query, &context, nullptr, (void*)&user_data);
 
-    if(result.geomID == RTC_INVALID_GEOMETRY_ID || result.primID == RTC_INVALID_GEOMETRY_ID)
+    if(user_data.unsupported_geomID != RTC_INVALID_GEOMETRY_ID)
     {
-        std::cout << "RESULT SEEMS TO BE WRONG" << std::endl;
-        // throw std::runtime_error("Cannot find nearest point on surface");
+        // once per process: this is called per point, possibly in parallel
+        static std::atomic<bool> reported{false};
+        if(!reported.exchange(true))
+        {
+            std::cout << "[EmbreeMap::closestPoint()] WARNING: geometry " << user_data.unsupported_geomID 
+                << " is ignored. Point queries support meshes of the last scene commit only, no instances." << std::endl;
+        }
     }
 
-    return result.p;
+    return result;
 }
 
 } // namespace rmagine
\ No newline at end of file
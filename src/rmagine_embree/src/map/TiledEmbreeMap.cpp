@@ -0,0 +1,487 @@
+#include "rmagine/map/TiledEmbreeMap.hpp"
+
+#include "rmagine/map/embree/EmbreeMesh.hpp"
+#include "rmagine/map/embree/EmbreeInstance.hpp"
+#include "rmagine/map/embree/embree_cache.h"
+
+#include <rmagine/util/exceptions.h>
+
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <unordered_set>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <cerrno>
+
+#include <sys/stat.h>
+
+namespace rmagine
+{
+
+namespace
+{
+
+constexpr char TILES_INDEX[] = "tiles.idx";
+constexpr char TILES_MAGIC[] = "RMTILES";
+constexpr unsigned int TILES_VERSION = 2;
+
+struct TileSource
+{
+    EmbreeMeshConstPtr mesh;
+    // transform of all instances above the mesh
+    Matrix4x4 M;
+};
+
+void collect_meshes(
+    EmbreeScenePtr scene, 
+    const Matrix4x4& M, 
+    std::vector<TileSource>& sources)
+{
+    for(const auto& elem : scene->geometries())
+    {
+        if(EmbreeMeshConstPtr mesh = std::dynamic_pointer_cast<const EmbreeMesh>(elem.second))
+        {
+            sources.push_back({mesh, M});
+        } else if(EmbreeInstancePtr inst = std::dynamic_pointer_cast<EmbreeInstance>(elem.second)) {
+            collect_meshes(inst->scene(), M * inst->matrix(), sources);
+        }
+    }
+}
+
+std::string tile_filename(const TileId& id)
+{
+    std::stringstream ss;
+    ss << "tile_" << id.x << "_" << id.y << ".rmsc";
+    return ss.str();
+}
+
+size_t file_size(const std::string& filename)
+{
+    struct stat st;
+    if(stat(filename.c_str(), &st) != 0)
+    {
+        RM_THROW(EmbreeException, "Could not stat '" + filename + "'");
+    }
+    return st.st_size;
+}
+
+} // namespace
+
+size_t save_tiled_embree_map(
+    EmbreeScenePtr scene,
+    const std::string& directory,
+    float tile_size)
+{
+    if(tile_size <= 0.0)
+    {
+        RM_THROW(EmbreeException, "save_tiled_embree_map: tile size must be positive");
+    }
+
+    if(mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST)
+    {
+        RM_THROW(EmbreeException, "save_tiled_embree_map: could not create directory '" + directory + "'");
+    }
+
+    std::vector<TileSource> sources;
+    Matrix4x4 I;
+    I.setIdentity();
+    collect_meshes(scene, I, sources);
+
+    // vertices in map coordinates
+    std::vector<Memory<Vertex, RAM> > vertices(sources.size());
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t i=0; i<sources.size(); i++)
+    {
+        const MemoryView<const Vertex, RAM> vertices_mesh = sources[i].mesh->verticesTransformed();
+        vertices[i].resize(vertices_mesh.size());
+        for(size_t j=0; j<vertices_mesh.size(); j++)
+        {
+            vertices[i][j] = sources[i].M * vertices_mesh[j];
+        }
+    }
+
+    // sorted: tiles are written in the same order every time
+    auto cmp = [](const TileId& a, const TileId& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    };
+    // tile -> source -> faces
+    std::map<TileId, std::map<size_t, std::vector<unsigned int> >, decltype(cmp)> tiles(cmp);
+
+    for(size_t i=0; i<sources.size(); i++)
+    {
+        const MemoryView<const Face, RAM> faces = sources[i].mesh->faces();
+        for(size_t j=0; j<faces.size(); j++)
+        {
+            const Face& f = faces[j];
+            const Vector c = (vertices[i][f.v0] + vertices[i][f.v1] + vertices[i][f.v2]) / 3.0;
+            const TileId id{
+                static_cast<int32_t>(std::floor(c.x / tile_size)),
+                static_cast<int32_t>(std::floor(c.y / tile_size))};
+            tiles[id][i].push_back(j);
+        }
+    }
+
+    std::vector<TileId> ids;
+    ids.reserve(tiles.size());
+    for(const auto& elem : tiles)
+    {
+        ids.push_back(elem.first);
+    }
+
+    std::vector<size_t> bytes(ids.size());
+    // faces reach out of the tile of their centroid: the index stores the real bounds
+    std::vector<AABB> bounds(ids.size());
+
+    std::exception_ptr error;
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t t=0; t<ids.size(); t++)
+    {
+        try {
+            EmbreeScenePtr tile = std::make_shared<EmbreeScene>(scene->settings());
+            bounds[t].init();
+
+            for(const auto& elem : tiles.at(ids[t]))
+            {
+                const size_t i = elem.first;
+                const std::vector<unsigned int>& face_ids = elem.second;
+                const MemoryView<const Face, RAM> faces_src = sources[i].mesh->faces();
+
+                // compact the vertices used by this tile
+                std::unordered_map<unsigned int, unsigned int> vertex_ids;
+                std::vector<unsigned int> vertex_ids_src;
+                auto vertex_id = [&](unsigned int v) {
+                    auto it = vertex_ids.find(v);
+                    if(it != vertex_ids.end())
+                    {
+                        return it->second;
+                    }
+                    const unsigned int v_new = vertex_ids_src.size();
+                    vertex_ids[v] = v_new;
+                    vertex_ids_src.push_back(v);
+                    return v_new;
+                };
+
+                std::vector<Face> faces(face_ids.size());
+                for(size_t j=0; j<face_ids.size(); j++)
+                {
+                    const Face& f = faces_src[face_ids[j]];
+                    faces[j] = {vertex_id(f.v0), vertex_id(f.v1), vertex_id(f.v2)};
+                }
+
+                EmbreeMeshPtr mesh = std::make_shared<EmbreeMesh>(
+                    vertex_ids_src.size(), faces.size());
+                mesh->name = sources[i].mesh->name;
+
+                MemoryView<Vertex, RAM> mesh_vertices = mesh->vertices();
+                for(size_t j=0; j<vertex_ids_src.size(); j++)
+                {
+                    mesh_vertices[j] = vertices[i][vertex_ids_src[j]];
+                    bounds[t].expand(mesh_vertices[j]);
+                }
+                std::copy(faces.begin(), faces.end(), mesh->faces().raw());
+
+                mesh->computeFaceNormals();
+                mesh->apply();
+                tile->add(mesh);
+            }
+
+            const std::string filename = directory + "/" + tile_filename(ids[t]);
+            save_embree_scene(tile, filename);
+            bytes[t] = file_size(filename);
+        } catch(...) {
+            // exceptions must not escape the parallel region
+            #pragma omp critical
+            error = std::current_exception();
+        }
+    }
+
+    if(error)
+    {
+        std::rethrow_exception(error);
+    }
+
+    std::ofstream index(directory + "/" + TILES_INDEX);
+    if(!index)
+    {
+        RM_THROW(EmbreeException, "save_tiled_embree_map: could not write index to '" + directory + "'");
+    }
+
+    // coordinates of large maps need all digits
+    index.precision(std::numeric_limits<float>::max_digits10);
+    index << TILES_MAGIC << " " << TILES_VERSION << "\n";
+    index << tile_size << "\n";
+    index << ids.size() << "\n";
+    for(size_t t=0; t<ids.size(); t++)
+    {
+        const AABB& b = bounds[t];
+        index << ids[t].x << " " << ids[t].y << " " << bytes[t] << " "
+              << b.min.x << " " << b.min.y << " " << b.min.z << " "
+              << b.max.x << " " << b.max.y << " " << b.max.z << " "
+              << tile_filename(ids[t]) << "\n";
+    }
+
+    return ids.size();
+}
+
+TiledEmbreeMap::TiledEmbreeMap(
+    const std::string& directory,
+    TiledEmbreeMapSettings settings,
+    EmbreeDevicePtr device)
+:VersionedEmbreeMap([&]() {
+    // start with an empty top-level scene
+    EmbreeScenePtr scene = std::make_shared<EmbreeScene>(settings.scene, device);
+    scene->commit();
+    return std::make_shared<EmbreeMap>(scene);
+}())
+,m_directory(directory)
+,m_settings(settings)
+,m_device(device)
+{
+    std::ifstream index(m_directory + "/" + TILES_INDEX);
+    if(!index)
+    {
+        RM_THROW(EmbreeException, "TiledEmbreeMap: no tile index found in '" + m_directory + "'");
+    }
+
+    std::string magic;
+    unsigned int version;
+    size_t num_tiles;
+    index >> magic >> version >> m_tile_size >> num_tiles;
+    if(!index || magic != TILES_MAGIC || version != TILES_VERSION)
+    {
+        RM_THROW(EmbreeException, "TiledEmbreeMap: unsupported tile index in '" + m_directory + "'");
+    }
+
+    if(!(m_tile_size > 0.0) || !std::isfinite(m_tile_size))
+    {
+        RM_THROW(EmbreeException, "TiledEmbreeMap: invalid tile size in the index of '" + m_directory + "'");
+    }
+
+    m_overhang = 0.0;
+
+    for(size_t i=0; i<num_tiles; i++)
+    {
+        TileId id;
+        TileFile file;
+        index >> id.x >> id.y >> file.bytes 
+              >> file.bounds.min.x >> file.bounds.min.y >> file.bounds.min.z 
+              >> file.bounds.max.x >> file.bounds.max.y >> file.bounds.max.z
+              >> file.filename;
+        if(!index)
+        {
+            RM_THROW(EmbreeException, "TiledEmbreeMap: tile index in '" + m_directory + "' is truncated");
+        }
+        file.filename = m_directory + "/" + file.filename;
+        m_files[id] = file;
+
+        // how far the tile reaches out of its square
+        m_overhang = std::max({m_overhang,
+            id.x * m_tile_size - file.bounds.min.x,
+            file.bounds.max.x - (id.x + 1) * m_tile_size,
+            id.y * m_tile_size - file.bounds.min.y,
+            file.bounds.max.y - (id.y + 1) * m_tile_size});
+    }
+}
+
+TiledEmbreeMap::~TiledEmbreeMap()
+{
+    // pending builds access the members of this class
+    wait();
+}
+
+TileId TiledEmbreeMap::tileId(const Vector& p) const
+{
+    return {
+        static_cast<int32_t>(std::floor(p.x / m_tile_size)),
+        static_cast<int32_t>(std::floor(p.y / m_tile_size))};
+}
+
+size_t TiledEmbreeMap::numTiles() const
+{
+    return m_files.size();
+}
+
+size_t TiledEmbreeMap::numLoadedTiles() const
+{
+    std::lock_guard<std::mutex> lock(m_loaded_mutex);
+    return m_loaded.size();
+}
+
+size_t TiledEmbreeMap::loadedBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_loaded_mutex);
+    return m_loaded_bytes;
+}
+
+std::future<uint64_t> TiledEmbreeMap::update(
+    const MemoryView<Transform, RAM>& Tbm)
+{
+    std::vector<TileId> tiles = tilesInRange(Tbm);
+    return VersionedEmbreeMap::update([this, tiles](EmbreeMapPtr map) {
+        return build(map, tiles);
+    });
+}
+
+std::future<uint64_t> TiledEmbreeMap::update(
+    const Transform& Tbm)
+{
+    Memory<Transform, RAM> Tbm_(1);
+    Tbm_[0] = Tbm;
+    return update(Tbm_);
+}
+
+std::vector<TileId> TiledEmbreeMap::tilesInRange(
+    const MemoryView<Transform, RAM>& Tbm) const
+{
+    const float range = m_settings.range;
+    const float range_sq = range * range;
+
+    std::unordered_set<TileId, TileIdHash> tiles;
+    for(size_t i=0; i<Tbm.size(); i++)
+    {
+        const Vector p = Tbm[i].t;
+        // tiles whose bounds can be in range
+        const float reach = range + m_overhang;
+        const TileId min = tileId({p.x - reach, p.y - reach, 0.0});
+        const TileId max = tileId({p.x + reach, p.y + reach, 0.0});
+
+        for(int32_t x = min.x; x <= max.x; x++)
+        {
+            for(int32_t y = min.y; y <= max.y; y++)
+            {
+                const TileId id{x, y};
+                auto it = m_files.find(id);
+                if(it == m_files.end())
+                {
+                    continue;
+                }
+
+                // distance from p to the geometry bounds of the tile
+                const AABB& b = it->second.bounds;
+                const float dx = std::max({b.min.x - p.x, 0.0f, p.x - b.max.x});
+                const float dy = std::max({b.min.y - p.y, 0.0f, p.y - b.max.y});
+                const float dz = std::max({b.min.z - p.z, 0.0f, p.z - b.max.z});
+                if(dx * dx + dy * dy + dz * dz <= range_sq)
+                {
+                    tiles.insert(id);
+                }
+            }
+        }
+    }
+
+    return std::vector<TileId>(tiles.begin(), tiles.end());
+}
+
+EmbreeScenePtr TiledEmbreeMap::build(
+    EmbreeMapPtr map,
+    const std::vector<TileId>& tiles)
+{
+    std::unordered_set<TileId, TileIdHash> required(tiles.begin(), tiles.end());
+    std::vector<TileId> missing;
+    size_t bytes;
+
+    {
+        std::lock_guard<std::mutex> lock(m_loaded_mutex);
+        m_clock++;
+        for(const TileId& id : tiles)
+        {
+            auto it = m_loaded.find(id);
+            if(it != m_loaded.end())
+            {
+                it->second.last_used = m_clock;
+            } else {
+                missing.push_back(id);
+            }
+        }
+        bytes = m_loaded_bytes;
+    }
+
+    std::vector<LoadedTile> loaded(missing.size());
+    for(size_t i=0; i<missing.size(); i++)
+    {
+        loaded[i].bytes = m_files.at(missing[i]).bytes;
+        loaded[i].last_used = m_clock;
+        bytes += loaded[i].bytes;
+    }
+
+    // evict least recently used tiles that are out of range
+    std::vector<TileId> evicted;
+    if(bytes > m_settings.memory_budget)
+    {
+        std::vector<std::pair<uint64_t, TileId> > candidates;
+        {
+            std::lock_guard<std::mutex> lock(m_loaded_mutex);
+            for(const auto& elem : m_loaded)
+            {
+                if(required.find(elem.first) == required.end())
+                {
+                    candidates.push_back({elem.second.last_used, elem.first});
+                }
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), 
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        for(size_t i=0; i<candidates.size() && bytes > m_settings.memory_budget; i++)
+        {
+            evicted.push_back(candidates[i].second);
+            bytes -= m_files.at(candidates[i].second).bytes;
+        }
+    }
+
+    if(missing.empty() && evicted.empty())
+    {
+        // keep the current version
+        return map->scene;
+    }
+
+    std::exception_ptr error;
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t i=0; i<missing.size(); i++)
+    {
+        try {
+            EmbreeScenePtr tile = load_embree_scene(m_files.at(missing[i]).filename, m_device);
+            EmbreeInstancePtr instance = tile->instantiate();
+            instance->apply();
+            instance->commit();
+            loaded[i].instance = instance;
+        } catch(...) {
+            #pragma omp critical
+            error = std::current_exception();
+        }
+    }
+
+    if(error)
+    {
+        std::rethrow_exception(error);
+    }
+
+    EmbreeScenePtr scene = map->scene->copy();
+
+    {
+        std::lock_guard<std::mutex> lock(m_loaded_mutex);
+        for(const TileId& id : evicted)
+        {
+            // older versions keep the tile alive as long as they are used
+            scene->remove(m_loaded.at(id).instance);
+            m_loaded_bytes -= m_loaded.at(id).bytes;
+            m_loaded.erase(id);
+        }
+
+        for(size_t i=0; i<missing.size(); i++)
+        {
+            scene->add(loaded[i].instance);
+            m_loaded_bytes += loaded[i].bytes;
+            m_loaded[missing[i]] = loaded[i];
+        }
+    }
+
+    scene->commit();
+
+    return scene;
+}
+
+} // namespace rmagine
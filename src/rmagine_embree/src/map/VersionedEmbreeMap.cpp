@@ -0,0 +1,139 @@
+#include "rmagine/map/VersionedEmbreeMap.hpp"
+
+#include <rmagine/util/exceptions.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace rmagine
+{
+
+// how often the worker checks for old versions without readers
+static constexpr std::chrono::milliseconds RELEASE_INTERVAL(100);
+
+VersionedEmbreeMap::VersionedEmbreeMap(EmbreeMapPtr map)
+:m_current(map)
+{
+    m_worker = std::thread(&VersionedEmbreeMap::work, this);
+}
+
+VersionedEmbreeMap::~VersionedEmbreeMap()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_tasks_mutex);
+        m_stop = true;
+    }
+    m_tasks_cv.notify_all();
+    m_worker.join();
+}
+
+EmbreeMapPtr VersionedEmbreeMap::current() const
+{
+    std::lock_guard<std::mutex> lock(m_current_mutex);
+    return m_current;
+}
+
+uint64_t VersionedEmbreeMap::version() const
+{
+    std::lock_guard<std::mutex> lock(m_current_mutex);
+    return m_version;
+}
+
+std::future<uint64_t> VersionedEmbreeMap::update(Builder builder)
+{
+    std::future<uint64_t> ret;
+    {
+        std::lock_guard<std::mutex> lock(m_tasks_mutex);
+        m_tasks.push_back(Task{std::move(builder), std::promise<uint64_t>()});
+        ret = m_tasks.back().promise.get_future();
+    }
+    m_tasks_cv.notify_one();
+    return ret;
+}
+
+uint64_t VersionedEmbreeMap::swap(EmbreeMapPtr map)
+{
+    std::lock_guard<std::mutex> lock(m_current_mutex);
+    // old versions are destroyed by the worker. See release()
+    m_retired.push_back(std::move(m_current));
+    m_current = std::move(map);
+    return ++m_version;
+}
+
+void VersionedEmbreeMap::release()
+{
+    std::vector<EmbreeMapPtr> unused;
+    {
+        std::lock_guard<std::mutex> lock(m_current_mutex);
+        // only reachable from m_retired: no reader can take it anymore
+        auto it = std::partition(m_retired.begin(), m_retired.end(), 
+            [](const EmbreeMapPtr& map) { return map.use_count() > 1; });
+        std::move(it, m_retired.end(), std::back_inserter(unused));
+        m_retired.erase(it, m_retired.end());
+    }
+    // destroyed here, outside of the lock
+}
+
+void VersionedEmbreeMap::wait()
+{
+    std::unique_lock<std::mutex> lock(m_tasks_mutex);
+    m_idle_cv.wait(lock, [this]{ return m_tasks.empty() && !m_busy; });
+}
+
+void VersionedEmbreeMap::work()
+{
+    while(true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_tasks_mutex);
+            m_tasks_cv.wait_for(lock, RELEASE_INTERVAL, [this]{ return m_stop || !m_tasks.empty(); });
+
+            if(m_tasks.empty())
+            {
+                if(m_stop)
+                {
+                    // pending builds are finished before stopping
+                    return;
+                }
+
+                lock.unlock();
+                release();
+                continue;
+            }
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            m_busy = true;
+        }
+
+        try {
+            const EmbreeMapPtr map = current();
+            EmbreeScenePtr scene = task.builder(map);
+            if(!scene)
+            {
+                RM_THROW(EmbreeException, "VersionedEmbreeMap: builder returned no scene.");
+            }
+
+            if(scene == map->scene)
+            {
+                // nothing changed
+                task.promise.set_value(version());
+            } else {
+                task.promise.set_value(swap(std::make_shared<EmbreeMap>(scene)));
+            }
+        } catch(...) {
+            task.promise.set_exception(std::current_exception());
+        }
+
+        release();
+
+        {
+            std::lock_guard<std::mutex> lock(m_tasks_mutex);
+            m_busy = false;
+        }
+        m_idle_cv.notify_all();
+    }
+}
+
+} // namespace rmagine
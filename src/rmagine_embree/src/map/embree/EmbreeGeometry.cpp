@@ -28,9 +28,15 @@ EmbreeGeometry::~EmbreeGeometry()
 
 void EmbreeGeometry::setQuality(RTCBuildQuality quality)
 {
+    m_quality = quality;
     rtcSetGeometryBuildQuality(m_handle, quality);
 }
 
+RTCBuildQuality EmbreeGeometry::quality() const
+{
+    return m_quality;
+}
+
 RTCGeometry EmbreeGeometry::handle() const
 {
     return m_handle;
@@ -39,6 +45,7 @@ RTCGeometry EmbreeGeometry::handle() const
 void EmbreeGeometry::setTransform(const Transform& T)
 {
     m_T = T;
+    m_transform_changed = true;
 }
 
 void EmbreeGeometry::setTransform(const Matrix4x4& T)
@@ -52,6 +59,7 @@ void EmbreeGeometry::setTransform(const Matrix4x4& T)
 void EmbreeGeometry::setTransformAndScale(const Matrix4x4& M)
 {
     decompose(M, m_T, m_S);
+    m_transform_changed = true;
 }
 
 Transform EmbreeGeometry::transform() const
@@ -62,6 +70,7 @@ Transform EmbreeGeometry::transform() const
 void EmbreeGeometry::setScale(const Vector3& S)
 {
     m_S = S;
+    m_transform_changed = true;
 }
 
 Vector3 EmbreeGeometry::scale() const
@@ -39,6 +39,12 @@ EmbreeScenePtr EmbreeInstance::scene()
 
 void EmbreeInstance::apply()
 {
+    if(!m_transform_changed)
+    {
+        return;
+    }
+    m_transform_changed = false;
+
     Matrix4x4 M;
     M.set(m_T);
 
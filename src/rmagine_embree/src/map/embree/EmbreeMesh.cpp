@@ -8,88 +8,26 @@
 #include <iostream>
 
 #include <map>
+#include <vector>
+#include <algorithm>
 #include <cassert>
 
 
 
 #include <rmagine/math/assimp_conversions.h>
+#include <rmagine/math/closest_point.h>
+#include <rmagine/util/exceptions.h>
 
 
 
 namespace rmagine {
 
-Point closestPointTriangle(
-    const Point& p, 
-    const Point& a, 
-    const Point& b, 
-    const Point& c)
-{
-    const Vector ab = b-a;
-    const Vector ac = c-a;
-    const Vector ap = p-a;
-    const Vector n = ab.cross(ac);
-
-    // TODO: comment this in and test
-    Matrix3x3 R;
-    R(0,0) = ab.x;
-    R(1,0) = ab.y;
-    R(2,0) = ab.z;
-    
-    R(0,1) = ac.x;
-    R(1,1) = ac.y;
-    R(2,1) = ac.z;
-
-    R(0,2) = n.x;
-    R(1,2) = n.y;
-    R(2,2) = n.z;
-
-    Matrix3x3 Rinv = R.inv();
-    Vector p_in_t = Rinv * ap;
-    float p0 = p_in_t.x;
-    float p1 = p_in_t.y;
+// below this number of elements the per-element loops stay sequential
+constexpr unsigned int PARALLEL_MIN_ELEMENTS = 4096;
 
-    // Instead of this
-    const bool on_ab_edge = (p0 >= 0.f && p0 <= 1.f);
-    const bool on_ac_edge = (p1 >= 0.f && p1 <= 1.f);
-
-    if(on_ab_edge && on_ac_edge)
-    {
-        // in triangle
-        return ab * p0 + ac * p1 + a;
-    } 
-    else if(on_ab_edge && !on_ac_edge)
-    {
-        // nearest point on edge (ab)
-        return ab * p0 + a;
-    }
-    else if(!on_ab_edge && on_ac_edge)
-    {
-        // nearest point on edge (ac)
-        return ac * p1 + a;
-    }
-    else
-    {
-        // nearest vertex
-        float d_ap = ap.l2normSquared();
-        float d_bp = (p - b).l2normSquared();
-        float d_cp = (p - c).l2normSquared();
-        
-        if(d_ap < d_bp && d_ap < d_cp)
-        {
-            // a best
-            return a;
-        } 
-        else if(d_bp < d_cp) 
-        { 
-            // b best
-            return b;
-        } 
-        else 
-        {
-            // c best
-            return c;
-        }
-    }
+static Vector face_normal(const Vector& v0, const Vector& v1, const Vector& v2)
+{
+    return (v1 - v0).normalize().cross((v2 - v0).normalize() ).normalize();
 }
 
 bool closestPointFunc(RTCPointQueryFunctionArguments* args)
@@ -107,26 +45,25 @@ bool closestPointFunc(RTCPointQueryFunctionArguments* args)
     // query position in world space
     Vector q{args->query->x, args->query->y, args->query->z};
 
-    /*
-    * Get triangle information in global space
-    */
-    EmbreeScenePtr scene = *userData->scene;
-    EmbreeMeshPtr mesh = scene->getAs<EmbreeMesh>(geomID);
-    
-    if(mesh)
+    // hot path: raw buffers from the flat table of the scene
+    if(geomID < userData->num_geometries && userData->geometries[geomID].faces)
     {
-        Face face = mesh->faces()[primID];
+        const PointQueryGeometry& geom = userData->geometries[geomID];
+        const Face face = geom.faces[primID];
 
-        Vertex v0 = mesh->verticesTransformed()[face.v0];
-        Vertex v1 = mesh->verticesTransformed()[face.v1];
-        Vertex v2 = mesh->verticesTransformed()[face.v2];
+        const Vertex v0 = geom.vertices[face.v0];
+        const Vertex v1 = geom.vertices[face.v1];
+        const Vertex v2 = geom.vertices[face.v2];
 
         const Vector p = closestPointTriangle(q, v0, v1, v2);
 
-        float d = (p - q).l2norm();
+        // compare squared distances, only take the root of improvements
+        const float d2 = (p - q).l2normSquared();
+        const float r = args->query->radius;
 
-        if (d < args->query->radius)
+        if (d2 < r * r)
         {
+            const float d = sqrtf(d2);
             args->query->radius = d;
             if(d < userData->result->d)
             {
@@ -134,22 +71,17 @@ bool closestPointFunc(RTCPointQueryFunctionArguments* args)
                 userData->result->geomID = geomID;
                 userData->result->primID = primID;
                 userData->result->p = p;
+                userData->result->n = (v1 - v0).cross(v2 - v0).normalize();
             }
             return true; // Return true to indicate that the query radius changed.
         }
-    } else {
-        EmbreeInstancePtr inst = scene->getAs<EmbreeInstance>(geomID);
-
-        if(inst)
-        {
-            std::cout << "INSTANCING NOT SUPPORTED FOR POINTQUERIES YET!" << std::endl;
-            // inst->scene()
-        } else {
-            std::cout << "WARNING: " << geomID << " unknown type" << std::endl;
-        }
-        
+        return false;
     }
 
+    // cold path: instances, other geometry types and meshes added after 
+    // the last commit of the scene are not supported. Remember one for 
+    // the caller to report
+    userData->unsupported_geomID = geomID;
     return false;
 }
 
@@ -244,6 +176,12 @@ void EmbreeMesh::init(
                                                     RTC_FORMAT_UINT3,
                                                     sizeof(Face),
                                                     m_num_faces));
+
+    markVerticesChanged(0, m_num_vertices);
+    m_transform_changed = true;
+    m_normals_changed = true;
+    m_faces_changed = true;
+    m_vertex_faces_offsets = Memory<unsigned int, RAM>();
 }
 
 void EmbreeMesh::init(
@@ -262,12 +200,14 @@ void EmbreeMesh::init(
     const aiFace* ai_faces = amesh->mFaces;
 
     // copy mesh to embree buffers
+    #pragma omp parallel for if(m_num_vertices > PARALLEL_MIN_ELEMENTS)
     for(unsigned int i=0; i<m_num_vertices; i++)
     {
         m_vertices[i] = convert(ai_vertices[i]);
     }
 
-    for(int i=0; i<m_num_faces; i++)
+    #pragma omp parallel for if(m_num_faces > PARALLEL_MIN_ELEMENTS)
+    for(unsigned int i=0; i<m_num_faces; i++)
     {
         m_faces[i] = {ai_faces[i].mIndices[0], ai_faces[i].mIndices[1], ai_faces[i].mIndices[2]};
     }
@@ -276,9 +216,12 @@ void EmbreeMesh::init(
     {
         m_vertex_normals.resize(m_num_vertices);
         m_vertex_normals_transformed.resize(m_num_vertices);
-        for(size_t i=0; i<m_num_vertices; i++)
+
+        const aiVector3D* ai_normals = amesh->mNormals;
+        #pragma omp parallel for if(m_num_vertices > PARALLEL_MIN_ELEMENTS)
+        for(unsigned int i=0; i<m_num_vertices; i++)
         {
-            m_vertex_normals[i] = convert(amesh->mNormals[i]);
+            m_vertex_normals[i] = convert(ai_normals[i]);
         }
     }
 
@@ -287,37 +230,185 @@ void EmbreeMesh::init(
     apply();
 }
 
+void EmbreeMesh::init(
+    MemoryView<Vertex, RAM> vertices,
+    MemoryView<Face, RAM> faces,
+    MemoryView<Vector, RAM> face_normals,
+    MemoryView<Vector, RAM> vertex_normals,
+    std::shared_ptr<void> holder)
+{
+    m_num_vertices = vertices.size();
+    m_num_faces = faces.size();
+
+    m_T.setIdentity();
+    m_S = {1.0, 1.0, 1.0};
+
+    m_vertices = share_memory(vertices.raw(), vertices.size(), holder);
+    m_face_normals = share_memory(face_normals.raw(), face_normals.size(), holder);
+    m_vertex_normals = share_memory(vertex_normals.raw(), vertex_normals.size(), holder);
+
+    // with identity transform the transformed data equals the input data
+    m_vertices_transformed = m_vertices.raw();
+    m_face_normals_transformed = share_memory(face_normals.raw(), face_normals.size(), holder);
+    m_vertex_normals_transformed = share_memory(vertex_normals.raw(), vertex_normals.size(), holder);
+    m_faces = faces.raw();
+
+    rtcSetSharedGeometryBuffer(m_handle,
+        RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3,
+        m_vertices_transformed, 0, sizeof(Vertex), m_num_vertices);
+
+    rtcSetSharedGeometryBuffer(m_handle,
+        RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3,
+        m_faces, 0, sizeof(Face), m_num_faces);
+
+    // the buffers are complete already
+    markVerticesChanged(0, 0);
+    m_transform_changed = false;
+    m_normals_changed = false;
+    m_faces_changed = false;
+    m_vertex_faces_offsets = Memory<unsigned int, RAM>();
+}
+
 void EmbreeMesh::initVertexNormals()
 {
     m_vertex_normals.resize(m_num_vertices);
     m_vertex_normals_transformed.resize(m_num_vertices);
+    m_normals_changed = true;
 }
 
-MemoryView<Face, RAM> EmbreeMesh::faces() const
+MemoryView<Face, RAM> EmbreeMesh::faces()
 {
+    m_faces_changed = true;
+    m_vertex_faces_offsets = Memory<unsigned int, RAM>();
     return MemoryView<Face, RAM>(m_faces, m_num_faces);
 }
 
-MemoryView<Vertex, RAM> EmbreeMesh::vertices() const
+MemoryView<Vertex, RAM> EmbreeMesh::vertices()
 {
+    markVerticesChanged(0, m_num_vertices);
     return m_vertices;
 }
 
-MemoryView<Vector, RAM> EmbreeMesh::vertexNormals() const
+MemoryView<Vector, RAM> EmbreeMesh::vertexNormals()
 {
+    m_normals_changed = true;
     return m_vertex_normals;
 }
 
-MemoryView<Vector, RAM> EmbreeMesh::faceNormals() const
+MemoryView<Vector, RAM> EmbreeMesh::faceNormals()
 {
+    m_normals_changed = true;
     return m_face_normals;
 }
 
+MemoryView<const Face, RAM> EmbreeMesh::faces() const
+{
+    return MemoryView<const Face, RAM>(m_faces, m_num_faces);
+}
+
+MemoryView<const Vertex, RAM> EmbreeMesh::vertices() const
+{
+    return MemoryView<const Vertex, RAM>(m_vertices.raw(), m_vertices.size());
+}
+
+MemoryView<const Vector, RAM> EmbreeMesh::vertexNormals() const
+{
+    return MemoryView<const Vector, RAM>(m_vertex_normals.raw(), m_vertex_normals.size());
+}
+
+MemoryView<const Vector, RAM> EmbreeMesh::faceNormals() const
+{
+    return MemoryView<const Vector, RAM>(m_face_normals.raw(), m_face_normals.size());
+}
+
+void EmbreeMesh::setVertices(
+    const MemoryView<Vertex, RAM>& vertices, 
+    unsigned int offset)
+{
+    if(offset + vertices.size() > m_num_vertices)
+    {
+        RM_THROW(EmbreeException, "EmbreeMesh::setVertices: range exceeds the number of vertices.");
+    }
+
+    const unsigned int num_vertices = vertices.size();
+    #pragma omp parallel for if(num_vertices > PARALLEL_MIN_ELEMENTS)
+    for(unsigned int i=0; i<num_vertices; i++)
+    {
+        m_vertices[offset + i] = vertices[i];
+    }
+
+    markVerticesChanged(offset, offset + num_vertices);
+}
+
+void EmbreeMesh::markVerticesChanged(unsigned int begin, unsigned int end)
+{
+    if(begin >= end)
+    {
+        // reset
+        m_vertices_changed_begin = 0;
+        m_vertices_changed_end = 0;
+    } else if(m_vertices_changed_begin >= m_vertices_changed_end) {
+        m_vertices_changed_begin = begin;
+        m_vertices_changed_end = end;
+    } else {
+        // covering range
+        m_vertices_changed_begin = std::min(m_vertices_changed_begin, begin);
+        m_vertices_changed_end = std::max(m_vertices_changed_end, end);
+    }
+}
+
+void EmbreeMesh::updateVertexFaces()
+{
+    if(m_vertex_faces_offsets.size() == m_num_vertices + 1)
+    {
+        return;
+    }
+
+    m_vertex_faces_offsets.resize(m_num_vertices + 1);
+    m_vertex_faces.resize(3 * m_num_faces);
+
+    for(unsigned int i=0; i<=m_num_vertices; i++)
+    {
+        m_vertex_faces_offsets[i] = 0;
+    }
+
+    // count, prefix sum, fill
+    for(unsigned int i=0; i<m_num_faces; i++)
+    {
+        m_vertex_faces_offsets[m_faces[i].v0 + 1]++;
+        m_vertex_faces_offsets[m_faces[i].v1 + 1]++;
+        m_vertex_faces_offsets[m_faces[i].v2 + 1]++;
+    }
+
+    for(unsigned int i=0; i<m_num_vertices; i++)
+    {
+        m_vertex_faces_offsets[i + 1] += m_vertex_faces_offsets[i];
+    }
+
+    std::vector<unsigned int> fill(m_vertex_faces_offsets.raw(), m_vertex_faces_offsets.raw() + m_num_vertices);
+    for(unsigned int i=0; i<m_num_faces; i++)
+    {
+        m_vertex_faces[fill[m_faces[i].v0]++] = i;
+        m_vertex_faces[fill[m_faces[i].v1]++] = i;
+        m_vertex_faces[fill[m_faces[i].v2]++] = i;
+    }
+}
+
 MemoryView<const Vertex, RAM> EmbreeMesh::verticesTransformed() const
 {
     return MemoryView<const Vertex, RAM>(m_vertices_transformed, m_num_vertices);
 }
 
+MemoryView<const Vector, RAM> EmbreeMesh::faceNormalsTransformed() const
+{
+    return MemoryView<const Vector, RAM>(m_face_normals_transformed.raw(), m_face_normals_transformed.size());
+}
+
+MemoryView<const Vector, RAM> EmbreeMesh::vertexNormalsTransformed() const
+{
+    return MemoryView<const Vector, RAM>(m_vertex_normals_transformed.raw(), m_vertex_normals_transformed.size());
+}
+
 void EmbreeMesh::computeFaceNormals()
 {
     if(m_face_normals.size() != m_num_faces)
@@ -330,54 +421,145 @@ void EmbreeMesh::computeFaceNormals()
         m_face_normals_transformed.resize(m_num_faces);
     }
     
-    for(size_t i=0; i<m_num_faces; i++)
+    #pragma omp parallel for if(m_num_faces > PARALLEL_MIN_ELEMENTS)
+    for(unsigned int i=0; i<m_num_faces; i++)
     {
         const Vector v0 = m_vertices[m_faces[i].v0];
         const Vector v1 = m_vertices[m_faces[i].v1];
         const Vector v2 = m_vertices[m_faces[i].v2];
-        Vector n = (v1 - v0).normalize().cross((v2 - v0).normalize() ).normalize();
-        m_face_normals[i] = n;
+        m_face_normals[i] = face_normal(v0, v1, v2);
     }
+
+    m_normals_changed = true;
 }
 
 void EmbreeMesh::apply()
 {
-    // TRANSFORM VERTICES
-    for(unsigned int i=0; i<m_num_vertices; i++)
-    {
-        m_vertices_transformed[i] = m_T * (m_vertices[i].multEwise(m_S));
-        // also possible:
-        // m_vertices_transformed[i] = matrix() * m_vertices[i];
-        // might be slower
-    }
+    const bool identity = (m_T.R.x == 0.0 && m_T.R.y == 0.0 && m_T.R.z == 0.0 && m_T.R.w == 1.0
+        && m_T.t.x == 0.0 && m_T.t.y == 0.0 && m_T.t.z == 0.0
+        && m_S.x == 1.0 && m_S.y == 1.0 && m_S.z == 1.0);
 
-    // TRANSFORM FACE NORMALS
-    if(m_face_normals_transformed.size() != m_face_normals.size())
+    if(m_vertices_transformed == m_vertices.raw() && !identity)
     {
-        m_face_normals_transformed.resize(m_face_normals.size());
+        // transformed data shares the input buffers (see init from external buffers)
+        m_vertices_transformed = reinterpret_cast<Vertex*>(rtcSetNewGeometryBuffer(m_handle,
+                                                RTC_BUFFER_TYPE_VERTEX,
+                                                0,
+                                                RTC_FORMAT_FLOAT3,
+                                                sizeof(Vertex),
+                                                m_num_vertices));
+        m_face_normals_transformed = Memory<Vector, RAM>(m_face_normals.size());
+        m_vertex_normals_transformed = Memory<Vector, RAM>(m_vertex_normals.size());
+        m_transform_changed = true;
     }
 
-    for(unsigned int i=0; i<m_face_normals.size(); i++)
-    {
-        auto face_normal_scaled = m_face_normals[i].multEwise(m_S);
-        m_face_normals_transformed[i] = m_T.R * face_normal_scaled.normalize();
-    }
+    const bool shared = (m_vertices_transformed == m_vertices.raw());
+
+    const unsigned int vbegin = m_vertices_changed_begin;
+    const unsigned int vend = m_vertices_changed_end;
+    const bool vertices_changed = (vbegin < vend);
 
-    // TRANSFORM VERTEX NORMALS
-    if(m_vertex_normals_transformed.size() != m_vertex_normals.size())
+    // FACE NORMALS OF CHANGED VERTICES
+    std::vector<unsigned int> faces_changed;
+    if(vertices_changed && m_face_normals.size() == m_num_faces)
     {
-        m_vertex_normals_transformed.resize(m_vertex_normals.size());
+        if(vend - vbegin > m_num_vertices / 2)
+        {
+            computeFaceNormals();
+        } else {
+            updateVertexFaces();
+            for(unsigned int i=vbegin; i<vend; i++)
+            {
+                faces_changed.insert(faces_changed.end(), 
+                    m_vertex_faces.raw() + m_vertex_faces_offsets[i], 
+                    m_vertex_faces.raw() + m_vertex_faces_offsets[i + 1]);
+            }
+            std::sort(faces_changed.begin(), faces_changed.end());
+            faces_changed.erase(std::unique(faces_changed.begin(), faces_changed.end()), faces_changed.end());
+
+            const size_t num_faces_changed = faces_changed.size();
+            #pragma omp parallel for if(num_faces_changed > PARALLEL_MIN_ELEMENTS)
+            for(size_t i=0; i<num_faces_changed; i++)
+            {
+                const Face face = m_faces[faces_changed[i]];
+                m_face_normals[faces_changed[i]] = face_normal(
+                    m_vertices[face.v0], m_vertices[face.v1], m_vertices[face.v2]);
+            }
+        }
     }
-    for(unsigned int i=0; i<m_vertex_normals.size(); i++)
+
+    if(!shared)
     {
-        auto vertex_normal_scaled = m_vertex_normals[i].multEwise(m_S);
-        m_vertex_normals_transformed[i] = m_T.R * vertex_normal_scaled.normalize();
+        // TRANSFORM VERTICES
+        const unsigned int tbegin = (m_transform_changed ? 0 : vbegin);
+        const unsigned int tend = (m_transform_changed ? m_num_vertices : vend);
+        const unsigned int num_vertices = (tbegin < tend ? tend - tbegin : 0);
+
+        #pragma omp parallel for if(num_vertices > PARALLEL_MIN_ELEMENTS)
+        for(unsigned int i=tbegin; i<tend; i++)
+        {
+            m_vertices_transformed[i] = m_T * (m_vertices[i].multEwise(m_S));
+            // also possible:
+            // m_vertices_transformed[i] = matrix() * m_vertices[i];
+            // might be slower
+        }
+
+        if(m_transform_changed || m_normals_changed)
+        {
+            // TRANSFORM FACE NORMALS
+            if(m_face_normals_transformed.size() != m_face_normals.size())
+            {
+                m_face_normals_transformed.resize(m_face_normals.size());
+            }
+
+            const unsigned int num_face_normals = m_face_normals.size();
+            #pragma omp parallel for if(num_face_normals > PARALLEL_MIN_ELEMENTS)
+            for(unsigned int i=0; i<num_face_normals; i++)
+            {
+                auto face_normal_scaled = m_face_normals[i].multEwise(m_S);
+                m_face_normals_transformed[i] = m_T.R * face_normal_scaled.normalize();
+            }
+
+            // TRANSFORM VERTEX NORMALS
+            if(m_vertex_normals_transformed.size() != m_vertex_normals.size())
+            {
+                m_vertex_normals_transformed.resize(m_vertex_normals.size());
+            }
+            const unsigned int num_vertex_normals = m_vertex_normals.size();
+            #pragma omp parallel for if(num_vertex_normals > PARALLEL_MIN_ELEMENTS)
+            for(unsigned int i=0; i<num_vertex_normals; i++)
+            {
+                auto vertex_normal_scaled = m_vertex_normals[i].multEwise(m_S);
+                m_vertex_normals_transformed[i] = m_T.R * vertex_normal_scaled.normalize();
+            }
+        } else {
+            // TRANSFORM FACE NORMALS OF CHANGED VERTICES
+            const size_t num_faces_changed = faces_changed.size();
+            #pragma omp parallel for if(num_faces_changed > PARALLEL_MIN_ELEMENTS)
+            for(size_t i=0; i<num_faces_changed; i++)
+            {
+                auto face_normal_scaled = m_face_normals[faces_changed[i]].multEwise(m_S);
+                m_face_normals_transformed[faces_changed[i]] = m_T.R * face_normal_scaled.normalize();
+            }
+        }
     }
 
     if(anyParentCommittedOnce())
     {
-        rtcUpdateGeometryBuffer(m_handle, RTC_BUFFER_TYPE_VERTEX, 0);
+        if(m_transform_changed || vertices_changed)
+        {
+            rtcUpdateGeometryBuffer(m_handle, RTC_BUFFER_TYPE_VERTEX, 0);
+        }
+        if(m_faces_changed)
+        {
+            rtcUpdateGeometryBuffer(m_handle, RTC_BUFFER_TYPE_INDEX, 0);
+        }
     }
+
+    markVerticesChanged(0, 0);
+    m_transform_changed = false;
+    m_normals_changed = false;
+    m_faces_changed = false;
 }
 
 // pt2ConstMember = &EmbreeMesh::closestPointFunc2; 
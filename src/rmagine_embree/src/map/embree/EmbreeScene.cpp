@@ -6,7 +6,9 @@
 #include <iostream>
 
 #include <map>
+#include <algorithm>
 #include <cassert>
+#include <thread>
 
 #include <rmagine/util/prints.h>
 #include <rmagine/math/assimp_conversions.h>
@@ -44,11 +46,13 @@ EmbreeScene::~EmbreeScene()
 
 void EmbreeScene::setQuality(RTCBuildQuality quality)
 {
+    m_settings.quality = quality;
     rtcSetSceneBuildQuality(m_scene, quality);
 }
 
 void EmbreeScene::setFlags(RTCSceneFlags flags)
 {
+    m_settings.flags = flags;
     rtcSetSceneFlags(m_scene, flags);
 }
 
@@ -189,6 +193,24 @@ void EmbreeScene::commit()
 {
     rtcCommitScene(m_scene);
     m_committed_once = true;
+
+    // buffers do not move until the geometries are changed, 
+    // which requires another commit
+    unsigned int num_geometries = 0;
+    for(const auto& elem : m_geometries)
+    {
+        num_geometries = std::max(num_geometries, elem.first + 1);
+    }
+
+    m_pq_geometries.assign(num_geometries, PointQueryGeometry{});
+    for(const auto& elem : m_geometries)
+    {
+        if(EmbreeMeshConstPtr mesh = std::dynamic_pointer_cast<const EmbreeMesh>(elem.second))
+        {
+            m_pq_geometries[elem.first].faces = mesh->faces().raw();
+            m_pq_geometries[elem.first].vertices = mesh->verticesTransformed().raw();
+        }
+    }
 }
 
 EmbreeInstancePtr EmbreeScene::instantiate()
@@ -198,6 +220,21 @@ EmbreeInstancePtr EmbreeScene::instantiate()
     return geom_inst;
 }
 
+EmbreeScenePtr EmbreeScene::copy() const
+{
+    EmbreeScenePtr ret = std::make_shared<EmbreeScene>(m_settings, m_device);
+
+    for(const auto& elem : m_geometries)
+    {
+        rtcAttachGeometryByID(ret->m_scene, elem.second->handle(), elem.first);
+        ret->m_geometries[elem.first] = elem.second;
+        ret->m_ids[elem.second] = elem.first;
+        elem.second->parents.insert(ret);
+    }
+
+    return ret;
+}
+
 std::unordered_set<EmbreeGeometryPtr> EmbreeScene::findLeafs() const
 {
     std::unordered_set<EmbreeGeometryPtr> ret;
@@ -259,7 +296,8 @@ void EmbreeScene::freeze()
             {
                 EmbreeMeshPtr mesh = std::dynamic_pointer_cast<EmbreeMesh>(
                     instance->scene()->geometries().begin()->second);
-                if(mesh)
+                // meshes shared by several scenes cannot take over one transform
+                if(mesh && mesh->parents.size() == 1)
                 {
                     instances_to_optimize.push_back(instance);
                 }
@@ -267,7 +305,23 @@ void EmbreeScene::freeze()
         }
     }
 
-    // remove all
+    // bake the instance transforms into the meshes, in parallel
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t i=0; i<instances_to_optimize.size(); i++)
+    {
+        EmbreeInstancePtr instance = instances_to_optimize[i];
+        EmbreeMeshPtr mesh = std::dynamic_pointer_cast<EmbreeMesh>(
+            instance->scene()->geometries().begin()->second);
+
+        // TODO check if this is correct
+        mesh->setScale(instance->scale().multEwise(mesh->scale()));
+
+        mesh->setTransform(instance->transform() * mesh->transform());
+        mesh->apply();
+        mesh->commit();
+    }
+
+    // replace the instances by their meshes
     for(auto instance : instances_to_optimize)
     {
         unsigned int instance_id = m_ids[instance];
@@ -276,21 +330,44 @@ void EmbreeScene::freeze()
         EmbreeMeshPtr mesh = std::dynamic_pointer_cast<EmbreeMesh>(
             instance->scene()->geometries().begin()->second);
 
-        if(mesh)
-        {
-            // TODO check if this is correct
-            mesh->setScale(instance->scale().multEwise(mesh->scale()));
+        unsigned int geom_id = add(mesh);
+        // std::cout << "- instance " << instance_id << " optimized to mesh " << geom_id << std::endl;
+    }
 
-            mesh->setTransform(instance->transform() * mesh->transform());
-            mesh->apply();
-            mesh->commit();
+    // std::cout << "[EmbreeScene::freeze()] finished optimizing scene.." << std::endl;
+}
 
-            unsigned int geom_id = add(mesh);
-            // std::cout << "- instance " << instance_id << " optimized to mesh " << geom_id << std::endl;
-        }
+EmbreeInstancePtr EmbreeScene::makeRigid(EmbreeMeshPtr mesh)
+{
+    EmbreeInstancePtr instance;
+
+    const EmbreeGeometryPtr geom = mesh;
+    if(!has(geom) || mesh->parents.size() != 1)
+    {
+        return instance;
     }
 
-    // std::cout << "[EmbreeScene::freeze()] finished optimizing scene.." << std::endl;
+    const Transform T = mesh->transform();
+    const Vector3 S = mesh->scale();
+
+    remove(geom);
+
+    // vertices are rewritten one last time: to the local frame
+    mesh->setTransform(Transform::Identity());
+    mesh->setScale({1.0, 1.0, 1.0});
+    mesh->apply();
+    mesh->commit();
+
+    instance = mesh->instantiate();
+    instance->name = mesh->name;
+    instance->setTransform(T);
+    instance->setScale(S);
+    instance->apply();
+    instance->commit();
+
+    add(instance);
+
+    return instance;
 }
 
 EmbreeScenePtr make_embree_scene(
@@ -305,40 +382,80 @@ EmbreeScenePtr make_embree_scene(
     std::map<unsigned int, EmbreeMeshPtr> meshes;
 
     // 1. meshes
-    // std::cout << "[make_embree_scene()] Loading Meshes..." << std::endl;
-    for(size_t i=0; i<ascene->mNumMeshes; i++)
+    // - large meshes one after another, each built by all threads
+    // - the rest concurrently, one thread per mesh
+    // a mesh is committed by its builder while the others are still built
+    std::vector<unsigned int> large_meshes;
+    std::vector<unsigned int> small_meshes;
+
+    size_t num_faces_total = 0;
+    for(unsigned int i=0; i<ascene->mNumMeshes; i++)
+    {
+        num_faces_total += ascene->mMeshes[i]->mNumFaces;
+    }
+    const size_t num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    const size_t large_mesh_faces = num_faces_total / num_threads;
+
+    for(unsigned int i=0; i<ascene->mNumMeshes; i++)
     {
-        // std::cout << "Make Mesh " << i+1 << "/" << ascene->mNumMeshes << std::endl;
         const aiMesh* amesh = ascene->mMeshes[i];
 
         if(amesh->mPrimitiveTypes & aiPrimitiveType_TRIANGLE)
         {
-            // triangle mesh
-            EmbreeMeshPtr mesh = std::make_shared<EmbreeMesh>(amesh);
-            mesh->commit();
-            meshes[i] = mesh;
+            if(amesh->mNumFaces > large_mesh_faces)
+            {
+                large_meshes.push_back(i);
+            } else {
+                small_meshes.push_back(i);
+            }
         } else {
             std::cout << "[ make_embree_scene(aiScene) ] WARNING: Could not construct geometry " << i << " prim type " << amesh->mPrimitiveTypes << " not supported yet. Skipping." << std::endl;
         }
     }
 
+    std::vector<EmbreeMeshPtr> meshes_built(ascene->mNumMeshes);
+
+    for(unsigned int mesh_id : large_meshes)
+    {
+        meshes_built[mesh_id] = std::make_shared<EmbreeMesh>(ascene->mMeshes[mesh_id], device);
+        meshes_built[mesh_id]->commit();
+    }
+
+    // biggest first for a better balance
+    std::sort(small_meshes.begin(), small_meshes.end(), 
+        [ascene](unsigned int a, unsigned int b) {
+            return ascene->mMeshes[a]->mNumFaces > ascene->mMeshes[b]->mNumFaces;
+        });
+
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t i=0; i<small_meshes.size(); i++)
+    {
+        const unsigned int mesh_id = small_meshes[i];
+        meshes_built[mesh_id] = std::make_shared<EmbreeMesh>(ascene->mMeshes[mesh_id], device);
+        meshes_built[mesh_id]->commit();
+    }
+
+    for(unsigned int i=0; i<ascene->mNumMeshes; i++)
+    {
+        if(meshes_built[i])
+        {
+            meshes[i] = meshes_built[i];
+        }
+    }
+
     std::unordered_set<EmbreeGeometryPtr> instanciated_meshes;
 
     // 2. instances
     const aiNode* root_node = ascene->mRootNode;
     std::vector<const aiNode*> mesh_nodes = get_nodes_with_meshes(root_node);
 
-    // std::cout << "[make_embree_scene()] Loading Instances..." << std::endl;
+    // geometries can only be added sequentially: they register their parents
+    std::vector<EmbreeScenePtr> mesh_scenes(mesh_nodes.size());
     for(size_t i=0; i<mesh_nodes.size(); i++)
     {
         const aiNode* node = mesh_nodes[i];
-        
-        Matrix4x4 M = global_transform(node);
-        Transform T;
-        Vector3 scale;
-        decompose(M, T, scale);
 
-        EmbreeScenePtr mesh_scene = std::make_shared<EmbreeScene>();
+        EmbreeScenePtr mesh_scene = std::make_shared<EmbreeScene>(EmbreeSceneSettings{}, device);
 
         for(unsigned int i = 0; i<node->mNumMeshes; i++)
         {
@@ -350,25 +467,43 @@ EmbreeScenePtr make_embree_scene(
                 EmbreeMeshPtr mesh = mesh_it->second;
                 instanciated_meshes.insert(mesh);
                 mesh_scene->add(mesh);
-                mesh_scene->commit();
             } else {
                 std::cout << "[make_embree_scene()] WARNING: could not find mesh_id " 
                     << mesh_id << " in meshes during instantiation" << std::endl;
             }
         }
 
-        mesh_scene->commit();
+        mesh_scenes[i] = mesh_scene;
+    }
+
+    // building the BVHs of the instanced scenes is independent
+    std::vector<EmbreeInstancePtr> mesh_instances(mesh_nodes.size());
 
-        // std::cout << "--- mesh added to mesh_scene" << std::endl;
-        EmbreeInstancePtr mesh_instance = std::make_shared<EmbreeInstance>();
-        mesh_instance->set(mesh_scene);
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t i=0; i<mesh_nodes.size(); i++)
+    {
+        const aiNode* node = mesh_nodes[i];
+        
+        Matrix4x4 M = global_transform(node);
+        Transform T;
+        Vector3 scale;
+        decompose(M, T, scale);
+
+        mesh_scenes[i]->commit();
+
+        EmbreeInstancePtr mesh_instance = std::make_shared<EmbreeInstance>(device);
+        mesh_instance->set(mesh_scenes[i]);
         mesh_instance->name = node->mName.C_Str();
         mesh_instance->setTransform(T);
         mesh_instance->setScale(scale);
         mesh_instance->apply();
         mesh_instance->commit();
-        // std::cout << "--- mesh_instance created" << std::endl;
-        scene->add(mesh_instance);
+        mesh_instances[i] = mesh_instance;
+    }
+
+    for(size_t i=0; i<mesh_instances.size(); i++)
+    {
+        scene->add(mesh_instances[i]);
     }
 
     // std::cout << "add meshes that are not instanciated ..." << std::endl;
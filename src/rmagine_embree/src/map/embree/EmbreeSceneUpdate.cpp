@@ -0,0 +1,235 @@
+#include "rmagine/map/embree/EmbreeSceneUpdate.hpp"
+
+#include "rmagine/map/embree/EmbreeInstance.hpp"
+
+#include <rmagine/util/StopWatch.hpp>
+#include <rmagine/util/exceptions.h>
+
+#include <unordered_set>
+#include <utility>
+
+namespace rmagine
+{
+
+EmbreeSceneUpdate::EmbreeSceneUpdate(
+    EmbreeScenePtr scene,
+    unsigned int max_refits)
+:m_scene(scene)
+,m_max_refits(max_refits)
+{
+
+}
+
+EmbreeSceneUpdate::Change& EmbreeSceneUpdate::change(EmbreeGeometryPtr geom)
+{
+    auto res = m_changes.emplace(geom, Change{});
+    if(res.second)
+    {
+        m_geometries.push_back(geom);
+    }
+    return res.first->second;
+}
+
+void EmbreeSceneUpdate::setTransform(EmbreeGeometryPtr geom, const Transform& T)
+{
+    change(geom).T = T;
+}
+
+void EmbreeSceneUpdate::setScale(EmbreeGeometryPtr geom, const Vector3& S)
+{
+    change(geom).S = S;
+}
+
+void EmbreeSceneUpdate::setVertices(
+    EmbreeMeshPtr mesh, 
+    const MemoryView<Vertex, RAM>& vertices, 
+    unsigned int offset)
+{
+    if(offset + vertices.size() > std::as_const(*mesh).vertices().size())
+    {
+        RM_THROW(EmbreeException, "EmbreeSceneUpdate::setVertices: range exceeds the number of vertices.");
+    }
+    change(mesh).vertices.emplace_back(offset, Memory<Vertex, RAM>(vertices));
+}
+
+void EmbreeSceneUpdate::touch(EmbreeGeometryPtr geom, bool topology_changed)
+{
+    Change& c = change(geom);
+    c.topology_changed = c.topology_changed || topology_changed;
+}
+
+unsigned int EmbreeSceneUpdate::refits(EmbreeGeometryPtr geom) const
+{
+    auto it = m_refits.find(geom);
+    if(it == m_refits.end())
+    {
+        return 0;
+    }
+    return it->second;
+}
+
+size_t EmbreeSceneUpdate::size() const
+{
+    return m_geometries.size();
+}
+
+EmbreeSceneUpdateTimings EmbreeSceneUpdate::commit()
+{
+    EmbreeSceneUpdateTimings timings;
+    StopWatch sw_total, sw;
+    sw_total();
+
+    // 1. APPLY
+    // one geometry: the loops inside apply() are parallel instead
+    sw();
+    const size_t num_geometries = m_geometries.size();
+    #pragma omp parallel for schedule(dynamic) if(num_geometries > 1)
+    for(size_t i=0; i<num_geometries; i++)
+    {
+        const EmbreeGeometryPtr& geom = m_geometries[i];
+        const Change& c = m_changes.at(geom);
+
+        if(c.T)
+        {
+            geom->setTransform(*c.T);
+        }
+        if(c.S)
+        {
+            geom->setScale(*c.S);
+        }
+
+        if(!c.vertices.empty())
+        {
+            EmbreeMeshPtr mesh = std::static_pointer_cast<EmbreeMesh>(geom);
+            for(const auto& elem : c.vertices)
+            {
+                mesh->setVertices(elem.second, elem.first);
+            }
+        }
+
+        geom->apply();
+    }
+    timings.apply = sw();
+
+    // 2. COMMIT GEOMETRIES
+    // meshes: refit if the topology was kept
+    std::vector<RTCBuildQuality> qualities(num_geometries, RTC_BUILD_QUALITY_MEDIUM);
+    for(size_t i=0; i<num_geometries; i++)
+    {
+        const EmbreeGeometryPtr& geom = m_geometries[i];
+        qualities[i] = geom->quality();
+
+        if(geom->type() == EmbreeGeometryType::MESH)
+        {
+            unsigned int& refits = m_refits[geom];
+            if(!m_changes.at(geom).topology_changed && refits < m_max_refits)
+            {
+                qualities[i] = RTC_BUILD_QUALITY_REFIT;
+                refits++;
+            } else {
+                refits = 0;
+            }
+        }
+    }
+
+    sw();
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t i=0; i<num_geometries; i++)
+    {
+        rtcSetGeometryBuildQuality(m_geometries[i]->handle(), qualities[i]);
+        m_geometries[i]->commit();
+    }
+    timings.commit_geometries = sw();
+
+    // 3. COMMIT SCENES
+    // every scene only once, after all scenes it instances
+    std::vector<std::unordered_set<EmbreeScenePtr> > levels;
+    std::unordered_map<EmbreeScenePtr, size_t> scene_level;
+
+    std::unordered_set<EmbreeScenePtr> level;
+    for(const EmbreeGeometryPtr& geom : m_geometries)
+    {
+        for(const EmbreeSceneWPtr& parent_w : geom->parents)
+        {
+            if(EmbreeScenePtr parent = parent_w.lock())
+            {
+                level.insert(parent);
+            }
+        }
+    }
+
+    while(!level.empty())
+    {
+        std::unordered_set<EmbreeScenePtr> next_level;
+        for(const EmbreeScenePtr& scene : level)
+        {
+            scene_level[scene] = levels.size();
+            for(const EmbreeInstanceWPtr& inst_w : scene->parents)
+            {
+                if(EmbreeInstancePtr inst = inst_w.lock())
+                {
+                    for(const EmbreeSceneWPtr& parent_w : inst->parents)
+                    {
+                        if(EmbreeScenePtr parent = parent_w.lock())
+                        {
+                            next_level.insert(parent);
+                        }
+                    }
+                }
+            }
+        }
+        levels.push_back(std::move(level));
+        level = std::move(next_level);
+    }
+
+    sw();
+    for(size_t i=0; i<levels.size(); i++)
+    {
+        // scenes that reappear in a higher level are committed there
+        std::vector<EmbreeScenePtr> scenes;
+        for(const EmbreeScenePtr& scene : levels[i])
+        {
+            if(scene_level[scene] == i)
+            {
+                scenes.push_back(scene);
+            }
+        }
+
+        #pragma omp parallel for schedule(dynamic) if(scenes.size() > 1)
+        for(size_t j=0; j<scenes.size(); j++)
+        {
+            scenes[j]->commit();
+        }
+    }
+    timings.commit_scenes = sw();
+
+    // the BVHs are built: back to the geometries' own qualities, 
+    // so that commits outside of this update do not refit
+    for(size_t i=0; i<num_geometries; i++)
+    {
+        if(qualities[i] != m_geometries[i]->quality())
+        {
+            rtcSetGeometryBuildQuality(m_geometries[i]->handle(), m_geometries[i]->quality());
+        }
+    }
+
+    // forget expired geometries
+    for(auto it = m_refits.begin(); it != m_refits.end();)
+    {
+        if(it->first.expired())
+        {
+            it = m_refits.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    m_geometries.clear();
+    m_changes.clear();
+
+    timings.total = sw_total();
+    m_timings = timings;
+    return timings;
+}
+
+} // namespace rmagine
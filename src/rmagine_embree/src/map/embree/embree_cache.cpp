@@ -0,0 +1,449 @@
+#include "rmagine/map/embree/embree_cache.h"
+
+#include "rmagine/map/embree/EmbreeMesh.hpp"
+#include "rmagine/map/embree/EmbreeInstance.hpp"
+
+#include <rmagine/util/exceptions.h>
+
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace rmagine
+{
+
+namespace
+{
+
+/**
+ * File layout (version 1):
+ * 
+ * | CacheHeader | CacheMesh[] | CacheInstance[] | CacheScene[] | data ... |
+ * 
+ * Every table and buffer starts at a multiple of CACHE_ALIGNMENT. 
+ * Offsets are counted in bytes from the beginning of the file.
+ */
+constexpr char CACHE_MAGIC[4] = {'R', 'M', 'S', 'C'};
+constexpr uint32_t CACHE_VERSION = 1;
+constexpr uint64_t CACHE_ALIGNMENT = 64;
+
+// Embree reads shared vertex buffers with 16 byte loads
+constexpr uint64_t VERTEX_PADDING = 16;
+
+struct CacheHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t meshes;
+    uint64_t instances;
+    uint64_t scenes;
+    uint32_t num_meshes;
+    uint32_t num_instances;
+    // scenes are stored children first: the last one is the root
+    uint32_t num_scenes;
+    uint32_t reserved;
+};
+
+struct CacheMesh
+{
+    uint64_t vertices;
+    uint64_t faces;
+    // 0: not stored
+    uint64_t face_normals;
+    uint64_t vertex_normals;
+    uint64_t name;
+    uint32_t num_vertices;
+    uint32_t num_faces;
+    uint32_t name_length;
+    uint32_t reserved;
+};
+
+struct CacheInstance
+{
+    float R[4]; // x, y, z, w
+    float t[3];
+    float S[3];
+    uint32_t scene;
+    uint32_t name_length;
+    uint64_t name;
+};
+
+struct CacheScene
+{
+    uint64_t children;
+    uint32_t num_children;
+    uint32_t quality;
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+struct CacheChild
+{
+    uint32_t type; // EmbreeGeometryType
+    uint32_t index;
+};
+
+/**
+ * @brief All objects reachable from a root scene, indexed in writing order
+ */
+struct CacheGraph
+{
+    std::vector<EmbreeMeshPtr> meshes;
+    std::vector<EmbreeInstancePtr> instances;
+    std::vector<uint32_t> instance_scenes;
+    std::vector<EmbreeScenePtr> scenes;
+    std::vector<std::vector<CacheChild> > children;
+
+    std::unordered_map<EmbreeMeshPtr, uint32_t> mesh_ids;
+    std::unordered_map<EmbreeInstancePtr, uint32_t> instance_ids;
+    std::unordered_map<EmbreeScenePtr, uint32_t> scene_ids;
+};
+
+uint32_t collect(EmbreeScenePtr scene, CacheGraph& graph)
+{
+    auto scene_it = graph.scene_ids.find(scene);
+    if(scene_it != graph.scene_ids.end())
+    {
+        return scene_it->second;
+    }
+
+    // ordered by geometry id
+    const auto geometries_unordered = scene->geometries();
+    const std::map<unsigned int, EmbreeGeometryPtr> geometries(
+        geometries_unordered.begin(), geometries_unordered.end());
+
+    std::vector<CacheChild> children;
+    for(const auto& elem : geometries)
+    {
+        if(EmbreeMeshPtr mesh = std::dynamic_pointer_cast<EmbreeMesh>(elem.second))
+        {
+            auto res = graph.mesh_ids.emplace(mesh, graph.meshes.size());
+            if(res.second)
+            {
+                graph.meshes.push_back(mesh);
+            }
+            children.push_back({static_cast<uint32_t>(EmbreeGeometryType::MESH), res.first->second});
+        } else if(EmbreeInstancePtr inst = std::dynamic_pointer_cast<EmbreeInstance>(elem.second)) {
+            auto inst_it = graph.instance_ids.find(inst);
+            if(inst_it == graph.instance_ids.end())
+            {
+                // instanced scenes are written before the scenes referencing them
+                const uint32_t scene_id = collect(inst->scene(), graph);
+                inst_it = graph.instance_ids.emplace(inst, graph.instances.size()).first;
+                graph.instances.push_back(inst);
+                graph.instance_scenes.push_back(scene_id);
+            }
+            children.push_back({static_cast<uint32_t>(EmbreeGeometryType::INSTANCE), inst_it->second});
+        } else {
+            std::cout << "[save_embree_scene()] WARNING: geometry " << elem.first << " is neither mesh nor instance. Skipping." << std::endl;
+        }
+    }
+
+    const uint32_t scene_id = graph.scenes.size();
+    graph.scenes.push_back(scene);
+    graph.children.push_back(std::move(children));
+    graph.scene_ids[scene] = scene_id;
+    return scene_id;
+}
+
+/**
+ * @brief Places buffers in the file and writes them in one sequential pass
+ */
+class CacheWriter
+{
+public:
+    uint64_t add(const void* data, uint64_t bytes, uint64_t padding = 0)
+    {
+        m_size = (m_size + CACHE_ALIGNMENT - 1) / CACHE_ALIGNMENT * CACHE_ALIGNMENT;
+        const uint64_t offset = m_size;
+        m_blobs.push_back({offset, data, bytes});
+        m_size += bytes + padding;
+        return offset;
+    }
+
+    void write(std::ofstream& file) const
+    {
+        const char zeros[CACHE_ALIGNMENT + VERTEX_PADDING] = {};
+
+        uint64_t pos = 0;
+        for(const Blob& blob : m_blobs)
+        {
+            file.write(zeros, blob.offset - pos);
+            file.write(static_cast<const char*>(blob.data), blob.bytes);
+            pos = blob.offset + blob.bytes;
+        }
+        file.write(zeros, m_size - pos);
+    }
+
+private:
+    struct Blob
+    {
+        uint64_t offset;
+        const void* data;
+        uint64_t bytes;
+    };
+
+    std::vector<Blob> m_blobs;
+    uint64_t m_size = 0;
+};
+
+} // namespace
+
+void save_embree_scene(
+    EmbreeScenePtr scene, 
+    const std::string& filename)
+{
+    CacheGraph graph;
+    collect(scene, graph);
+
+    CacheHeader header = {};
+    std::copy(CACHE_MAGIC, CACHE_MAGIC + 4, header.magic);
+    header.version = CACHE_VERSION;
+    header.num_meshes = graph.meshes.size();
+    header.num_instances = graph.instances.size();
+    header.num_scenes = graph.scenes.size();
+
+    std::vector<CacheMesh> mesh_records(graph.meshes.size(), CacheMesh{});
+    std::vector<CacheInstance> instance_records(graph.instances.size(), CacheInstance{});
+    std::vector<CacheScene> scene_records(graph.scenes.size(), CacheScene{});
+
+    // tables first: they are filled while the buffers are placed
+    CacheWriter writer;
+    writer.add(&header, sizeof(CacheHeader));
+    header.meshes = writer.add(mesh_records.data(), mesh_records.size() * sizeof(CacheMesh));
+    header.instances = writer.add(instance_records.data(), instance_records.size() * sizeof(CacheInstance));
+    header.scenes = writer.add(scene_records.data(), scene_records.size() * sizeof(CacheScene));
+
+    for(size_t i=0; i<graph.meshes.size(); i++)
+    {
+        EmbreeMeshConstPtr mesh = graph.meshes[i];
+        CacheMesh& rec = mesh_records[i];
+
+        // transform of the mesh is baked into the stored buffers
+        const MemoryView<const Vertex, RAM> vertices = mesh->verticesTransformed();
+        const MemoryView<const Face, RAM> faces = mesh->faces();
+        const MemoryView<const Vector, RAM> face_normals = mesh->faceNormalsTransformed();
+        const MemoryView<const Vector, RAM> vertex_normals = mesh->vertexNormalsTransformed();
+
+        rec.num_vertices = vertices.size();
+        rec.num_faces = faces.size();
+        rec.vertices = writer.add(vertices.raw(), vertices.size() * sizeof(Vertex), VERTEX_PADDING);
+        rec.faces = writer.add(faces.raw(), faces.size() * sizeof(Face));
+        if(face_normals.size() == faces.size() && faces.size() > 0)
+        {
+            rec.face_normals = writer.add(face_normals.raw(), face_normals.size() * sizeof(Vector));
+        }
+        if(vertex_normals.size() == vertices.size() && vertices.size() > 0)
+        {
+            rec.vertex_normals = writer.add(vertex_normals.raw(), vertex_normals.size() * sizeof(Vector));
+        }
+        rec.name_length = mesh->name.size();
+        rec.name = writer.add(mesh->name.data(), mesh->name.size());
+    }
+
+    for(size_t i=0; i<graph.instances.size(); i++)
+    {
+        const EmbreeInstancePtr& inst = graph.instances[i];
+        CacheInstance& rec = instance_records[i];
+
+        const Transform T = inst->transform();
+        const Vector3 S = inst->scale();
+        rec.R[0] = T.R.x; rec.R[1] = T.R.y; rec.R[2] = T.R.z; rec.R[3] = T.R.w;
+        rec.t[0] = T.t.x; rec.t[1] = T.t.y; rec.t[2] = T.t.z;
+        rec.S[0] = S.x; rec.S[1] = S.y; rec.S[2] = S.z;
+        rec.scene = graph.instance_scenes[i];
+        rec.name_length = inst->name.size();
+        rec.name = writer.add(inst->name.data(), inst->name.size());
+    }
+
+    for(size_t i=0; i<graph.scenes.size(); i++)
+    {
+        const EmbreeSceneSettings settings = graph.scenes[i]->settings();
+        CacheScene& rec = scene_records[i];
+
+        rec.num_children = graph.children[i].size();
+        rec.quality = static_cast<uint32_t>(settings.quality);
+        rec.flags = static_cast<uint32_t>(settings.flags);
+        rec.children = writer.add(graph.children[i].data(), graph.children[i].size() * sizeof(CacheChild));
+    }
+
+    std::ofstream file(filename, std::ios::binary);
+    if(!file)
+    {
+        RM_THROW(Exception, "save_embree_scene: cannot open '" + filename + "'.");
+    }
+
+    writer.write(file);
+
+    if(!file)
+    {
+        RM_THROW(Exception, "save_embree_scene: writing '" + filename + "' failed.");
+    }
+}
+
+EmbreeScenePtr load_embree_scene(
+    const std::string& filename,
+    EmbreeDevicePtr device)
+{
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+        RM_THROW(Exception, "load_embree_scene: cannot open '" + filename + "'.");
+    }
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || static_cast<uint64_t>(st.st_size) < sizeof(CacheHeader))
+    {
+        close(fd);
+        RM_THROW(Exception, "load_embree_scene: '" + filename + "' is no scene cache.");
+    }
+
+    const uint64_t size = st.st_size;
+
+    // private: writes to the meshes are copy-on-write and never reach the file
+    void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if(addr == MAP_FAILED)
+    {
+        RM_THROW(Exception, "load_embree_scene: cannot map '" + filename + "'.");
+    }
+
+    // unmapped as soon as the last mesh using the buffers is destroyed
+    std::shared_ptr<void> holder(addr, [size](void* p) { munmap(p, size); });
+    char* base = static_cast<char*>(addr);
+
+    auto check = [&](uint64_t offset, uint64_t bytes)
+    {
+        if(offset > size || bytes > size - offset)
+        {
+            RM_THROW(Exception, "load_embree_scene: '" + filename + "' is truncated or corrupted.");
+        }
+    };
+
+    CacheHeader header;
+    std::memcpy(&header, base, sizeof(CacheHeader));
+
+    if(!std::equal(CACHE_MAGIC, CACHE_MAGIC + 4, header.magic) || header.version != CACHE_VERSION)
+    {
+        RM_THROW(Exception, "load_embree_scene: '" + filename + "' is no scene cache of version " + std::to_string(CACHE_VERSION) + ".");
+    }
+
+    if(header.num_scenes == 0)
+    {
+        RM_THROW(Exception, "load_embree_scene: '" + filename + "' contains no scene.");
+    }
+
+    check(header.meshes, uint64_t(header.num_meshes) * sizeof(CacheMesh));
+    check(header.instances, uint64_t(header.num_instances) * sizeof(CacheInstance));
+    check(header.scenes, uint64_t(header.num_scenes) * sizeof(CacheScene));
+
+    const CacheMesh* mesh_records = reinterpret_cast<const CacheMesh*>(base + header.meshes);
+    const CacheInstance* instance_records = reinterpret_cast<const CacheInstance*>(base + header.instances);
+    const CacheScene* scene_records = reinterpret_cast<const CacheScene*>(base + header.scenes);
+
+    // 1. meshes on the mapped buffers
+    std::vector<EmbreeMeshPtr> meshes(header.num_meshes);
+    for(size_t i=0; i<meshes.size(); i++)
+    {
+        const CacheMesh& rec = mesh_records[i];
+        const uint64_t num_face_normals = (rec.face_normals ? rec.num_faces : 0);
+        const uint64_t num_vertex_normals = (rec.vertex_normals ? rec.num_vertices : 0);
+
+        check(rec.vertices, uint64_t(rec.num_vertices) * sizeof(Vertex) + VERTEX_PADDING);
+        check(rec.faces, uint64_t(rec.num_faces) * sizeof(Face));
+        check(rec.face_normals, num_face_normals * sizeof(Vector));
+        check(rec.vertex_normals, num_vertex_normals * sizeof(Vector));
+        check(rec.name, rec.name_length);
+
+        EmbreeMeshPtr mesh = std::make_shared<EmbreeMesh>(device);
+        mesh->init(
+            MemoryView<Vertex, RAM>(reinterpret_cast<Vertex*>(base + rec.vertices), rec.num_vertices),
+            MemoryView<Face, RAM>(reinterpret_cast<Face*>(base + rec.faces), rec.num_faces),
+            MemoryView<Vector, RAM>(reinterpret_cast<Vector*>(base + rec.face_normals), num_face_normals),
+            MemoryView<Vector, RAM>(reinterpret_cast<Vector*>(base + rec.vertex_normals), num_vertex_normals),
+            holder);
+        mesh->name = std::string(base + rec.name, rec.name_length);
+        mesh->commit();
+        meshes[i] = mesh;
+    }
+
+    // 2. scenes, children first. Instances are created on first use
+    std::vector<EmbreeInstancePtr> instances(header.num_instances);
+    std::vector<EmbreeScenePtr> scenes(header.num_scenes);
+    for(size_t i=0; i<scenes.size(); i++)
+    {
+        const CacheScene& rec = scene_records[i];
+        check(rec.children, uint64_t(rec.num_children) * sizeof(CacheChild));
+        const CacheChild* children = reinterpret_cast<const CacheChild*>(base + rec.children);
+
+        EmbreeSceneSettings settings;
+        settings.quality = static_cast<RTCBuildQuality>(rec.quality);
+        settings.flags = static_cast<RTCSceneFlags>(rec.flags);
+        EmbreeScenePtr scene = std::make_shared<EmbreeScene>(settings, device);
+
+        for(size_t j=0; j<rec.num_children; j++)
+        {
+            const CacheChild child = children[j];
+
+            if(child.type == static_cast<uint32_t>(EmbreeGeometryType::MESH) 
+                && child.index < meshes.size())
+            {
+                scene->add(meshes[child.index]);
+            } else if(child.type == static_cast<uint32_t>(EmbreeGeometryType::INSTANCE) 
+                && child.index < instances.size()) {
+                
+                if(!instances[child.index])
+                {
+                    const CacheInstance& inst_rec = instance_records[child.index];
+                    if(inst_rec.scene >= i)
+                    {
+                        RM_THROW(Exception, "load_embree_scene: '" + filename + "' is corrupted: instance of unknown scene.");
+                    }
+                    check(inst_rec.name, inst_rec.name_length);
+
+                    Transform T = Transform::Identity();
+                    T.R = {inst_rec.R[0], inst_rec.R[1], inst_rec.R[2], inst_rec.R[3]};
+                    T.t = {inst_rec.t[0], inst_rec.t[1], inst_rec.t[2]};
+
+                    EmbreeInstancePtr inst = std::make_shared<EmbreeInstance>(device);
+                    inst->set(scenes[inst_rec.scene]);
+                    inst->name = std::string(base + inst_rec.name, inst_rec.name_length);
+                    inst->setTransform(T);
+                    inst->setScale({inst_rec.S[0], inst_rec.S[1], inst_rec.S[2]});
+                    inst->apply();
+                    inst->commit();
+                    instances[child.index] = inst;
+                }
+
+                scene->add(instances[child.index]);
+            } else {
+                RM_THROW(Exception, "load_embree_scene: '" + filename + "' is corrupted: unknown child.");
+            }
+        }
+
+        scene->commit();
+        scenes[i] = scene;
+    }
+
+    return scenes.back();
+}
+
+bool is_embree_scene_cache(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    char magic[4];
+    file.read(magic, sizeof(magic));
+    return file && std::equal(magic, magic + 4, CACHE_MAGIC);
+}
+
+} // namespace rmagine
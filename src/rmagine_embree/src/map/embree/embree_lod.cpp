@@ -0,0 +1,590 @@
+#include "rmagine/map/embree/embree_lod.h"
+
+#include "rmagine/map/embree/EmbreeInstance.hpp"
+
+#include <rmagine/util/exceptions.h>
+
+#include <vector>
+#include <unordered_set>
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <utility>
+#include <limits>
+
+namespace rmagine
+{
+
+namespace
+{
+
+// below this number of elements the per-element loops stay sequential
+constexpr unsigned int PARALLEL_MIN_ELEMENTS = 4096;
+
+/**
+ * @brief Quadric error: sum of squared distances to a set of planes.
+ * Symmetric 4x4 matrix, stored as a00 a01 a02 a03 a11 a12 a13 a22 a23 a33
+ */
+struct Quadric
+{
+    double a[10] = {};
+
+    static Quadric plane(double nx, double ny, double nz, double d)
+    {
+        Quadric q;
+        q.a[0] = nx * nx; q.a[1] = nx * ny; q.a[2] = nx * nz; q.a[3] = nx * d;
+        q.a[4] = ny * ny; q.a[5] = ny * nz; q.a[6] = ny * d;
+        q.a[7] = nz * nz; q.a[8] = nz * d;
+        q.a[9] = d * d;
+        return q;
+    }
+
+    Quadric& operator+=(const Quadric& o)
+    {
+        for(size_t i=0; i<10; i++)
+        {
+            a[i] += o.a[i];
+        }
+        return *this;
+    }
+
+    double error(const Vector& p) const
+    {
+        const double x = p.x, y = p.y, z = p.z;
+        const double e = a[0] * x * x + 2.0 * a[1] * x * y + 2.0 * a[2] * x * z + 2.0 * a[3] * x
+                       + a[4] * y * y + 2.0 * a[5] * y * z + 2.0 * a[6] * y
+                       + a[7] * z * z + 2.0 * a[8] * z
+                       + a[9];
+        return std::max(e, 0.0);
+    }
+
+    /**
+     * @brief position of the minimal error. false if not unique, e.g. on flat regions
+     */
+    bool minimum(Vector& p) const
+    {
+        // cofactors of the upper 3x3 block
+        const double c00 = a[4] * a[7] - a[5] * a[5];
+        const double c01 = a[2] * a[5] - a[1] * a[7];
+        const double c02 = a[1] * a[5] - a[2] * a[4];
+        const double c11 = a[0] * a[7] - a[2] * a[2];
+        const double c12 = a[1] * a[2] - a[0] * a[5];
+        const double c22 = a[0] * a[4] - a[1] * a[1];
+
+        const double det = a[0] * c00 + a[1] * c01 + a[2] * c02;
+        const double tr = a[0] + a[4] + a[7];
+        if(std::fabs(det) <= 1e-9 * tr * tr * tr)
+        {
+            return false;
+        }
+
+        const double b0 = -a[3], b1 = -a[6], b2 = -a[8];
+        p.x = (c00 * b0 + c01 * b1 + c02 * b2) / det;
+        p.y = (c01 * b0 + c11 * b1 + c12 * b2) / det;
+        p.z = (c02 * b0 + c12 * b1 + c22 * b2) / det;
+        return true;
+    }
+};
+
+struct Collapse
+{
+    double cost;
+    // v1 is merged into v0
+    unsigned int v0;
+    unsigned int v1;
+    // versions of v0 and v1 the collapse was computed for
+    unsigned int version0;
+    unsigned int version1;
+    Vector p;
+
+    bool operator>(const Collapse& o) const
+    {
+        return cost > o.cost;
+    }
+};
+
+class Simplifier
+{
+public:
+    Simplifier(
+        const MemoryView<const Vertex, RAM>& vertices, 
+        const MemoryView<const Face, RAM>& faces);
+
+    /**
+     * @return largest error of the applied collapses
+     */
+    double run(double max_error);
+
+    void result(std::vector<Vertex>& vertices, std::vector<Face>& faces) const;
+
+private:
+    Collapse candidate(unsigned int v0, unsigned int v1) const;
+
+    bool collapse(const Collapse& c);
+
+    void neighbors(unsigned int v, std::vector<unsigned int>& ret) const;
+
+    bool contains(unsigned int f, unsigned int v) const
+    {
+        return m_faces[f].v0 == v || m_faces[f].v1 == v || m_faces[f].v2 == v;
+    }
+
+    std::vector<Vertex> m_vertices;
+    std::vector<Face> m_faces;
+    std::vector<char> m_faces_alive;
+    std::vector<char> m_vertices_alive;
+    std::vector<unsigned int> m_versions;
+    std::vector<Quadric> m_quadrics;
+    std::vector<std::vector<unsigned int> > m_vertex_faces;
+    std::vector<Collapse> m_heap;
+};
+
+Simplifier::Simplifier(
+    const MemoryView<const Vertex, RAM>& vertices, 
+    const MemoryView<const Face, RAM>& faces)
+:m_vertices(vertices.raw(), vertices.raw() + vertices.size())
+,m_faces(faces.raw(), faces.raw() + faces.size())
+,m_faces_alive(faces.size(), 1)
+,m_vertices_alive(vertices.size(), 1)
+,m_versions(vertices.size(), 0)
+,m_quadrics(vertices.size())
+,m_vertex_faces(vertices.size())
+{
+    for(size_t i=0; i<m_faces.size(); i++)
+    {
+        m_vertex_faces[m_faces[i].v0].push_back(i);
+        m_vertex_faces[m_faces[i].v1].push_back(i);
+        m_vertex_faces[m_faces[i].v2].push_back(i);
+    }
+
+    // planes of the faces
+    std::vector<Quadric> face_quadrics(m_faces.size());
+    std::vector<Vector> face_normals(m_faces.size());
+    #pragma omp parallel for if(m_faces.size() > PARALLEL_MIN_ELEMENTS)
+    for(size_t i=0; i<m_faces.size(); i++)
+    {
+        const Face& f = m_faces[i];
+        const Vector n = (m_vertices[f.v1] - m_vertices[f.v0]).cross(m_vertices[f.v2] - m_vertices[f.v0]);
+        const float l = n.l2norm();
+        if(l > 0.0)
+        {
+            face_normals[i] = n / l;
+            face_quadrics[i] = Quadric::plane(
+                face_normals[i].x, face_normals[i].y, face_normals[i].z, 
+                -face_normals[i].dot(m_vertices[f.v0]));
+        } else {
+            face_normals[i] = {0.0, 0.0, 0.0};
+        }
+    }
+
+    // gather per vertex: no two threads write the same quadric
+    #pragma omp parallel for if(m_vertices.size() > PARALLEL_MIN_ELEMENTS)
+    for(size_t i=0; i<m_vertices.size(); i++)
+    {
+        for(unsigned int f : m_vertex_faces[i])
+        {
+            m_quadrics[i] += face_quadrics[f];
+        }
+    }
+
+    // edges as (v_min, v_max, face), sorted
+    std::vector<std::pair<uint64_t, unsigned int> > edges;
+    edges.reserve(m_faces.size() * 3);
+    for(size_t i=0; i<m_faces.size(); i++)
+    {
+        const unsigned int v[3] = {m_faces[i].v0, m_faces[i].v1, m_faces[i].v2};
+        for(size_t j=0; j<3; j++)
+        {
+            const uint64_t a = std::min(v[j], v[(j+1)%3]);
+            const uint64_t b = std::max(v[j], v[(j+1)%3]);
+            edges.push_back({(a << 32) | b, i});
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    std::vector<std::pair<unsigned int, unsigned int> > unique_edges;
+    for(size_t i=0; i<edges.size(); )
+    {
+        size_t j = i + 1;
+        while(j < edges.size() && edges[j].first == edges[i].first)
+        {
+            j++;
+        }
+
+        const unsigned int a = edges[i].first >> 32;
+        const unsigned int b = edges[i].first & 0xFFFFFFFF;
+        unique_edges.push_back({a, b});
+
+        if(j - i == 1)
+        {
+            // border: keep it within a plane perpendicular to its face
+            const Vector& n = face_normals[edges[i].second];
+            Vector m = (m_vertices[b] - m_vertices[a]).cross(n);
+            const float l = m.l2norm();
+            if(l > 0.0)
+            {
+                m = m / l;
+                const Quadric q = Quadric::plane(m.x, m.y, m.z, -m.dot(m_vertices[a]));
+                m_quadrics[a] += q;
+                m_quadrics[b] += q;
+            }
+        }
+
+        i = j;
+    }
+
+    m_heap.resize(unique_edges.size());
+    #pragma omp parallel for if(unique_edges.size() > PARALLEL_MIN_ELEMENTS)
+    for(size_t i=0; i<unique_edges.size(); i++)
+    {
+        m_heap[i] = candidate(unique_edges[i].first, unique_edges[i].second);
+    }
+    std::make_heap(m_heap.begin(), m_heap.end(), std::greater<Collapse>());
+}
+
+Collapse Simplifier::candidate(unsigned int v0, unsigned int v1) const
+{
+    Quadric q = m_quadrics[v0];
+    q += m_quadrics[v1];
+
+    Collapse c;
+    c.v0 = v0;
+    c.v1 = v1;
+    c.version0 = m_versions[v0];
+    c.version1 = m_versions[v1];
+
+    // the optimum is not always valid: also try the end points and the midpoint
+    std::vector<Vector> positions = {
+        m_vertices[v0], 
+        m_vertices[v1], 
+        (m_vertices[v0] + m_vertices[v1]) / 2.0};
+    Vector p_min;
+    if(q.minimum(p_min))
+    {
+        positions.push_back(p_min);
+    }
+
+    c.cost = std::numeric_limits<double>::max();
+    for(const Vector& p : positions)
+    {
+        const double cost = q.error(p);
+        if(cost < c.cost)
+        {
+            c.cost = cost;
+            c.p = p;
+        }
+    }
+
+    return c;
+}
+
+void Simplifier::neighbors(unsigned int v, std::vector<unsigned int>& ret) const
+{
+    ret.clear();
+    for(unsigned int f : m_vertex_faces[v])
+    {
+        if(!m_faces_alive[f])
+        {
+            continue;
+        }
+        for(unsigned int w : {m_faces[f].v0, m_faces[f].v1, m_faces[f].v2})
+        {
+            if(w != v)
+            {
+                ret.push_back(w);
+            }
+        }
+    }
+    std::sort(ret.begin(), ret.end());
+    ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
+}
+
+bool Simplifier::collapse(const Collapse& c)
+{
+    const unsigned int u = c.v0;
+    const unsigned int v = c.v1;
+
+    size_t shared = 0;
+    for(unsigned int f : m_vertex_faces[v])
+    {
+        if(m_faces_alive[f] && contains(f, u))
+        {
+            shared++;
+        }
+    }
+
+    // link condition: the only common neighbors are the opposite vertices of 
+    // the shared faces. Otherwise the collapse pinches the surface
+    std::vector<unsigned int> nu, nv, common;
+    neighbors(u, nu);
+    neighbors(v, nv);
+    std::set_intersection(nu.begin(), nu.end(), nv.begin(), nv.end(), std::back_inserter(common));
+    if(common.size() != shared)
+    {
+        return false;
+    }
+
+    // reject flipping faces
+    for(unsigned int w : {u, v})
+    {
+        for(unsigned int f : m_vertex_faces[w])
+        {
+            if(!m_faces_alive[f] || (contains(f, u) && contains(f, v)))
+            {
+                continue;
+            }
+
+            const Face& face = m_faces[f];
+            Vector p[3] = {m_vertices[face.v0], m_vertices[face.v1], m_vertices[face.v2]};
+            const Vector n_old = (p[1] - p[0]).cross(p[2] - p[0]);
+
+            if(face.v0 == w) p[0] = c.p;
+            if(face.v1 == w) p[1] = c.p;
+            if(face.v2 == w) p[2] = c.p;
+            const Vector n_new = (p[1] - p[0]).cross(p[2] - p[0]);
+
+            if(n_new.dot(n_old) <= 0.0)
+            {
+                return false;
+            }
+        }
+    }
+
+    for(unsigned int f : m_vertex_faces[v])
+    {
+        if(!m_faces_alive[f])
+        {
+            continue;
+        }
+
+        if(contains(f, u))
+        {
+            m_faces_alive[f] = 0;
+            continue;
+        }
+
+        Face& face = m_faces[f];
+        if(face.v0 == v) face.v0 = u;
+        if(face.v1 == v) face.v1 = u;
+        if(face.v2 == v) face.v2 = u;
+        m_vertex_faces[u].push_back(f);
+    }
+    m_vertex_faces[v].clear();
+
+    std::vector<unsigned int>& faces_u = m_vertex_faces[u];
+    faces_u.erase(std::remove_if(faces_u.begin(), faces_u.end(), 
+        [this](unsigned int f) { return !m_faces_alive[f]; }), faces_u.end());
+
+    m_vertices[u] = c.p;
+    m_quadrics[u] += m_quadrics[v];
+    m_vertices_alive[v] = 0;
+    m_versions[u]++;
+    m_versions[v]++;
+
+    // all collapses of u have changed
+    neighbors(u, nu);
+    for(unsigned int w : nu)
+    {
+        m_heap.push_back(candidate(u, w));
+        std::push_heap(m_heap.begin(), m_heap.end(), std::greater<Collapse>());
+    }
+
+    return true;
+}
+
+double Simplifier::run(double max_error)
+{
+    const double max_cost = max_error * max_error;
+    double cost = 0.0;
+
+    while(!m_heap.empty())
+    {
+        std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<Collapse>());
+        const Collapse c = m_heap.back();
+        m_heap.pop_back();
+
+        if(!m_vertices_alive[c.v0] || !m_vertices_alive[c.v1]
+            || m_versions[c.v0] != c.version0 || m_versions[c.v1] != c.version1)
+        {
+            // outdated
+            continue;
+        }
+
+        if(c.cost > max_cost)
+        {
+            break;
+        }
+
+        if(collapse(c))
+        {
+            cost = std::max(cost, c.cost);
+        }
+    }
+
+    return std::sqrt(cost);
+}
+
+void Simplifier::result(std::vector<Vertex>& vertices, std::vector<Face>& faces) const
+{
+    std::vector<unsigned int> ids(m_vertices.size(), std::numeric_limits<unsigned int>::max());
+
+    vertices.clear();
+    faces.clear();
+    for(size_t i=0; i<m_faces.size(); i++)
+    {
+        if(!m_faces_alive[i])
+        {
+            continue;
+        }
+
+        Face face = m_faces[i];
+        for(unsigned int* v : {&face.v0, &face.v1, &face.v2})
+        {
+            if(ids[*v] == std::numeric_limits<unsigned int>::max())
+            {
+                ids[*v] = vertices.size();
+                vertices.push_back(m_vertices[*v]);
+            }
+            *v = ids[*v];
+        }
+        faces.push_back(face);
+    }
+}
+
+// the meshes EmbreeLodMap selects levels for: top-level meshes 
+// and meshes of scenes instanced at top level
+void collect_meshes(
+    EmbreeScenePtr scene, 
+    std::unordered_set<EmbreeMeshPtr>& meshes,
+    bool top_level = true)
+{
+    for(const auto& elem : scene->geometries())
+    {
+        if(EmbreeMeshPtr mesh = std::dynamic_pointer_cast<EmbreeMesh>(elem.second))
+        {
+            meshes.insert(mesh);
+        } else if(EmbreeInstancePtr inst = std::dynamic_pointer_cast<EmbreeInstance>(elem.second)) {
+            if(top_level)
+            {
+                collect_meshes(inst->scene(), meshes, false);
+            }
+        }
+    }
+}
+
+void check_max_errors(const std::vector<float>& max_errors)
+{
+    for(size_t i=0; i<max_errors.size(); i++)
+    {
+        if(!(max_errors[i] > 0.0) || (i > 0 && !(max_errors[i] > max_errors[i-1])))
+        {
+            RM_THROW(EmbreeException, "make_embree_lods: max_errors must be positive and strictly ascending");
+        }
+    }
+}
+
+// drop levels that do not simplify further
+void set_lods(EmbreeMeshPtr mesh, const std::vector<EmbreeMeshLod>& lods)
+{
+    size_t num_faces = std::as_const(*mesh).faces().size();
+
+    mesh->lods.clear();
+    for(const EmbreeMeshLod& lod : lods)
+    {
+        const size_t num_faces_lod = std::as_const(*lod.mesh).faces().size();
+        if(num_faces_lod < num_faces)
+        {
+            mesh->lods.push_back(lod);
+            num_faces = num_faces_lod;
+        }
+    }
+}
+
+} // namespace
+
+EmbreeMeshPtr simplify_mesh(
+    EmbreeMeshConstPtr mesh, 
+    float max_error,
+    float* error)
+{
+    // errors are given in map coordinates, the vertices are scaled afterwards
+    const Vector3 S = mesh->scale();
+    const float scale = std::max({std::fabs(S.x), std::fabs(S.y), std::fabs(S.z)});
+    if(scale <= 0.0)
+    {
+        RM_THROW(EmbreeException, "simplify_mesh: mesh has zero scale");
+    }
+
+    Simplifier simplifier(mesh->vertices(), mesh->faces());
+    const double error_local = simplifier.run(max_error / scale);
+
+    std::vector<Vertex> vertices;
+    std::vector<Face> faces;
+    simplifier.result(vertices, faces);
+
+    EmbreeMeshPtr ret = std::make_shared<EmbreeMesh>(
+        vertices.size(), faces.size(), mesh->device());
+    ret->name = mesh->name;
+    std::copy(vertices.begin(), vertices.end(), ret->vertices().raw());
+    std::copy(faces.begin(), faces.end(), ret->faces().raw());
+    ret->computeFaceNormals();
+    ret->setTransform(mesh->transform());
+    ret->setScale(S);
+    ret->apply();
+
+    if(error)
+    {
+        *error = error_local * scale;
+    }
+
+    return ret;
+}
+
+void make_embree_lods(
+    EmbreeMeshPtr mesh,
+    const std::vector<float>& max_errors)
+{
+    check_max_errors(max_errors);
+
+    std::vector<EmbreeMeshLod> lods(max_errors.size());
+
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t i=0; i<max_errors.size(); i++)
+    {
+        lods[i].mesh = simplify_mesh(mesh, max_errors[i], &lods[i].error);
+    }
+
+    set_lods(mesh, lods);
+}
+
+void make_embree_lods(
+    EmbreeScenePtr scene,
+    const std::vector<float>& max_errors)
+{
+    check_max_errors(max_errors);
+
+    std::unordered_set<EmbreeMeshPtr> mesh_set;
+    collect_meshes(scene, mesh_set);
+    const std::vector<EmbreeMeshPtr> meshes(mesh_set.begin(), mesh_set.end());
+
+    const size_t num_levels = max_errors.size();
+    std::vector<EmbreeMeshLod> lods(meshes.size() * num_levels);
+
+    // all levels of all meshes at once: single large meshes do not serialize the others
+    #pragma omp parallel for schedule(dynamic)
+    for(size_t i=0; i<lods.size(); i++)
+    {
+        const size_t mesh_id = i / num_levels;
+        const size_t level = i % num_levels;
+        lods[i].mesh = simplify_mesh(meshes[mesh_id], max_errors[level], &lods[i].error);
+    }
+
+    for(size_t i=0; i<meshes.size(); i++)
+    {
+        set_lods(meshes[i], std::vector<EmbreeMeshLod>(
+            lods.begin() + i * num_levels, 
+            lods.begin() + (i + 1) * num_levels));
+    }
+}
+
+} // namespace rmagine
@@ -0,0 +1,183 @@
+#include "rmagine/map/embree_distance_field.h"
+#include "rmagine/map/embree/EmbreeMesh.hpp"
+
+#include <unordered_set>
+#include <cmath>
+#include <limits>
+
+namespace rmagine
+{
+
+namespace 
+{
+
+/**
+ * @brief keys of all blocks that may be within 'band' to a triangle of a mesh
+ */
+void collect_blocks(
+    const EmbreeScenePtr& scene,
+    float voxel_size,
+    float band,
+    std::vector<uint64_t>& keys)
+{
+    const float block_extent = voxel_size * DistanceField::BLOCK_SIZE;
+
+    for(const auto& elem : scene->geometries())
+    {
+        EmbreeMeshConstPtr mesh = std::dynamic_pointer_cast<const EmbreeMesh>(elem.second);
+        if(!mesh)
+        {
+            continue;
+        }
+
+        const MemoryView<const Face, RAM> faces = mesh->faces();
+        const MemoryView<const Vertex, RAM> vertices = mesh->verticesTransformed();
+
+        #pragma omp parallel
+        {
+            std::unordered_set<uint64_t> keys_local;
+
+            #pragma omp for nowait
+            for(size_t i=0; i<faces.size(); i++)
+            {
+                const Vertex a = vertices[faces[i].v0];
+                const Vertex b = vertices[faces[i].v1];
+                const Vertex c = vertices[faces[i].v2];
+
+                const Vector bmin = min(min(a, b), c) - Vector{band, band, band};
+                const Vector bmax = max(max(a, b), c) + Vector{band, band, band};
+
+                // block range. A block covers [B * extent, (B+1) * extent)
+                const int32_t bx0 = static_cast<int32_t>(std::floor(bmin.x / block_extent));
+                const int32_t by0 = static_cast<int32_t>(std::floor(bmin.y / block_extent));
+                const int32_t bz0 = static_cast<int32_t>(std::floor(bmin.z / block_extent));
+                const int32_t bx1 = static_cast<int32_t>(std::floor(bmax.x / block_extent));
+                const int32_t by1 = static_cast<int32_t>(std::floor(bmax.y / block_extent));
+                const int32_t bz1 = static_cast<int32_t>(std::floor(bmax.z / block_extent));
+
+                for(int32_t bz = bz0; bz <= bz1; bz++)
+                {
+                    for(int32_t by = by0; by <= by1; by++)
+                    {
+                        for(int32_t bx = bx0; bx <= bx1; bx++)
+                        {
+                            keys_local.insert(DistanceField::blockKeyOfCell(
+                                bx * DistanceField::BLOCK_SIZE, 
+                                by * DistanceField::BLOCK_SIZE, 
+                                bz * DistanceField::BLOCK_SIZE));
+                        }
+                    }
+                }
+            }
+
+            #pragma omp critical
+            keys.insert(keys.end(), keys_local.begin(), keys_local.end());
+        }
+    }
+}
+
+/**
+ * @brief number of surface crossings of a ray from p is odd -> inside
+ */
+bool inside_by_parity(RTCScene scene, const Point& p)
+{
+    // skewed direction: unlikely to graze edges of axis aligned geometry
+    const Vector dir = Vector{0.5773f, 0.5774f, 0.5775f}.normalize();
+
+    unsigned int crossings = 0;
+    float tnear = 0.0;
+
+    for(unsigned int i=0; i<1024; i++)
+    {
+        RTCRayHit rayhit;
+        rayhit.ray.org_x = p.x;
+        rayhit.ray.org_y = p.y;
+        rayhit.ray.org_z = p.z;
+        rayhit.ray.dir_x = dir.x;
+        rayhit.ray.dir_y = dir.y;
+        rayhit.ray.dir_z = dir.z;
+        rayhit.ray.tnear = tnear;
+        rayhit.ray.tfar = std::numeric_limits<float>::infinity();
+        rayhit.ray.mask = -1;
+        rayhit.ray.flags = 0;
+        rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+        rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
+
+        rtcIntersect1(scene, &rayhit);
+
+        if(rayhit.hit.geomID == RTC_INVALID_GEOMETRY_ID)
+        {
+            break;
+        }
+
+        crossings++;
+        // continue behind the hit
+        tnear = std::nextafter(rayhit.ray.tfar, std::numeric_limits<float>::infinity()) + 1e-5f;
+    }
+
+    return (crossings % 2) == 1;
+}
+
+} // anonymous namespace
+
+DistanceField make_distance_field(
+    EmbreeMapPtr map,
+    const DistanceFieldSettings& settings)
+{
+    DistanceField df(settings.voxel_size, settings.band, settings.signed_distance);
+
+    std::vector<uint64_t> keys;
+    collect_blocks(map->scene, settings.voxel_size, settings.band, keys);
+    df.setBlocks(keys);
+
+    RTCScene scene_handle = map->scene->handle();
+    const float voxel_size = settings.voxel_size;
+    const float band = settings.band;
+    constexpr int32_t S = DistanceField::BLOCK_SAMPLES;
+
+    #pragma omp parallel
+    {
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+
+        #pragma omp for schedule(dynamic)
+        for(size_t block_id = 0; block_id < df.numBlocks(); block_id++)
+        {
+            const Point origin = df.blockOrigin(block_id);
+            float* samples = df.blockSamples(block_id);
+
+            for(int32_t k=0; k<S; k++)
+            {
+                for(int32_t j=0; j<S; j++)
+                {
+                    for(int32_t i=0; i<S; i++)
+                    {
+                        const Point p = origin + Vector{
+                            static_cast<float>(i), 
+                            static_cast<float>(j), 
+                            static_cast<float>(k)} * voxel_size;
+
+                        const ClosestPointResult cp = map->closestPoint(p, context, band);
+
+                        float d = band;
+                        if(cp.geomID != RTC_INVALID_GEOMETRY_ID)
+                        {
+                            d = std::min(cp.d, band);
+                        }
+
+                        if(settings.signed_distance && inside_by_parity(scene_handle, p))
+                        {
+                            d = -d;
+                        }
+
+                        samples[i + S * (j + S * k)] = d;
+                    }
+                }
+            }
+        }
+    }
+
+    return df;
+}
+
+} // namespace rmagine
@@ -25,6 +25,14 @@ O1DnSimulatorEmbree::~O1DnSimulatorEmbree()
 void O1DnSimulatorEmbree::setMap(EmbreeMapPtr map)
 {
     m_map = map;
+    m_map_versions.reset();
+}
+
+void O1DnSimulatorEmbree::setMap(
+    VersionedEmbreeMapPtr map)
+{
+    m_map.reset();
+    m_map_versions = map;
 }
 
 void O1DnSimulatorEmbree::setTsb(const MemoryView<Transform, RAM>& Tsb)
@@ -62,6 +70,8 @@ void O1DnSimulatorEmbree::simulateRanges(
     const MemoryView<Transform, RAM>& Tbm,
     MemoryView<float, RAM>& ranges) const
 {
+    const EmbreeMapPtr map = current_map(m_map, m_map_versions);
+
     #pragma omp parallel for
     for(size_t pid = 0; pid < Tbm.size(); pid++)
     {
@@ -99,7 +109,7 @@ void O1DnSimulatorEmbree::simulateRanges(
                 rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
                 rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
 
-                rtcIntersect1(m_map->scene->handle(), &rayhit);
+                rtcIntersect1(map->scene->handle(), &rayhit);
                 
                 if(rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID)
                 {
@@ -124,6 +134,8 @@ void O1DnSimulatorEmbree::simulateHits(
     const MemoryView<Transform, RAM>& Tbm, 
     MemoryView<uint8_t, RAM>& hits) const
 {
+    const EmbreeMapPtr map = current_map(m_map, m_map_versions);
+
     #pragma omp parallel for
     for(size_t pid = 0; pid < Tbm.size(); pid++)
     {
@@ -159,7 +171,7 @@ void O1DnSimulatorEmbree::simulateHits(
                 rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
                 rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
 
-                rtcIntersect1(m_map->scene->handle(), &rayhit);
+                rtcIntersect1(map->scene->handle(), &rayhit);
                 
                 if(rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID)
                 {
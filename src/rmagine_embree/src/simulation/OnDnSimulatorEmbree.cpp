@@ -25,6 +25,14 @@ OnDnSimulatorEmbree::~OnDnSimulatorEmbree()
 void OnDnSimulatorEmbree::setMap(EmbreeMapPtr map)
 {
     m_map = map;
+    m_map_versions.reset();
+}
+
+void OnDnSimulatorEmbree::setMap(
+    VersionedEmbreeMapPtr map)
+{
+    m_map.reset();
+    m_map_versions = map;
 }
 
 void OnDnSimulatorEmbree::setTsb(
@@ -66,6 +74,8 @@ void OnDnSimulatorEmbree::simulateRanges(
     const MemoryView<Transform, RAM>& Tbm,
     MemoryView<float, RAM>& ranges) const
 {
+    const EmbreeMapPtr map = current_map(m_map, m_map_versions);
+
     #pragma omp parallel for
     for(size_t pid = 0; pid < Tbm.size(); pid++)
     {
@@ -103,7 +113,7 @@ void OnDnSimulatorEmbree::simulateRanges(
                 rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
                 rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
 
-                rtcIntersect1(m_map->scene->handle(), &rayhit);
+                rtcIntersect1(map->scene->handle(), &rayhit);
                 
                 if(rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID)
                 {
@@ -128,6 +138,8 @@ void OnDnSimulatorEmbree::simulateHits(
     const MemoryView<Transform, RAM>& Tbm, 
     MemoryView<uint8_t, RAM>& hits) const
 {
+    const EmbreeMapPtr map = current_map(m_map, m_map_versions);
+
     #pragma omp parallel for
     for(size_t pid = 0; pid < Tbm.size(); pid++)
     {
@@ -163,7 +175,7 @@ void OnDnSimulatorEmbree::simulateHits(
                 rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
                 rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
 
-                rtcIntersect1(m_map->scene->handle(), &rayhit);
+                rtcIntersect1(map->scene->handle(), &rayhit);
                 
                 if(rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID)
                 {
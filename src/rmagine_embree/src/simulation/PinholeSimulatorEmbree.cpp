@@ -25,6 +25,14 @@ PinholeSimulatorEmbree::~PinholeSimulatorEmbree()
 void PinholeSimulatorEmbree::setMap(EmbreeMapPtr map)
 {
     m_map = map;
+    m_map_versions.reset();
+}
+
+void PinholeSimulatorEmbree::setMap(
+    VersionedEmbreeMapPtr map)
+{
+    m_map.reset();
+    m_map_versions = map;
 }
 
 void PinholeSimulatorEmbree::setTsb(const MemoryView<Transform, RAM>& Tsb)
@@ -53,6 +61,8 @@ void PinholeSimulatorEmbree::simulateRanges(
     const MemoryView<Transform, RAM>& Tbm,
     MemoryView<float, RAM>& ranges) const
 {
+    const EmbreeMapPtr map = current_map(m_map, m_map_versions);
+
     #pragma omp parallel for
     for(size_t pid = 0; pid < Tbm.size(); pid++)
     {
@@ -85,7 +95,7 @@ void PinholeSimulatorEmbree::simulateRanges(
                 rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
                 rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
 
-                rtcIntersect1(m_map->scene->handle(), &rayhit);
+                rtcIntersect1(map->scene->handle(), &rayhit);
                 
                 if(rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID)
                 {
@@ -110,6 +120,8 @@ void PinholeSimulatorEmbree::simulateHits(
     const MemoryView<Transform, RAM>& Tbm, 
     MemoryView<uint8_t, RAM>& hits) const
 {
+    const EmbreeMapPtr map = current_map(m_map, m_map_versions);
+
     #pragma omp parallel for
     for(size_t pid = 0; pid < Tbm.size(); pid++)
     {
@@ -142,7 +154,7 @@ void PinholeSimulatorEmbree::simulateHits(
                 rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
                 rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
 
-                rtcIntersect1(m_map->scene->handle(), &rayhit);
+                rtcIntersect1(map->scene->handle(), &rayhit);
                 
                 if(rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID)
                 {
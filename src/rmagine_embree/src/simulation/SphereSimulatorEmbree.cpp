@@ -28,6 +28,14 @@ void SphereSimulatorEmbree::setMap(
     EmbreeMapPtr map)
 {
     m_map = map;
+    m_map_versions.reset();
+}
+
+void SphereSimulatorEmbree::setMap(
+    VersionedEmbreeMapPtr map)
+{
+    m_map.reset();
+    m_map_versions = map;
 }
 
 void SphereSimulatorEmbree::setTsb(
@@ -60,7 +68,7 @@ void SphereSimulatorEmbree::simulateRanges(
     const MemoryView<Transform, RAM>& Tbm,
     MemoryView<float, RAM>& ranges) const
 {
-    auto handle = m_map->scene->handle();
+    const EmbreeMapPtr map = current_map(m_map, m_map_versions);
 
     #pragma omp parallel for
     for(size_t pid = 0; pid < Tbm.size(); pid++)
@@ -94,7 +102,7 @@ void SphereSimulatorEmbree::simulateRanges(
                 rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
                 rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
 
-                rtcIntersect1(m_map->scene->handle(), &rayhit);
+                rtcIntersect1(map->scene->handle(), &rayhit);
                 
                 if(rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID)
                 {
@@ -119,6 +127,8 @@ void SphereSimulatorEmbree::simulateHits(
     const MemoryView<Transform, RAM>& Tbm, 
     MemoryView<uint8_t, RAM>& hits) const
 {
+    const EmbreeMapPtr map = current_map(m_map, m_map_versions);
+
     #pragma omp parallel for
     for(size_t pid = 0; pid < Tbm.size(); pid++)
     {
@@ -151,7 +161,7 @@ void SphereSimulatorEmbree::simulateHits(
                 rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
                 rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
 
-                rtcIntersect1(m_map->scene->handle(), &rayhit);
+                rtcIntersect1(map->scene->handle(), &rayhit);
                 
                 if(rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID)
                 {
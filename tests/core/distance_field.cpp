@@ -0,0 +1,160 @@
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <rmagine/map/DistanceField.hpp>
+#include <rmagine/util/exceptions.h>
+#include <rmagine/util/prints.h>
+
+using namespace rmagine;
+
+// signed distance to the plane n * x = 0.3
+float plane_sdf(const Point& p)
+{
+    const Vector n = Vector{1.0f, 2.0f, -0.5f}.normalize();
+    return n.dot(p) - 0.3f;
+}
+
+DistanceField make_plane_field()
+{
+    DistanceField df(0.05, 10.0, true);
+
+    // blocks around the origin, including negative coordinates
+    std::vector<uint64_t> keys;
+    for(int32_t k=-2; k<2; k++)
+    {
+        for(int32_t j=-2; j<2; j++)
+        {
+            for(int32_t i=-2; i<2; i++)
+            {
+                keys.push_back(DistanceField::blockKeyOfCell(
+                    i * DistanceField::BLOCK_SIZE, 
+                    j * DistanceField::BLOCK_SIZE, 
+                    k * DistanceField::BLOCK_SIZE));
+            }
+        }
+    }
+    // duplicates are removed
+    keys.push_back(keys.front());
+    df.setBlocks(keys);
+
+    const int32_t S = DistanceField::BLOCK_SAMPLES;
+    for(size_t b=0; b<df.numBlocks(); b++)
+    {
+        const Point origin = df.blockOrigin(b);
+        float* samples = df.blockSamples(b);
+        for(int32_t k=0; k<S; k++)
+        {
+            for(int32_t j=0; j<S; j++)
+            {
+                for(int32_t i=0; i<S; i++)
+                {
+                    const Point p = origin + Vector{
+                        static_cast<float>(i), 
+                        static_cast<float>(j), 
+                        static_cast<float>(k)} * df.voxelSize();
+                    samples[i + S * (j + S * k)] = plane_sdf(p);
+                }
+            }
+        }
+    }
+
+    return df;
+}
+
+void test_lookup(const DistanceField& df)
+{
+    if(df.numBlocks() != 64)
+    {
+        RM_THROW(Exception, "wrong number of blocks");
+    }
+
+    const Vector n = Vector{1.0f, 2.0f, -0.5f}.normalize();
+
+    // trilinear interpolation of a linear function is exact
+    Memory<Point, RAM> ps(1000);
+    for(size_t i=0; i<ps.size(); i++)
+    {
+        ps[i] = {
+            0.79f * std::sin(0.37f * i), 
+            0.79f * std::cos(0.91f * i), 
+            0.79f * std::sin(1.3f * i + 0.2f)};
+    }
+
+    Memory<float, RAM> ds(ps.size());
+    Memory<Vector, RAM> grads(ps.size());
+    df.distances(ps, ds, grads);
+
+    for(size_t i=0; i<ps.size(); i++)
+    {
+        if(std::fabs(ds[i] - plane_sdf(ps[i])) > 1e-4)
+        {
+            std::cout << ps[i] << ": " << ds[i] << " != " << plane_sdf(ps[i]) << std::endl;
+            RM_THROW(Exception, "distance lookup wrong");
+        }
+        if((grads[i] - n).l2norm() > 1e-3)
+        {
+            RM_THROW(Exception, "distance gradient wrong");
+        }
+    }
+
+    // outside of the blocks
+    float d;
+    if(df.distance(Point{5.0f, 0.0f, 0.0f}, d))
+    {
+        RM_THROW(Exception, "distance outside of the field");
+    }
+    Memory<Point, RAM> p_out(1);
+    p_out[0] = {-5.0f, 0.0f, 0.0f};
+    if(!std::isnan(df.distances(p_out)[0]))
+    {
+        RM_THROW(Exception, "batched distance outside of the field is not NaN");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::cout << "1. DistanceField lookup" << std::endl;
+    DistanceField df = make_plane_field();
+    test_lookup(df);
+
+    std::cout << "2. DistanceField IO" << std::endl;
+    const std::string filename = "rmagine_test_distance_field.bin";
+    df.save(filename);
+    DistanceField df2 = DistanceField::load(filename);
+    std::remove(filename.c_str());
+
+    if(df2.voxelSize() != df.voxelSize() || df2.band() != df.band() || df2.isSigned() != df.isSigned())
+    {
+        RM_THROW(Exception, "loaded settings differ");
+    }
+    test_lookup(df2);
+
+    std::cout << "3. DistanceField truncated file" << std::endl;
+    df.save(filename);
+    {
+        // keep the header, cut the blocks
+        std::ifstream in(filename, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+        std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), bytes.size() / 2);
+    }
+
+    bool truncated_detected = false;
+    try {
+        DistanceField df3 = DistanceField::load(filename);
+    } catch(const Exception& e) {
+        truncated_detected = true;
+    }
+    std::remove(filename.c_str());
+
+    if(!truncated_detected)
+    {
+        RM_THROW(Exception, "loading a truncated file did not throw");
+    }
+
+    return 0;
+}
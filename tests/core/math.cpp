@@ -4,6 +4,16 @@
 #include "rmagine/math/types.h"
 
 #include <rmagine/math/math.h>
+#include <rmagine/math/math_batched.h>
+#include <rmagine/math/SVD.hpp>
+#include <rmagine/math/simd.h>
+#include <rmagine/math/expr.h>
+#include <rmagine/math/registration.h>
+#include <rmagine/math/lie.h>
+#include <rmagine/math/resampling.h>
+#include <rmagine/math/closest_point.h>
+#include <rmagine/types/sensors.h>
+#include <rmagine/types/ray_table.h>
 
 
 #include <rmagine/util/StopWatch.hpp>
@@ -17,6 +27,7 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <vector>
 
 
 using namespace rmagine;
@@ -513,6 +524,894 @@ void math_new()
     std::cout << R << std::endl;
 }
 
+void reductions_test()
+{
+    // large offset: naive float accumulation drifts
+    const size_t N = 3000000;
+    Memory<Vector, RAM> X(N);
+    for(size_t i=0; i<N; i++)
+    {
+        const float noise = static_cast<float>(i % 7) - 3.0;
+        X[i] = {1000.0f + noise, -500.0f - noise, 0.1f * noise};
+    }
+
+    Vector m = mean(X)[0];
+    if((m - Vector{1000.0, -500.0, 0.0}).l2norm() > 0.001)
+    {
+        std::cout << m << std::endl;
+        RM_THROW(Exception, "Mean of large point cloud is inaccurate.");
+    }
+
+    Memory<Vector, RAM> Xc(N);
+    for(size_t i=0; i<N; i++)
+    {
+        Xc[i] = X[i] - m;
+    }
+
+    Matrix3x3 C = cov(Xc, Xc)[0];
+    // variance of noise (-3..3) = 4
+    if(fabs(C(0,0) - 4.0) > 0.01 || fabs(C(1,0) + 4.0) > 0.01 || fabs(C(2,2) - 0.04) > 0.001)
+    {
+        std::cout << C << std::endl;
+        RM_THROW(Exception, "Covariance of large point cloud is inaccurate.");
+    }
+}
+
+void batched_test()
+{
+    // small and large batches take different code paths
+    for(size_t batchSize : {100, 10000})
+    {
+        const size_t Nbatches = 7;
+        Memory<Vector, RAM> X(Nbatches * batchSize);
+        Memory<uint8_t, RAM> hits(X.size());
+        for(size_t i=0; i<X.size(); i++)
+        {
+            const float b = static_cast<float>(i / batchSize);
+            X[i] = {b, 2.0f * b, static_cast<float>(i % 2)};
+            hits[i] = (i % 2 == 0);
+        }
+
+        Memory<Vector, RAM> means = meanBatched(X, batchSize);
+        Memory<Vector, RAM> means_masked = meanBatched(X, hits, batchSize);
+        Memory<unsigned int, RAM> counts = countBatched(hits, batchSize);
+        Memory<Matrix3x3, RAM> covs = covBatched(X, X, batchSize);
+
+        for(size_t b=0; b<Nbatches; b++)
+        {
+            // reference
+            Vector m = mean(X(b * batchSize, (b + 1) * batchSize))[0];
+            if((means[b] - m).l2norm() > 0.0001 || fabs(means[b].z - 0.5) > 0.0001)
+            {
+                RM_THROW(Exception, "meanBatched differs from mean.");
+            }
+
+            if(fabs(means_masked[b].z) > 0.0001 || counts[b] != batchSize / 2)
+            {
+                RM_THROW(Exception, "Masked meanBatched is wrong.");
+            }
+
+            Matrix3x3 C = cov(X(b * batchSize, (b + 1) * batchSize), X(b * batchSize, (b + 1) * batchSize))[0];
+            for(size_t i=0; i<3; i++)
+            {
+                for(size_t j=0; j<3; j++)
+                {
+                    if(fabs(covs[b](i,j) - C(i,j)) > 0.001)
+                    {
+                        RM_THROW(Exception, "covBatched differs from cov.");
+                    }
+                }
+            }
+        }
+
+        // misses are NaN: masked out, they must not poison their batch
+        Memory<bool, RAM> corr(X.size());
+        Memory<unsigned int, RAM> ncorr(Nbatches);
+        for(size_t i=0; i<X.size(); i++)
+        {
+            if(!hits[i])
+            {
+                X[i] = Vector::NaN();
+            }
+            // last batch without correspondences
+            corr[i] = hits[i] && (i / batchSize < Nbatches - 1);
+        }
+        for(size_t b=0; b<Nbatches; b++)
+        {
+            ncorr[b] = (b < Nbatches - 1) ? batchSize / 2 : 0;
+        }
+
+        Memory<Vector, RAM> sums_nan = sumBatched(X, hits, batchSize);
+        Memory<Vector, RAM> means_nan = meanBatched(X, hits, batchSize);
+        Memory<Matrix3x3, RAM> covs_nan = covBatched(X, X, hits, batchSize);
+        Memory<Matrix3x3, RAM> covs_corr = covBatched(X, X, corr, ncorr, batchSize);
+        for(size_t b=0; b<Nbatches; b++)
+        {
+            const float bf = static_cast<float>(b);
+            const Vector m_expected = {bf, 2.0f * bf, 0.0f};
+            const float mv[3] = {m_expected.x, m_expected.y, m_expected.z};
+            if((means_nan[b] - m_expected).l2norm() > 0.0001
+                || (sums_nan[b] - m_expected * static_cast<float>(batchSize / 2)).l2norm() > 0.01 * batchSize)
+            {
+                std::cout << "batch " << b << ": " << sums_nan[b] << ", " << means_nan[b] << std::endl;
+                RM_THROW(Exception, "Masked sum/mean with NaN misses is wrong.");
+            }
+
+            for(size_t i=0; i<3; i++)
+            {
+                for(size_t j=0; j<3; j++)
+                {
+                    const float c_expected = mv[i] * mv[j];
+                    const float c_corr_expected = (b < Nbatches - 1) ? c_expected : 0.0f;
+                    if(!(fabs(covs_nan[b](i,j) - c_expected) <= 0.001 * (1.0 + c_expected))
+                        || !(fabs(covs_corr[b](i,j) - c_corr_expected) <= 0.001 * (1.0 + c_expected)))
+                    {
+                        std::cout << "batch " << b << ": " << covs_nan[b] << covs_corr[b] << std::endl;
+                        RM_THROW(Exception, "Masked covBatched with NaN misses is wrong.");
+                    }
+                }
+            }
+        }
+    }
+}
+
+void svd_test()
+{
+    SVD svd;
+
+    const size_t N = 1000;
+    Memory<Matrix3x3, RAM> As(N);
+    srand(42);
+    for(size_t i=0; i<N; i++)
+    {
+        for(size_t j=0; j<3; j++)
+        {
+            for(size_t k=0; k<3; k++)
+            {
+                As[i](j,k) = static_cast<float>(rand()) / RAND_MAX * 2.0 - 1.0;
+            }
+        }
+    }
+
+    Memory<Matrix3x3, RAM> Us(N), Vs(N);
+    Memory<Vector, RAM> Ss(N);
+    svd.calcUSV(As, Us, Ss, Vs);
+
+    for(size_t i=0; i<N; i++)
+    {
+        Eigen::Matrix3f Ae;
+        for(size_t j=0; j<3; j++)
+        {
+            for(size_t k=0; k<3; k++)
+            {
+                Ae(j,k) = As[i](j,k);
+            }
+        }
+        Eigen::JacobiSVD<Eigen::Matrix3f> esvd(Ae);
+        const Eigen::Vector3f Se = esvd.singularValues();
+
+        if(fabs(Ss[i].x - Se(0)) > 0.0001 
+            || fabs(Ss[i].y - Se(1)) > 0.0001 
+            || fabs(Ss[i].z - Se(2)) > 0.0001)
+        {
+            std::cout << Ss[i] << " vs " << Se.transpose() << std::endl;
+            RM_THROW(Exception, "SVD: singular values differ from Eigen.");
+        }
+
+        Matrix3x3 S = Matrix3x3::Zeros();
+        S(0,0) = Ss[i].x;
+        S(1,1) = Ss[i].y;
+        S(2,2) = Ss[i].z;
+        const Matrix3x3 R = Us[i] * S * Vs[i].T() - As[i];
+        for(size_t j=0; j<3; j++)
+        {
+            for(size_t k=0; k<3; k++)
+            {
+                if(fabs(R(j,k)) > 0.0001)
+                {
+                    RM_THROW(Exception, "SVD: U * S * V^T does not reconstruct A.");
+                }
+            }
+        }
+    }
+
+    // degenerate inputs: diagonal blocks and repeated singular values
+    Memory<Matrix3x3, RAM> Ads(4);
+    Ads[0].setIdentity();
+    Ads[1].setZeros();
+    Ads[2].setZeros();
+    Ads[2](0,0) = 2.0; Ads[2](1,1) = 2.0; Ads[2](2,2) = 1.0;
+    Ads[3].setZeros();
+    Ads[3](0,0) = 3.0; Ads[3](1,1) = 1.0; Ads[3](2,2) = 2.0;
+
+    Memory<Matrix3x3, RAM> Uds(Ads.size()), Vds(Ads.size());
+    Memory<Vector, RAM> Sds(Ads.size());
+    svd.calcUSV(Ads, Uds, Sds, Vds);
+
+    for(size_t i=0; i<Ads.size(); i++)
+    {
+        // scalar path must agree with the batched one
+        Matrix3x3 U, V;
+        Vector Sv;
+        svd.calcUSV(Ads[i], U, Sv, V);
+
+        for(const Vector& s : {Sds[i], Sv})
+        {
+            Matrix3x3 S = Matrix3x3::Zeros();
+            S(0,0) = s.x;
+            S(1,1) = s.y;
+            S(2,2) = s.z;
+            for(const Matrix3x3& R : {Uds[i] * S * Vds[i].T() - Ads[i], U * S * V.T() - Ads[i]})
+            {
+                for(size_t j=0; j<3; j++)
+                {
+                    for(size_t k=0; k<3; k++)
+                    {
+                        if(!(fabs(R(j,k)) <= 0.0001))
+                        {
+                            std::cout << Ads[i] << std::endl;
+                            RM_THROW(Exception, "SVD: degenerate input is not reconstructed.");
+                        }
+                    }
+                }
+            }
+        }
+
+        if(!(Sds[i].x >= Sds[i].y && Sds[i].y >= Sds[i].z))
+        {
+            RM_THROW(Exception, "SVD: singular values of degenerate input are not sorted.");
+        }
+
+        const Matrix3x3 R = svd.kabsch(Ads[i]);
+        for(size_t j=0; j<3; j++)
+        {
+            for(size_t k=0; k<3; k++)
+            {
+                if(!std::isfinite(R(j,k)))
+                {
+                    RM_THROW(Exception, "Kabsch: NaN for degenerate input.");
+                }
+            }
+        }
+    }
+
+    // Kabsch of the identity covariance is the identity
+    {
+        const Matrix3x3 R = svd.kabsch(Ads[0]);
+        for(size_t j=0; j<3; j++)
+        {
+            for(size_t k=0; k<3; k++)
+            {
+                if(fabs(R(j,k) - (j == k ? 1.0 : 0.0)) > 0.0001)
+                {
+                    std::cout << R << std::endl;
+                    RM_THROW(Exception, "Kabsch of identity is not the identity.");
+                }
+            }
+        }
+    }
+
+    // Kabsch: recover a known rotation from point correspondences
+    EulerAngles e{0.3, -0.7, 2.1};
+    Matrix3x3 Rgt;
+    Rgt = e;
+
+    Memory<Vector, RAM> from(100), to(100);
+    for(size_t i=0; i<from.size(); i++)
+    {
+        from[i] = {
+            static_cast<float>(rand()) / RAND_MAX - 0.5f,
+            static_cast<float>(rand()) / RAND_MAX - 0.5f,
+            static_cast<float>(rand()) / RAND_MAX - 0.5f};
+        to[i] = Rgt * from[i];
+    }
+
+    const Matrix3x3 C = cov(from, to)[0];
+    const Matrix3x3 R = svd.kabsch(C);
+    for(size_t j=0; j<3; j++)
+    {
+        for(size_t k=0; k<3; k++)
+        {
+            if(fabs(R(j,k) - Rgt(j,k)) > 0.0001)
+            {
+                std::cout << R << std::endl << Rgt << std::endl;
+                RM_THROW(Exception, "Kabsch did not recover the rotation.");
+            }
+        }
+    }
+}
+
+void simd_test()
+{
+    // odd size: full packs and remainder
+    const size_t N = 1037;
+    Memory<Vector, RAM> X(N);
+    Memory<Quaternion, RAM> Q(N);
+    Memory<Matrix3x3, RAM> M(N);
+    Memory<Transform, RAM> T(N);
+    for(size_t i=0; i<N; i++)
+    {
+        const float f = static_cast<float>(i) / static_cast<float>(N);
+        X[i] = {f, 1.0f - f, 2.0f * f};
+        EulerAngles e{f, 0.5f * f, -f};
+        Q[i] = e;
+        M[i] = e;
+        T[i].R = Q[i];
+        T[i].t = X[N - i - 1];
+        T[i].stamp = i;
+    }
+
+    // reversed order: different stamps on both sides
+    Memory<Transform, RAM> T_rev(N);
+    for(size_t i=0; i<N; i++)
+    {
+        T_rev[i] = T[N - i - 1];
+        if((T[i] * T_rev[i]).stamp != T[i].stamp || T_rev[i].inv().stamp != T_rev[i].stamp)
+        {
+            RM_THROW(Exception, "Transform mult or inv passes the wrong stamp.");
+        }
+    }
+
+    const simd::Level best = simd::detect();
+    std::cout << "SIMD level: " << simd::name(best) << std::endl;
+
+    for(int l=0; l<=static_cast<int>(best); l++)
+    {
+        simd::setLevel(static_cast<simd::Level>(l));
+
+        Memory<Vector, RAM> Yq(N), Ym(N), Yt(N), Yt1(N);
+        Memory<Transform, RAM> Tr(N), Tr_rev(N), Tr1(N);
+        simd::mult(Q, X, Yq);
+        simd::mult(M, X, Ym);
+        simd::mult(T, X, Yt);
+        simd::mult(T(0, 1), X, Yt1);
+        simd::mult(T, T, Tr);
+        simd::mult(T, T_rev, Tr_rev);
+        simd::mult(T(0, 1), T_rev, Tr1);
+
+        Memory<float, RAM> xs(N), ys(N), zs(N);
+        for(size_t i=0; i<N; i++)
+        {
+            xs[i] = X[i].x;
+            ys[i] = X[i].y;
+            zs[i] = X[i].z;
+        }
+        VectorSoAView Xsoa{xs.raw(), ys.raw(), zs.raw(), N};
+        simd::mult(T, Xsoa, Xsoa);
+
+        for(size_t i=0; i<N; i++)
+        {
+            const Transform Tgt = T[i] * T[i];
+            if((Yq[i] - Q[i] * X[i]).l2norm() > 0.0001
+                || (Ym[i] - M[i] * X[i]).l2norm() > 0.0001
+                || (Yt[i] - T[i] * X[i]).l2norm() > 0.0001
+                || (Yt1[i] - T[0] * X[i]).l2norm() > 0.0001
+                || (Tr[i].t - Tgt.t).l2norm() > 0.0001
+                || fabs(Tr[i].R.dot(Tgt.R) - 1.0) > 0.0001
+                || Tr[i].stamp != T[i].stamp)
+            {
+                std::cout << simd::name(simd::level()) << ", element " << i << std::endl;
+                RM_THROW(Exception, "SIMD mult differs from operator*.");
+            }
+
+            // stamps: the one of the left transform, as in operator*
+            if(Tr_rev[i].stamp != (T[i] * T_rev[i]).stamp 
+                || Tr_rev[i].stamp != T[i].stamp
+                || Tr1[i].stamp != T[0].stamp)
+            {
+                std::cout << simd::name(simd::level()) << ", element " << i << std::endl;
+                RM_THROW(Exception, "SIMD mult passes the wrong stamp.");
+            }
+
+            const Vector Ysoa{xs[i], ys[i], zs[i]};
+            if((Ysoa - T[i] * X[i]).l2norm() > 0.0001)
+            {
+                RM_THROW(Exception, "SIMD mult on SoA differs from operator*.");
+            }
+        }
+    }
+
+    simd::setLevel(best);
+
+    // multNxN and friends keep the sizes of the per-element loops: 
+    // results for the first elements of a larger output
+    Memory<Vector, RAM> Ylarge(N + 10);
+    Ylarge[N] = {42.0, 42.0, 42.0};
+    multNxN(T, X, Ylarge);
+    Memory<Vector, RAM> Ylarge1(N + 10);
+    multNx1(T, X(0, 1), Ylarge1);
+    Memory<Vector, RAM> Ylarge2(N + 10);
+    mult1xN(T(0, 1), X, Ylarge2);
+    for(size_t i=0; i<N; i++)
+    {
+        if((Ylarge[i] - T[i] * X[i]).l2norm() > 0.0001
+            || (Ylarge1[i] - T[i] * X[0]).l2norm() > 0.0001
+            || (Ylarge2[i] - T[0] * X[i]).l2norm() > 0.0001)
+        {
+            RM_THROW(Exception, "mult with a larger output is wrong.");
+        }
+    }
+    if(Ylarge[N].x != 42.0)
+    {
+        RM_THROW(Exception, "mult wrote behind its results.");
+    }
+
+    // too small outputs are rejected
+    bool too_small_detected = false;
+    try {
+        Memory<Vector, RAM> Ysmall(N - 1);
+        multNxN(T, X, Ysmall);
+    } catch(const Exception& e) {
+        too_small_detected = true;
+    }
+    if(!too_small_detected)
+    {
+        RM_THROW(Exception, "mult into a too small output did not throw.");
+    }
+}
+
+void expr_test()
+{
+    const size_t N = 1000;
+    Memory<Vector, RAM> A(N), B(N);
+    for(size_t i=0; i<N; i++)
+    {
+        A[i] = {static_cast<float>(i), 1.0, 2.0};
+        B[i] = {1.0, static_cast<float>(i), 3.0};
+    }
+
+    Transform T = Transform::Identity();
+    T.t = {1.0, 2.0, 3.0};
+    const Vector b{1.0, 1.0, 1.0};
+
+    // fused: no intermediate buffers
+    Memory<Vector, RAM> Y(N);
+    Y = T * (lazy(A) - b);
+    Memory<Vector, RAM> Z = lazy(A) + lazy(B) * 2.0f;
+    Memory<float, RAM> d = -lazy(A) * B;
+
+    // broadcast of a size 1 view, in-place on a view
+    Memory<Transform, RAM> Ts(1);
+    Ts[0] = T;
+    MemoryView<Vector, RAM> V = B(0, N);
+    V = Ts * lazy(V);
+
+    for(size_t i=0; i<N; i++)
+    {
+        const Vector Bi{1.0, static_cast<float>(i), 3.0};
+        if((Y[i] - T * (A[i] - b)).l2norm() > 0.0001
+            || (Z[i] - (A[i] + Bi * 2.0f)).l2norm() > 0.0001
+            || fabs(d[i] + A[i].dot(Bi)) > 0.001
+            || (B[i] - T * Bi).l2norm() > 0.0001)
+        {
+            RM_THROW(Exception, "Lazy expression differs from elementwise evaluation.");
+        }
+    }
+
+    // the expression reads the memory it is assigned to, which changes its size
+    Memory<Vector, RAM> S(1);
+    S[0] = b;
+    S = lazy(S) + A;
+    if(S.size() != N)
+    {
+        RM_THROW(Exception, "Expression assignment did not resize.");
+    }
+    for(size_t i=0; i<N; i++)
+    {
+        if((S[i] - (A[i] + b)).l2norm() > 0.0001)
+        {
+            RM_THROW(Exception, "Expression assignment read from the resized memory.");
+        }
+    }
+}
+
+void registration_test()
+{
+    // dataset: points on three planes, model: dataset moved by a known transform
+    const size_t Nposes = 50;
+    const size_t batchSize = 3000;
+    Memory<Vector, RAM> dataset(Nposes * batchSize), model(Nposes * batchSize), normals(Nposes * batchSize);
+    Memory<uint8_t, RAM> mask(Nposes * batchSize);
+    Memory<Transform, RAM> Tgt(Nposes);
+
+    srand(7);
+    for(size_t b=0; b<Nposes; b++)
+    {
+        const float f = static_cast<float>(b) / Nposes;
+        EulerAngles e{0.02f * f, -0.03f * f, 0.05f * f};
+        Tgt[b].R = e;
+        Tgt[b].t = {0.1f * f, -0.05f, 0.02f * f};
+
+        for(size_t i=0; i<batchSize; i++)
+        {
+            const size_t id = b * batchSize + i;
+            const float u = static_cast<float>(rand()) / RAND_MAX * 4.0 - 2.0;
+            const float v = static_cast<float>(rand()) / RAND_MAX * 4.0 - 2.0;
+            Vector p, n;
+            if(i % 3 == 0)
+            {
+                p = {u, v, -1.0}; n = {0.0, 0.0, 1.0};
+            } else if(i % 3 == 1) {
+                p = {u, 3.0, v}; n = {0.0, -1.0, 0.0};
+            } else {
+                p = {5.0, u, v}; n = {-1.0, 0.0, 0.0};
+            }
+            dataset[id] = p;
+            model[id] = Tgt[b] * p;
+            normals[id] = Tgt[b].R * n;
+            // invalid correspondences are garbage or NaN, as simulated misses
+            mask[id] = (i % 10 != 0);
+            if(!mask[id])
+            {
+                model[id] = (i % 20 == 0) ? Vector{100.0, 100.0, 100.0} : Vector::NaN();
+                normals[id] = Vector::NaN();
+            }
+        }
+    }
+
+    Memory<Transform, RAM> Tp2p = umeyamaBatched(dataset, model, mask, batchSize);
+
+    // point to plane: linearized, converges in a few steps
+    Memory<Transform, RAM> Tp2l(Nposes);
+    for(size_t b=0; b<Nposes; b++)
+    {
+        Tp2l[b] = Transform::Identity();
+    }
+    Memory<Vector, RAM> dataset_moved(dataset.size());
+    for(size_t iter=0; iter<5; iter++)
+    {
+        for(size_t i=0; i<dataset.size(); i++)
+        {
+            dataset_moved[i] = Tp2l[i / batchSize] * dataset[i];
+        }
+        Memory<Transform, RAM> Tupdate = pointToPlaneBatched(dataset_moved, model, normals, mask, batchSize);
+        for(size_t b=0; b<Nposes; b++)
+        {
+            Tp2l[b] = Tupdate[b] * Tp2l[b];
+        }
+    }
+
+    for(size_t b=0; b<Nposes; b++)
+    {
+        if(!((Tp2p[b].t - Tgt[b].t).l2norm() <= 0.0005)
+            || !(fabs(fabs(Tp2p[b].R.dot(Tgt[b].R)) - 1.0) <= 0.0001))
+        {
+            std::cout << b << ": " << Tp2p[b] << " vs " << Tgt[b] << std::endl;
+            RM_THROW(Exception, "umeyamaBatched did not recover the transform.");
+        }
+
+        if(!((Tp2l[b].t - Tgt[b].t).l2norm() <= 0.0005)
+            || !(fabs(fabs(Tp2l[b].R.dot(Tgt[b].R)) - 1.0) <= 0.0001))
+        {
+            std::cout << b << ": " << Tp2l[b] << " vs " << Tgt[b] << std::endl;
+            RM_THROW(Exception, "pointToPlaneBatched did not converge to the transform.");
+        }
+    }
+
+    // symmetric point set (cube corners): isotropic covariance. 
+    // Batch 0 is already aligned, batch 1 is a pure translation
+    const size_t Ncorners = 8;
+    Memory<Vector, RAM> corners(2 * Ncorners), corners_moved(2 * Ncorners);
+    Memory<uint8_t, RAM> corners_mask(2 * Ncorners);
+    Memory<Transform, RAM> Tcorners(2);
+    Tcorners[0] = Transform::Identity();
+    Tcorners[1] = Transform::Identity();
+    Tcorners[1].t = {0.3, -1.2, 0.5};
+
+    for(size_t b=0; b<2; b++)
+    {
+        for(size_t i=0; i<Ncorners; i++)
+        {
+            const size_t id = b * Ncorners + i;
+            corners[id] = {
+                (i & 1) ? 1.0f : -1.0f,
+                (i & 2) ? 1.0f : -1.0f,
+                (i & 4) ? 1.0f : -1.0f};
+            corners_moved[id] = Tcorners[b] * corners[id];
+            corners_mask[id] = 1;
+        }
+    }
+
+    Memory<Transform, RAM> Tcorners_est = umeyamaBatched(corners, corners_moved, corners_mask, Ncorners);
+    for(size_t b=0; b<2; b++)
+    {
+        if(!((Tcorners_est[b].t - Tcorners[b].t).l2norm() <= 0.0001)
+            || !(fabs(fabs(Tcorners_est[b].R.dot(Tcorners[b].R)) - 1.0) <= 0.0001))
+        {
+            std::cout << b << ": " << Tcorners_est[b] << " vs " << Tcorners[b] << std::endl;
+            RM_THROW(Exception, "umeyamaBatched failed for a symmetric point set.");
+        }
+    }
+}
+
+void lie_test()
+{
+    // tangent vectors incl. zero, tiny and near pi rotations
+    const size_t N = 1000;
+    Memory<Vector6, RAM> xi(N);
+    srand(3);
+    for(size_t i=0; i<N; i++)
+    {
+        Vector w{
+            static_cast<float>(rand()) / RAND_MAX - 0.5f,
+            static_cast<float>(rand()) / RAND_MAX - 0.5f,
+            static_cast<float>(rand()) / RAND_MAX - 0.5f};
+        w.normalizeInplace();
+        const float angle = (i % 4 == 0) ? 1e-5f * i : (i % 4 == 1 ? 3.1f : 2.0f * static_cast<float>(rand()) / RAND_MAX);
+        xi[i].w = (i == 0) ? Vector::Zeros() : w * angle;
+        xi[i].v = {0.3f * i / N, -1.0f, 2.0f * i / N};
+    }
+
+    Memory<Transform, RAM> T = se3Exp(xi);
+    Memory<Vector6, RAM> xi2 = se3Log(T);
+
+    Memory<Transform, RAM> Tr = boxplus(T, xi);
+    Memory<Vector6, RAM> d = boxminus(Tr, T);
+
+    for(size_t i=0; i<N; i++)
+    {
+        if((xi2[i] - xi[i]).l2norm() > 0.001)
+        {
+            std::cout << i << ": " << xi[i].w << " " << xi2[i].w << std::endl;
+            RM_THROW(Exception, "se3Log(se3Exp(xi)) != xi");
+        }
+
+        if((d[i] - xi[i]).l2norm() > 0.001)
+        {
+            RM_THROW(Exception, "boxminus(boxplus(T, xi), T) != xi");
+        }
+
+        // exp(xi) applied to a point: rotation and coupled translation
+        const Transform Ti = T[i];
+        const Vector6 xi_half = xi[i] * 0.5f;
+        const Transform Th = se3Exp(xi_half) * se3Exp(xi_half);
+        if((Th.t - Ti.t).l2norm() > 0.001 || fabs(fabs(Th.R.dot(Ti.R)) - 1.0) > 0.0001)
+        {
+            RM_THROW(Exception, "se3Exp(xi / 2)^2 != se3Exp(xi)");
+        }
+
+        // adjoint
+        const Transform A = se3Exp(xi[N - i - 1]);
+        const Transform L = A * Ti;
+        const Transform R = se3Exp(se3Adjoint(A, xi[i])) * A;
+        if((L.t - R.t).l2norm() > 0.001 || fabs(fabs(L.R.dot(R.R)) - 1.0) > 0.0001)
+        {
+            RM_THROW(Exception, "T * exp(xi) != exp(Ad_T * xi) * T");
+        }
+    }
+}
+
+void resampling_test()
+{
+    const size_t N = 10000;
+    Memory<float, RAM> log_w(N);
+    Memory<Transform, RAM> particles(N);
+    for(size_t i=0; i<N; i++)
+    {
+        // very peaked: naive exp underflows
+        log_w[i] = -1000.0f - 0.01f * static_cast<float>(i);
+        particles[i] = Transform::Identity();
+        particles[i].t.x = static_cast<float>(i);
+    }
+
+    const double lse = logSumExp(log_w);
+    // geometric series: sum_i exp(-0.01 i) = 1 / (1 - exp(-0.01))
+    const double lse_gt = -1000.0 - std::log(1.0 - std::exp(-0.01));
+    if(std::fabs(lse - lse_gt) > 1e-3)
+    {
+        RM_THROW(Exception, "logSumExp wrong");
+    }
+
+    Memory<float, RAM> w(N);
+    normalizeLogWeights(log_w, w);
+    const double ess = effectiveSampleSize(w);
+    // (sum q^i)^2 / sum q^2i = (1 + q) / (1 - q) for q = exp(-0.01)
+    const double q = std::exp(-0.01);
+    if(std::fabs(ess - (1.0 + q) / (1.0 - q)) > 0.1)
+    {
+        RM_THROW(Exception, "effectiveSampleSize wrong");
+    }
+
+    Memory<float, RAM> uniform(N);
+    for(size_t i=0; i<N; i++)
+    {
+        uniform[i] = 3.0f;
+    }
+    if(std::fabs(effectiveSampleSize(uniform) - N) > 1e-3)
+    {
+        RM_THROW(Exception, "effectiveSampleSize of uniform weights != N");
+    }
+    normalizeWeights(uniform);
+
+    // every sample impossible: uniform instead of NaN
+    Memory<float, RAM> log_zero(N);
+    for(size_t i=0; i<N; i++)
+    {
+        log_zero[i] = -std::numeric_limits<float>::infinity();
+    }
+    normalizeLogWeights(log_zero, log_zero);
+    double sum_zero = 0.0;
+    for(size_t i=0; i<N; i++)
+    {
+        if(!(std::fabs(log_zero[i] - 1.0f / N) < 1e-9))
+        {
+            RM_THROW(Exception, "normalizeLogWeights of all -inf is not uniform");
+        }
+        sum_zero += log_zero[i];
+    }
+    if(std::fabs(sum_zero - 1.0) > 1e-3)
+    {
+        RM_THROW(Exception, "normalizeLogWeights of all -inf does not sum to one");
+    }
+
+    bool inf_detected = false;
+    try {
+        log_zero[0] = std::numeric_limits<float>::infinity();
+        normalizeLogWeights(log_zero, w);
+    } catch(const Exception& e) {
+        inf_detected = true;
+    }
+    if(!inf_detected)
+    {
+        RM_THROW(Exception, "normalizeLogWeights did not throw for a +inf log weight");
+    }
+
+    // systematic with uniform weights is the identity
+    Memory<unsigned int, RAM> ids(N);
+    resampleSystematic(uniform, ids, 42);
+    for(size_t i=0; i<N; i++)
+    {
+        if(ids[i] != i)
+        {
+            RM_THROW(Exception, "systematic resampling of uniform weights is not the identity");
+        }
+    }
+
+    // deterministic under seed, sorted and proportional to the weights
+    Memory<unsigned int, RAM> ids2(N);
+    resampleStratified(w, ids, 7);
+    resampleStratified(w, ids2, 7);
+    std::vector<size_t> hist(N, 0);
+    for(size_t i=0; i<N; i++)
+    {
+        if(ids[i] != ids2[i])
+        {
+            RM_THROW(Exception, "stratified resampling is not deterministic");
+        }
+        if(i > 0 && ids[i] < ids[i-1])
+        {
+            RM_THROW(Exception, "stratified resampling ancestors not sorted");
+        }
+        hist[ids[i]]++;
+    }
+    for(size_t i=0; i<10; i++)
+    {
+        const double expected = w[i] * N;
+        if(std::fabs(hist[i] - expected) > 2.0)
+        {
+            RM_THROW(Exception, "stratified resampling not proportional to weights");
+        }
+    }
+
+    Memory<Transform, RAM> resampled = resampleSystematic(particles, w, 7);
+    resampleSystematic(w, ids, 7);
+    for(size_t i=0; i<N; i++)
+    {
+        if(resampled[i].t.x != static_cast<float>(ids[i]))
+        {
+            RM_THROW(Exception, "particle resampling does not match ancestors");
+        }
+    }
+}
+
+void constexpr_test()
+{
+    // math types in constant expressions
+    constexpr Quaternion q{0.0f, 0.0f, 0.70710678f, 0.70710678f};
+    constexpr Transform T{q, {1.0f, 2.0f, 3.0f}, 0};
+    constexpr Transform Tid = T * ~T;
+    static_assert(Tid.t.l2normSquared() < 1e-10f, "T * T^-1 != I");
+    constexpr Matrix3x3 M = Matrix3x3::Identity() * 2.0f + Vector{1.0f, 2.0f, 3.0f}.multT(Vector::Ones());
+    constexpr Matrix3x3 MMi = M * M.inv();
+    static_assert(MMi(1,1) > 0.999f && MMi(1,1) < 1.001f && MMi(0,1) < 1e-5f, "M * M^-1 != I");
+    static_assert(vlp16_900().size() == 16 * 900, "wrong vlp16 size");
+    constexpr Vector6 xi{{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}};
+    static_assert(xi(0) == 1.0f && xi(2) == 3.0f && xi(3) == 4.0f && xi(5) == 6.0f, "wrong Vector6 index order");
+
+    // compile-time ray tables equal the runtime directions
+    static constexpr SphericalModel lidar = vlp16_900();
+    static constexpr Transform Tsb = {q, {0.0f, 0.0f, 0.5f}, 0};
+    static constexpr RayTable<16, 900> lidar_rays = makeRayTable<16, 900>(lidar, Tsb);
+    for(uint32_t vid=0; vid<lidar.getHeight(); vid++)
+    {
+        for(uint32_t hid=0; hid<lidar.getWidth(); hid++)
+        {
+            const Vector d = Tsb * lidar.getDirection(vid, hid) - Tsb.t;
+            if((d - lidar_rays.getDirection(vid, hid)).l2norm() > 1e-5)
+            {
+                RM_THROW(Exception, "spherical ray table differs from model");
+            }
+        }
+    }
+
+    static constexpr PinholeModel cam = example_pinhole();
+    static constexpr RayTable<150, 200> cam_rays = makeRayTable<150, 200>(cam);
+    for(uint32_t vid=0; vid<cam.getHeight(); vid++)
+    {
+        for(uint32_t hid=0; hid<cam.getWidth(); hid++)
+        {
+            if((cam.getDirection(vid, hid) - cam_rays.getDirection(vid, hid)).l2norm() > 1e-5)
+            {
+                RM_THROW(Exception, "pinhole ray table differs from model");
+            }
+        }
+    }
+
+    const O1DnModel o1dn = toO1DnModel(cam_rays);
+    if(o1dn.size() != cam.size() 
+        || (o1dn.getDirection(10, 20) - cam_rays.getDirection(10, 20)).l2normSquared() != 0.0f)
+    {
+        RM_THROW(Exception, "toO1DnModel wrong");
+    }
+}
+
+void closest_point_test()
+{
+    // closest point on triangle vs. dense sampling of the triangle
+    srand(5);
+    auto rnd = []() { return 4.0f * static_cast<float>(rand()) / RAND_MAX - 2.0f; };
+
+    const unsigned int Nsamples = 300;
+    for(size_t t=0; t<200; t++)
+    {
+        const Vector a{rnd(), rnd(), rnd()};
+        const Vector b{rnd(), rnd(), rnd()};
+        // include nearly degenerate slivers
+        const Vector c = (t % 10 == 0) ? a + (b - a) * 0.5f + Vector{0.0f, 0.0f, 1e-3f} : Vector{rnd(), rnd(), rnd()};
+        const Vector p{rnd(), rnd(), rnd()};
+
+        const Vector cp = closestPointTriangle(p, a, b, c);
+        const float d = (cp - p).l2norm();
+
+        float d_bf = std::numeric_limits<float>::max();
+        for(unsigned int i=0; i<=Nsamples; i++)
+        {
+            for(unsigned int j=0; i+j<=Nsamples; j++)
+            {
+                const float u = static_cast<float>(i) / Nsamples;
+                const float v = static_cast<float>(j) / Nsamples;
+                const Vector s = a + (b - a) * u + (c - a) * v;
+                d_bf = std::min(d_bf, (s - p).l2norm());
+            }
+        }
+
+        // cp has to lie on the triangle: check barycentrics
+        const Vector n = (b - a).cross(c - a);
+        const float area2 = n.l2normSquared();
+        const float u = (c - cp).cross(a - cp).dot(n) / area2;
+        const float v = (a - cp).cross(b - cp).dot(n) / area2;
+        const bool on_triangle = u > -1e-3f && v > -1e-3f && u + v < 1.0f + 1e-3f;
+
+        // sampling can only be worse by the sampling resolution
+        const float res = std::max((b - a).l2norm(), (c - a).l2norm()) / Nsamples;
+        if(d > d_bf + 1e-5f || d < d_bf - res || (area2 > 1e-4f && !on_triangle))
+        {
+            std::cout << t << ": " << d << " vs brute force " << d_bf << std::endl;
+            RM_THROW(Exception, "closestPointTriangle wrong");
+        }
+    }
+
+    // vertex, edge and face regions
+    constexpr Vector a{0.0f, 0.0f, 0.0f}, b{1.0f, 0.0f, 0.0f}, c{0.0f, 1.0f, 0.0f};
+    static_assert(closestPointTriangle(Vector{-1.0f, -1.0f, 0.0f}, a, b, c).x == 0.0f, "vertex region");
+    if((closestPointTriangle(Vector{0.5f, -1.0f, 3.0f}, a, b, c) - Vector{0.5f, 0.0f, 0.0f}).l2norm() > 1e-6
+        || (closestPointTriangle(Vector{1.0f, 1.0f, 0.0f}, a, b, c) - Vector{0.5f, 0.5f, 0.0f}).l2norm() > 1e-6
+        || (closestPointTriangle(Vector{0.2f, 0.3f, -2.0f}, a, b, c) - Vector{0.2f, 0.3f, 0.0f}).l2norm() > 1e-6)
+    {
+        RM_THROW(Exception, "closestPointTriangle region wrong");
+    }
+}
+
 int main(int argc, char** argv)
 {
     std::cout << "Rmagine Test: Basic Math" << std::endl;
@@ -528,5 +1427,16 @@ int main(int argc, char** argv)
     init_test();
     math_new();
 
+    reductions_test();
+    batched_test();
+    svd_test();
+    simd_test();
+    expr_test();
+    registration_test();
+    lie_test();
+    resampling_test();
+    constexpr_test();
+    closest_point_test();
+
     return 0;
 }
\ No newline at end of file
@@ -2,8 +2,12 @@
 #include <memory>
 #include <type_traits>
 #include <rmagine/types/Memory.hpp>
+#include <rmagine/types/MemoryEigen.hpp>
 #include <rmagine/types/sensor_models.h>
 #include <rmagine/util/StopWatch.hpp>
+#include <rmagine/util/exceptions.h>
+#include <rmagine/simulation/SimulationResults.hpp>
+#include <rmagine/math/primitives.h>
 
 #include <rmagine/util/prints.h>
 
@@ -245,6 +249,258 @@ void test_slicing_large()
     }
 }
 
+void test_bundle_contiguous()
+{
+    std::cout << "Test contiguous bundle" << std::endl;
+
+    IntAttrAny<RAM> res;
+    resize_memory_bundle_contiguous<RAM>(res, 100, 10, 5);
+
+    if(res.ranges.size() != 5000 || res.ranges.owning())
+    {
+        RM_THROW(Exception, "Contiguous bundle has wrong size");
+    }
+
+    if(reinterpret_cast<uintptr_t>(res.normals.raw()) % BUNDLE_MEMORY_ALIGNMENT != 0)
+    {
+        RM_THROW(Exception, "Contiguous bundle attribute is not aligned");
+    }
+
+    for(size_t i=0; i<res.ranges.size(); i++)
+    {
+        res.ranges[i] = static_cast<float>(i);
+        res.face_ids[i] = i;
+    }
+
+    // same size: no reallocation
+    float* ranges_old = res.ranges.raw();
+    resize_memory_bundle_contiguous<RAM>(res, 100, 10, 5);
+    if(res.ranges.raw() != ranges_old)
+    {
+        RM_THROW(Exception, "Contiguous bundle was reallocated");
+    }
+
+    Memory<IntAttrRecord, RAM> records = copy_bundle_to_records(res);
+    if(records[4321].range != 4321.0 || records[4321].face_id != 4321)
+    {
+        RM_THROW(Exception, "Bundle records are wrong");
+    }
+
+    // an attribute from another slab of the same size: new slab
+    IntAttrAny<RAM> other;
+    resize_memory_bundle_contiguous<RAM>(other, 100, 10, 5);
+    res.normals = Memory<Vector, RAM>(other.normals.raw(), other.normals.size(), other.normals.holder());
+    resize_memory_bundle_contiguous<RAM>(res, 100, 10, 5);
+    if(res.normals.holder() != res.ranges.holder() || res.ranges.raw() == ranges_old)
+    {
+        RM_THROW(Exception, "Contiguous bundle kept an attribute of another slab");
+    }
+    for(size_t i=0; i<res.ranges.size(); i++)
+    {
+        res.ranges[i] = static_cast<float>(i);
+    }
+
+    // borrowed buffers need a holder
+    bool holder_missing_detected = false;
+    try {
+        Memory<float, RAM> no_holder(res.ranges.raw(), 10, nullptr);
+    } catch(const Exception& e) {
+        holder_missing_detected = true;
+    }
+    if(!holder_missing_detected)
+    {
+        RM_THROW(Exception, "Memory borrowed a buffer without holder");
+    }
+
+    // resizing one attribute detaches it from the slab
+    res.ranges.resize(10000);
+    if(!res.ranges.owning() || res.ranges[4999] != 4999.0)
+    {
+        RM_THROW(Exception, "Resizing slab memory lost data");
+    }
+}
+
+void test_adopt()
+{
+    std::cout << "Test adopt" << std::endl;
+
+    std::vector<Point> cloud(1000, Point{1.0, 2.0, 3.0});
+    const Point* cloud_ptr = cloud.data();
+    Memory<Point, RAM> cloud_mem = adopt_memory(std::move(cloud));
+    if(cloud_mem.raw() != cloud_ptr || cloud_mem.size() != 1000)
+    {
+        RM_THROW(Exception, "Adopting std::vector copied the data");
+    }
+
+    Eigen::Matrix3Xf cloud_eig = eigen_map(cloud_mem);
+    if(cloud_eig(2, 999) != 3.0)
+    {
+        RM_THROW(Exception, "Eigen map is wrong");
+    }
+
+    const float* cloud_eig_ptr = cloud_eig.data();
+    Memory<Point, RAM> cloud_mem2 = adopt_memory(std::move(cloud_eig));
+    if(reinterpret_cast<const float*>(cloud_mem2.raw()) != cloud_eig_ptr 
+        || cloud_mem2[999].y != 2.0)
+    {
+        RM_THROW(Exception, "Adopting Eigen matrix copied the data");
+    }
+
+    bool deleted = false;
+    {
+        Memory<float, RAM> mem = adopt_memory(new float[10], 10, 
+            [&](float* p) { deleted = true; delete[] p; });
+    }
+    if(!deleted)
+    {
+        RM_THROW(Exception, "Custom deleter was not called");
+    }
+}
+
+void test_placement()
+{
+    std::cout << "Test placement" << std::endl;
+
+    const size_t min_bytes = 64 * 1024;
+    const size_t N_small = min_bytes / sizeof(float) / 2;
+    const size_t N_large = min_bytes / sizeof(float) * 4 + 3;
+
+    for(RamPlacement placement : {RamPlacement::DEFAULT, RamPlacement::FIRST_TOUCH, RamPlacement::INTERLEAVE})
+    {
+        RAM::setPlacement(placement, min_bytes);
+
+        if(RAM::placement() != placement)
+        {
+            RM_THROW(Exception, "Placement was not set");
+        }
+
+        const bool placing = (placement != RamPlacement::DEFAULT);
+        if(RAM::placed(N_small * sizeof(float)) || RAM::placed(0) 
+            || RAM::placed(N_large * sizeof(float)) != placing)
+        {
+            RM_THROW(Exception, "Placement does not respect min_bytes");
+        }
+
+        // below min_bytes
+        Memory<float, RAM> small(N_small);
+        init(small);
+
+        // above min_bytes
+        Memory<float, RAM> large(N_large);
+        if(placing && reinterpret_cast<uintptr_t>(large.raw()) % 4096 != 0)
+        {
+            RM_THROW(Exception, "Placed memory is not page aligned");
+        }
+        init(large);
+
+        // small grows into placed memory
+        small.resize(N_large);
+        if(placing && reinterpret_cast<uintptr_t>(small.raw()) % 4096 != 0)
+        {
+            RM_THROW(Exception, "Memory grown into placed memory is not page aligned");
+        }
+
+        // large shrinks below min_bytes
+        large.resize(N_small);
+
+        // empty but allocated memory grows into placed memory
+        Memory<float, RAM> empty(N_small);
+        empty.resize(0);
+        empty.resize(N_large);
+        if(placing && reinterpret_cast<uintptr_t>(empty.raw()) % 4096 != 0)
+        {
+            RM_THROW(Exception, "Empty memory grown into placed memory is not page aligned");
+        }
+
+        Memory<float, RAM> large_copy = large;
+        for(size_t i=0; i<N_small; i++)
+        {
+            if(small[i] != static_cast<float>(i) 
+                || large[i] != static_cast<float>(i) 
+                || large_copy[i] != static_cast<float>(i))
+            {
+                RM_THROW(Exception, "Placed memory lost data");
+            }
+        }
+
+        // non-trivially constructible elements
+        Memory<Memory<float, RAM>, RAM> nested(min_bytes / sizeof(Memory<float, RAM>) + 1);
+        nested[nested.size() - 1].resize(10);
+        nested[nested.size() - 1][9] = 9.0;
+        nested.resize(nested.size() * 2);
+        if(nested[nested.size() / 2 - 1][9] != 9.0 || nested[nested.size() - 1].size() != 0)
+        {
+            RM_THROW(Exception, "Placed nested memory is wrong");
+        }
+
+        void* raw = RAM::allocPlaced(100);
+        if(raw == nullptr || reinterpret_cast<uintptr_t>(raw) % 4096 != 0)
+        {
+            RM_THROW(Exception, "allocPlaced is not page aligned");
+        }
+        ::free(raw);
+    }
+
+    RAM::setPlacement(RamPlacement::DEFAULT);
+}
+
+void check_stats(const MemoryStatsEntry& e, 
+    size_t live_bytes, size_t peak_bytes, 
+    size_t allocs, size_t reallocs, size_t frees)
+{
+    if(e.live_bytes != live_bytes || e.peak_bytes != peak_bytes 
+        || e.allocs != allocs || e.reallocs != reallocs || e.frees != frees)
+    {
+        std::cout << "live: " << e.live_bytes << ", peak: " << e.peak_bytes 
+            << ", allocs: " << e.allocs << ", reallocs: " << e.reallocs 
+            << ", frees: " << e.frees << std::endl;
+        RM_THROW(Exception, "Memory statistics are wrong");
+    }
+}
+
+void test_memory_stats()
+{
+    std::cout << "Test memory stats" << std::endl;
+
+    // allocated before recording: freeing it is not counted
+    auto before = std::make_unique<Memory<float, RAM> >(100);
+
+    MemoryStats::enable(false);
+    MemoryStats::reset();
+    {
+        MemoryStatsTag tag("test_memory_stats");
+
+        Memory<float, RAM> a(1000);
+        check_stats(MemoryStats::get("RAM", "test_memory_stats"), 4000, 4000, 1, 0, 0);
+
+        a.resize(2000);
+        check_stats(MemoryStats::get("RAM", "test_memory_stats"), 8000, 8000, 1, 1, 0);
+
+        a.resize(500);
+        check_stats(MemoryStats::get("RAM", "test_memory_stats"), 2000, 8000, 1, 2, 0);
+
+        {
+            Memory<float, RAM> b(100);
+            check_stats(MemoryStats::get("RAM", "test_memory_stats"), 2400, 8000, 2, 2, 0);
+
+            // peak of the memory type follows the tag
+            check_stats(MemoryStats::get("RAM"), 2400, 8000, 2, 2, 0);
+        }
+        check_stats(MemoryStats::get("RAM", "test_memory_stats"), 2000, 8000, 2, 2, 1);
+
+        before.reset();
+    }
+    check_stats(MemoryStats::get("RAM", "test_memory_stats"), 0, 8000, 2, 2, 2);
+    check_stats(MemoryStats::get("RAM"), 0, 8000, 2, 2, 2);
+
+    MemoryStats::disable();
+    {
+        Memory<float, RAM> c(1000);
+    }
+    check_stats(MemoryStats::get("RAM"), 0, 8000, 2, 2, 2);
+    MemoryStats::reset();
+}
+
 MemoryView<float> func()
 {
     // this should not work
@@ -252,6 +508,84 @@ MemoryView<float> func()
     return data(0,5);
 }
 
+void test_primitives()
+{
+    // multiple blocks
+    const size_t N = 100001;
+    Memory<unsigned int, RAM> a(N), inc(N), exc(N);
+    Memory<uint8_t, RAM> hits(N);
+    Memory<size_t, RAM> ids(N);
+    for(size_t i=0; i<N; i++)
+    {
+        a[i] = i % 7;
+        hits[i] = (a[i] > 3);
+        ids[i] = i;
+    }
+
+    const unsigned int total_inc = inclusive_scan(a, inc);
+    const unsigned int total_exc = exclusive_scan(a, exc);
+    unsigned int sum = 0;
+    for(size_t i=0; i<N; i++)
+    {
+        if(exc[i] != sum)
+        {
+            RM_THROW(Exception, "exclusive_scan is wrong.");
+        }
+        sum += a[i];
+        if(inc[i] != sum)
+        {
+            RM_THROW(Exception, "inclusive_scan is wrong.");
+        }
+    }
+    if(total_inc != sum || total_exc != sum)
+    {
+        RM_THROW(Exception, "scan total is wrong.");
+    }
+
+    // compaction and partition are stable
+    Memory<size_t, RAM> valid = compact(ids, hits);
+    Memory<size_t, RAM> parted(N);
+    const size_t Ntrue = partition(ids, parted, [&](size_t i) { return hits[i] != 0; });
+    if(Ntrue != valid.size())
+    {
+        RM_THROW(Exception, "partition and compact disagree.");
+    }
+    for(size_t i=0; i<valid.size(); i++)
+    {
+        if(!hits[valid[i]] || parted[i] != valid[i] || (i > 0 && valid[i] <= valid[i-1]))
+        {
+            RM_THROW(Exception, "compact is wrong.");
+        }
+    }
+
+    // buckets by key
+    Memory<unsigned int, RAM> offsets(8);
+    Memory<size_t, RAM> bucketed(N);
+    partition(ids, a, 7, bucketed, offsets);
+    for(size_t k=0; k<7; k++)
+    {
+        for(size_t i=offsets[k]; i<offsets[k+1]; i++)
+        {
+            if(a[bucketed[i]] != k || (i > offsets[k] && bucketed[i] <= bucketed[i-1]))
+            {
+                RM_THROW(Exception, "partition by key is wrong.");
+            }
+        }
+    }
+
+    // gather / scatter are inverse for permutations
+    Memory<unsigned int, RAM> g = gather(a, bucketed);
+    Memory<unsigned int, RAM> s(N);
+    scatter(g, bucketed, s);
+    for(size_t i=0; i<N; i++)
+    {
+        if(s[i] != a[i])
+        {
+            RM_THROW(Exception, "scatter(gather(a)) != a");
+        }
+    }
+}
+
 int main(int argc, char** argv)
 {
     std::cout << "Rmagine Tests: Memory" << std::endl;
@@ -262,5 +596,11 @@ int main(int argc, char** argv)
     test_slicing_small();
     test_slicing_large();
 
+    test_bundle_contiguous();
+    test_adopt();
+    test_placement();
+    test_memory_stats();
+    test_primitives();
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include <iostream>
+#include <rmagine/types/Memory.hpp>
+#include <rmagine/types/TensorView.hpp>
+#include <rmagine/types/sensor_models.h>
+#include <rmagine/util/exceptions.h>
+
+using namespace rmagine;
+
+static int chapter_counter = 0;
+
+SphericalModel make_model()
+{
+    SphericalModel model;
+    model.phi.min = -0.1;
+    model.phi.inc = 0.01;
+    model.phi.size = 8;
+    model.theta.min = -M_PI;
+    model.theta.inc = 0.1;
+    model.theta.size = 20;
+    model.range.min = 0.0;
+    model.range.max = 100.0;
+    return model;
+}
+
+void test_indexing()
+{
+    chapter_counter++;
+    std::cout << chapter_counter << ". TensorView Indexing" << std::endl;
+
+    SphericalModel model = make_model();
+    const size_t Nposes = 5;
+
+    Memory<float, RAM> ranges(model.size() * Nposes);
+    for(size_t i=0; i<ranges.size(); i++)
+    {
+        ranges[i] = static_cast<float>(i);
+    }
+
+    auto T = make_sensor_view(ranges, model);
+
+    if(T.shape(0) != Nposes || T.shape(1) != model.getHeight() || T.shape(2) != model.getWidth())
+    {
+        RM_THROW(Exception, "Sensor view has wrong shape");
+    }
+
+    for(size_t pid = 0; pid < Nposes; pid++)
+    {
+        for(unsigned int vid = 0; vid < model.getHeight(); vid++)
+        {
+            for(unsigned int hid = 0; hid < model.getWidth(); hid++)
+            {
+                const size_t glob_id = pid * model.size() + model.getBufferId(vid, hid);
+                if(T(pid, vid, hid) != ranges[glob_id])
+                {
+                    RM_THROW(Exception, "Sensor view index differs from buffer id");
+                }
+            }
+        }
+    }
+
+    if(!T.isContiguous() || T.flat().raw() != ranges.raw())
+    {
+        RM_THROW(Exception, "Sensor view should be contiguous");
+    }
+
+    std::cout << "- correct" << std::endl;
+}
+
+void test_slicing()
+{
+    chapter_counter++;
+    std::cout << chapter_counter << ". TensorView Slicing" << std::endl;
+
+    SphericalModel model = make_model();
+    const size_t Nposes = 5;
+
+    Memory<float, RAM> ranges(model.size() * Nposes);
+    for(size_t i=0; i<ranges.size(); i++)
+    {
+        ranges[i] = static_cast<float>(i);
+    }
+
+    auto T = make_sensor_view(ranges, model);
+
+    // rows 2-5, every second column of all poses
+    auto W = T.slice(1, 2, 6).slice(2, 0, model.getWidth(), 2);
+
+    if(W.isContiguous() || W.shape(1) != 4 || W.shape(2) != model.getWidth() / 2)
+    {
+        RM_THROW(Exception, "Sliced view has wrong shape");
+    }
+
+    Memory<float, RAM> Wc(W.size());
+    copy(W, Wc);
+
+    auto Wct = TensorView<float, 3>(Wc, W.shape());
+    for(size_t pid = 0; pid < W.shape(0); pid++)
+    {
+        for(size_t vid = 0; vid < W.shape(1); vid++)
+        {
+            for(size_t hid = 0; hid < W.shape(2); hid++)
+            {
+                if(Wct(pid, vid, hid) != T(pid, vid + 2, hid * 2))
+                {
+                    RM_THROW(Exception, "Copy of sliced view is wrong");
+                }
+            }
+        }
+    }
+
+    // select a single pose
+    auto S = T.select(0, 3);
+    if(S(1, 2) != T(3, 1, 2))
+    {
+        RM_THROW(Exception, "Select is wrong");
+    }
+
+    std::cout << "- correct" << std::endl;
+}
+
+void test_transpose()
+{
+    chapter_counter++;
+    std::cout << chapter_counter << ". TensorView Transpose" << std::endl;
+
+    SphericalModel model = make_model();
+    const size_t Nposes = 3;
+
+    Memory<float, RAM> ranges(model.size() * Nposes);
+    for(size_t i=0; i<ranges.size(); i++)
+    {
+        ranges[i] = static_cast<float>(i);
+    }
+    const MemoryView<float, RAM>& ranges_const = ranges;
+    auto T = make_sensor_view(ranges_const, model);
+
+    // (pose, row, col) -> (pose, col, row)
+    auto Tt = T.transpose(1, 2);
+
+    Memory<float, RAM> dst_mem(Tt.size());
+    TensorView<float, 3> dst(dst_mem, Tt.shape());
+    dst = Tt;
+
+    for(size_t pid = 0; pid < Nposes; pid++)
+    {
+        for(unsigned int vid = 0; vid < model.getHeight(); vid++)
+        {
+            for(unsigned int hid = 0; hid < model.getWidth(); hid++)
+            {
+                if(dst(pid, hid, vid) != T(pid, vid, hid))
+                {
+                    RM_THROW(Exception, "Transposed copy is wrong");
+                }
+            }
+        }
+    }
+
+    auto Tp = T.permute({2, 0, 1});
+    if(Tp(4, 1, 3) != T(1, 3, 4))
+    {
+        RM_THROW(Exception, "Permute is wrong");
+    }
+
+    std::cout << "- correct" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    std::cout << "Rmagine Tests: Memory Tensor Views" << std::endl;
+
+    test_indexing();
+    test_slicing();
+    test_transpose();
+
+    return 0;
+}
@@ -4,6 +4,12 @@
 #include <rmagine/map/embree/embree_shapes.h>
 #include <rmagine/math/types.h>
 #include <rmagine/util/prints.h>
+#include <rmagine/util/exceptions.h>
+#include <rmagine/simulation/SimulationResults.hpp>
+#include <rmagine/math/closest_point.h>
+
+#include <cmath>
+#include <limits>
 
 namespace rm = rmagine;
 
@@ -78,6 +84,30 @@ rm::EmbreeMapPtr make_map_3()
     return std::make_shared<rm::EmbreeMap>(cube_scene);;
 }
 
+// closest point over all faces of all meshes of the map
+float closest_distance_brute_force(rm::EmbreeMapPtr map, const rm::Point& qp)
+{
+    float d_min = std::numeric_limits<float>::infinity();
+    for(const auto& elem : map->scene->geometries())
+    {
+        rm::EmbreeMeshPtr mesh = std::dynamic_pointer_cast<rm::EmbreeMesh>(elem.second);
+        if(!mesh)
+        {
+            continue;
+        }
+
+        const rm::MemoryView<const rm::Vertex, rm::RAM> vertices = mesh->verticesTransformed();
+        const rm::MemoryView<const rm::Face, rm::RAM> faces = std::as_const(*mesh).faces();
+        for(size_t i=0; i<faces.size(); i++)
+        {
+            const rm::Face& f = faces[i];
+            const rm::Point cp = rm::closestPointTriangle(qp, vertices[f.v0], vertices[f.v1], vertices[f.v2]);
+            d_min = std::min(d_min, (cp - qp).l2norm());
+        }
+    }
+    return d_min;
+}
+
 int main(int argc, char ** argv)
 {
     std::cout << "EMBREE CLOSEST POINT" << std::endl;
@@ -102,6 +132,61 @@ int main(int argc, char ** argv)
     qp = {0.1, 0.1, 20.0};
     cp = map->closestPoint(qp);
     std::cout << qp << " -> " << cp << std::endl;
+
+    // batched queries must match the single ones
+    rm::Memory<rm::Point, rm::RAM> qps(1000);
+    for(size_t i=0; i<qps.size(); i++)
+    {
+        qps[i] = {
+            static_cast<float>(i % 10) * 3.0f - 5.0f, 
+            static_cast<float>((i / 10) % 10) * 2.0f - 10.0f, 
+            static_cast<float>(i / 100) * 1.5f};
+    }
+
+    using ResT = rm::Bundle<rm::Hits<rm::RAM>, rm::Ranges<rm::RAM>, rm::Points<rm::RAM>, rm::Normals<rm::RAM>, rm::FaceIds<rm::RAM> >;
+    ResT res = map->closestPoints<ResT>(qps);
+
+    for(size_t i=0; i<qps.size(); i++)
+    {
+        const rm::Point cp_single = map->closestPoint(qps[i]);
+        if(!res.hits[i] || (res.points[i] - cp_single).l2norm() > 0.0001)
+        {
+            RM_THROW(rm::Exception, "batched closest point differs from single query");
+        }
+
+        if(std::fabs((res.points[i] - qps[i]).l2norm() - res.ranges[i]) > 0.0001)
+        {
+            RM_THROW(rm::Exception, "closest point distance wrong");
+        }
+
+        if(std::fabs(res.ranges[i] - closest_distance_brute_force(map, qps[i])) > 0.0001)
+        {
+            std::cout << qps[i] << ": " << res.ranges[i] << " vs. " << closest_distance_brute_force(map, qps[i]) << std::endl;
+            RM_THROW(rm::Exception, "batched closest point differs from brute force");
+        }
+    }
+
+    // nothing within radius
+    const float max_radius = 0.1;
+    ResT res_r = map->closestPoints<ResT>(qps, max_radius);
+    for(size_t i=0; i<qps.size(); i++)
+    {
+        if(res_r.hits[i] != (res.ranges[i] < max_radius))
+        {
+            RM_THROW(rm::Exception, "closest point max radius not respected");
+        }
+    }
+
+    // instances are not supported by point queries: ignored, not reported per candidate
+    auto map_inst = make_map_2();
+    ResT res_inst = map_inst->closestPoints<ResT>(qps);
+    for(size_t i=0; i<qps.size(); i++)
+    {
+        if(res_inst.hits[i])
+        {
+            RM_THROW(rm::Exception, "closest point found on an unsupported instance");
+        }
+    }
     
 
 
@@ -0,0 +1,122 @@
+#include <iostream>
+#include <cmath>
+#include <limits>
+
+#include <rmagine/map/EmbreeMap.hpp>
+#include <rmagine/map/embree/embree_shapes.h>
+#include <rmagine/map/embree_distance_field.h>
+#include <rmagine/math/closest_point.h>
+#include <rmagine/util/exceptions.h>
+#include <rmagine/util/prints.h>
+
+using namespace rmagine;
+
+// brute force distance to all faces of the mesh
+float closest_distance(EmbreeMeshPtr mesh, const Point& p)
+{
+    const MemoryView<const Vertex, RAM> vertices = mesh->verticesTransformed();
+    const MemoryView<const Face, RAM> faces = std::as_const(*mesh).faces();
+
+    float d_min = std::numeric_limits<float>::infinity();
+    for(size_t i=0; i<faces.size(); i++)
+    {
+        const Face& f = faces[i];
+        const Point cp = closestPointTriangle(p, vertices[f.v0], vertices[f.v1], vertices[f.v2]);
+        d_min = std::min(d_min, (cp - p).l2norm());
+    }
+    return d_min;
+}
+
+int main(int argc, char** argv)
+{
+    std::cout << "EMBREE DISTANCE FIELD" << std::endl;
+
+    // box [0.3, 2.3] x [-1.2, -0.2] x [0.15, 1.65]
+    EmbreeMeshPtr cube = std::make_shared<EmbreeCube>();
+    Transform T = Transform::Identity();
+    T.t = {1.3, -0.7, 0.9};
+    const Vector3 scale = {2.0, 1.0, 1.5};
+    cube->setTransform(T);
+    cube->setScale(scale);
+    cube->apply();
+    cube->commit();
+
+    EmbreeScenePtr scene = std::make_shared<EmbreeScene>();
+    scene->add(cube);
+    scene->commit();
+    EmbreeMapPtr map = std::make_shared<EmbreeMap>(scene);
+
+    DistanceFieldSettings settings;
+    settings.voxel_size = 0.05;
+    settings.band = 0.3;
+    settings.signed_distance = true;
+
+    DistanceField df = make_distance_field(map, settings);
+    std::cout << "- " << df.numBlocks() << " blocks" << std::endl;
+
+    if(df.numBlocks() == 0)
+    {
+        RM_THROW(EmbreeException, "Distance field has no blocks");
+    }
+
+    // trilinear interpolation of a 1-Lipschitz function
+    const float tolerance = settings.voxel_size;
+
+    size_t num_checked = 0;
+    size_t num_inside = 0;
+    for(float z = -0.2; z < 2.0; z += 0.037)
+    {
+        for(float y = -1.6; y < 0.2; y += 0.037)
+        {
+            for(float x = -0.1; x < 2.7; x += 0.037)
+            {
+                const Point p = {x, y, z};
+                const float d_true = closest_distance(cube, p);
+
+                // stay off the truncation
+                if(d_true > settings.band - tolerance)
+                {
+                    continue;
+                }
+
+                float d;
+                if(!df.distance(p, d))
+                {
+                    std::cout << p << " with distance " << d_true << " is not covered" << std::endl;
+                    RM_THROW(EmbreeException, "Point near the surface is not covered by the field");
+                }
+
+                const Vector rel = p - T.t;
+                const bool inside = std::fabs(rel.x) < scale.x / 2.0
+                    && std::fabs(rel.y) < scale.y / 2.0
+                    && std::fabs(rel.z) < scale.z / 2.0;
+                const float d_signed = inside ? -d_true : d_true;
+
+                if(std::fabs(d - d_signed) > tolerance)
+                {
+                    std::cout << p << ": field " << d << ", brute force " << d_signed << std::endl;
+                    RM_THROW(EmbreeException, "Field distance differs from brute force distance");
+                }
+
+                // sign by parity: negative inside the cube
+                if(inside && d_true > tolerance && d >= 0.0)
+                {
+                    std::cout << p << ": field " << d << std::endl;
+                    RM_THROW(EmbreeException, "Distance inside the cube is not negative");
+                }
+
+                num_checked++;
+                num_inside += inside;
+            }
+        }
+    }
+
+    std::cout << "- checked " << num_checked << " points, " << num_inside << " inside" << std::endl;
+
+    if(num_inside == 0 || num_inside == num_checked)
+    {
+        RM_THROW(EmbreeException, "Samples do not cover both sides of the surface");
+    }
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <iostream>
+#include <cmath>
+
+#include <rmagine/map/embree/embree_shapes.h>
+#include <rmagine/map/embree/embree_lod.h>
+#include <rmagine/map/embree/EmbreeInstance.hpp>
+#include <rmagine/map/EmbreeLodMap.hpp>
+#include <rmagine/util/exceptions.h>
+#include <rmagine/util/prints.h>
+
+using namespace rmagine;
+
+int main(int argc, char** argv)
+{
+    std::cout << "EMBREE LOD" << std::endl;
+
+    // sphere with diameter 1
+    EmbreeMeshPtr sphere = std::make_shared<EmbreeSphere>(100, 100);
+    Transform T = Transform::Identity();
+    T.t = {10.0, 0.0, 0.0};
+    sphere->setTransform(T);
+    sphere->apply();
+    sphere->commit();
+
+    const std::vector<float> max_errors = {0.001, 0.01, 0.05};
+    make_embree_lods(sphere, max_errors);
+
+    if(sphere->lods.size() != max_errors.size())
+    {
+        RM_THROW(EmbreeException, "Expected one level per error");
+    }
+
+    size_t num_faces = std::as_const(*sphere).faces().size();
+    for(size_t i=0; i<sphere->lods.size(); i++)
+    {
+        const EmbreeMeshLod& lod = sphere->lods[i];
+        const size_t num_faces_lod = std::as_const(*lod.mesh).faces().size();
+        std::cout << "- level " << i + 1 << ": " << num_faces_lod << " faces, error " << lod.error << std::endl;
+
+        if(num_faces_lod >= num_faces || lod.error > max_errors[i])
+        {
+            RM_THROW(EmbreeException, "Level does not simplify within its error");
+        }
+        num_faces = num_faces_lod;
+
+        // simplified surface stays close to the sphere
+        for(const Vertex& v : lod.mesh->verticesTransformed())
+        {
+            if(std::fabs((v - T.t).l2norm() - 0.5) > max_errors[i])
+            {
+                RM_THROW(EmbreeException, "Simplified vertex is too far from the original surface");
+            }
+        }
+    }
+
+    EmbreeScenePtr scene = std::make_shared<EmbreeScene>();
+    scene->add(sphere);
+    scene->commit();
+
+    EmbreeLodMapSettings settings;
+    settings.error_budget = 0.001;
+    EmbreeLodMapPtr map = std::make_shared<EmbreeLodMap>(scene, settings);
+
+    if(map->numObjects() != 1 || map->levels()[0] != 0)
+    {
+        RM_THROW(EmbreeException, "LOD map does not start with the original mesh");
+    }
+
+    // 19.5m away: 1.95cm tolerated -> level 2
+    Transform Tfar = Transform::Identity();
+    Tfar.t = {-10.0, 0.0, 0.0};
+    map->update(Tfar).get();
+    if(map->levels()[0] != 2)
+    {
+        std::cout << "level: " << map->levels()[0] << std::endl;
+        RM_THROW(EmbreeException, "Wrong level selected for medium distance");
+    }
+
+    // next to the sphere: original mesh
+    Transform Tnear = Transform::Identity();
+    Tnear.t = {9.0, 0.0, 0.0};
+    map->update(Tnear).get();
+    if(map->levels()[0] != 0)
+    {
+        RM_THROW(EmbreeException, "Wrong level selected for short distance");
+    }
+
+    // levels must be ascending
+    bool thrown = false;
+    try {
+        make_embree_lods(sphere, {0.05, 0.01});
+    } catch(const EmbreeException& ex) {
+        thrown = true;
+    }
+    if(!thrown)
+    {
+        RM_THROW(EmbreeException, "Descending errors were not rejected");
+    }
+
+    // instanced scene, scaled by 2 at (-10, 0, 0)
+    EmbreeMeshPtr inner_sphere = std::make_shared<EmbreeSphere>(100, 100);
+    inner_sphere->commit();
+    EmbreeScenePtr inner = inner_sphere->makeScene();
+    inner->commit();
+
+    EmbreeInstancePtr inst = inner->instantiate();
+    Transform Tinst = Transform::Identity();
+    Tinst.t = {-10.0, 0.0, 0.0};
+    inst->setTransform(Tinst);
+    inst->setScale({2.0, 2.0, 2.0});
+    inst->apply();
+    inst->commit();
+
+    EmbreeScenePtr scene_inst = std::make_shared<EmbreeScene>();
+    scene_inst->add(inst);
+    scene_inst->commit();
+
+    make_embree_lods(scene_inst, max_errors);
+    if(inner_sphere->lods.size() != max_errors.size())
+    {
+        RM_THROW(EmbreeException, "Meshes of instanced scenes got no levels");
+    }
+
+    EmbreeLodMapPtr map_inst = std::make_shared<EmbreeLodMap>(scene_inst, settings);
+    if(map_inst->numObjects() != 1)
+    {
+        RM_THROW(EmbreeException, "Instance was not turned into a LOD object");
+    }
+
+    // sphere of diameter 2 around (-10, 0, 0): 17m away -> 1.7cm tolerated. 
+    // Errors are doubled by the scale: level 1 (~2mm) fits, level 2 (~2cm) does not
+    Transform Tinst_far = Transform::Identity();
+    Tinst_far.t = {8.0, 0.0, 0.0};
+    map_inst->update(Tinst_far).get();
+    if(map_inst->levels()[0] != 1)
+    {
+        std::cout << "level: " << map_inst->levels()[0] << std::endl;
+        RM_THROW(EmbreeException, "Wrong level selected for scaled instance");
+    }
+
+    std::cout << "Done." << std::endl;
+
+    return 0;
+}
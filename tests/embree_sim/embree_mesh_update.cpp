@@ -0,0 +1,140 @@
+#include <iostream>
+#include <cmath>
+
+#include <rmagine/map/embree/embree_shapes.h>
+#include <rmagine/map/embree/EmbreeSceneUpdate.hpp>
+#include <rmagine/map/EmbreeMap.hpp>
+#include <rmagine/util/exceptions.h>
+#include <rmagine/util/prints.h>
+
+using namespace rmagine;
+
+bool equal(const Vector& a, const Vector& b)
+{
+    return (a - b).l2norm() < 1e-5;
+}
+
+int main(int argc, char** argv)
+{
+    std::cout << "EMBREE MESH UPDATE" << std::endl;
+
+    EmbreeScenePtr scene = std::make_shared<EmbreeScene>();
+
+    // a: partial updates, b: reference with full updates
+    EmbreeMeshPtr a = std::make_shared<EmbreeSphere>(20, 20);
+    EmbreeMeshPtr b = std::make_shared<EmbreeSphere>(20, 20);
+    scene->add(a);
+    scene->add(b);
+    scene->commit();
+
+    Transform T = Transform::Identity();
+    T.t = {1.0, 2.0, 3.0};
+    T.R = EulerAngles{0.1, 0.2, 0.3};
+    a->setTransform(T);
+    b->setTransform(T);
+    a->apply();
+    b->apply();
+
+    // move a few vertices
+    const unsigned int offset = 10;
+    Memory<Vertex, RAM> moved(5);
+    for(size_t i=0; i<moved.size(); i++)
+    {
+        moved[i] = std::as_const(*a).vertices()[offset + i] * 1.5;
+    }
+
+    a->setVertices(moved, offset);
+    a->apply();
+
+    MemoryView<Vertex, RAM> b_vertices = b->vertices();
+    for(size_t i=0; i<moved.size(); i++)
+    {
+        b_vertices[offset + i] = moved[i];
+    }
+    b->apply();
+
+    for(size_t i=0; i<a->verticesTransformed().size(); i++)
+    {
+        if(!equal(a->verticesTransformed()[i], b->verticesTransformed()[i]))
+        {
+            RM_THROW(EmbreeException, "Partial vertex update differs from full update");
+        }
+    }
+
+    for(size_t i=0; i<a->faceNormalsTransformed().size(); i++)
+    {
+        if(!equal(a->faceNormalsTransformed()[i], b->faceNormalsTransformed()[i]))
+        {
+            RM_THROW(EmbreeException, "Face normals of partial vertex update differ from full update");
+        }
+    }
+
+    a->commit();
+    b->commit();
+    scene->commit();
+
+    // rigid objects are moved by instance transforms
+    EmbreeInstancePtr inst = scene->makeRigid(a);
+    if(!inst || scene->has(EmbreeGeometryPtr(a)) || !scene->has(EmbreeGeometryPtr(inst)))
+    {
+        RM_THROW(EmbreeException, "makeRigid did not replace the mesh");
+    }
+
+    if(!equal(inst->transform().t, T.t) || !equal(a->transform().t, {0.0, 0.0, 0.0}))
+    {
+        RM_THROW(EmbreeException, "makeRigid did not move the transform to the instance");
+    }
+
+    if(!equal(T * std::as_const(*a).vertices()[0], b->verticesTransformed()[0]))
+    {
+        RM_THROW(EmbreeException, "makeRigid changed the geometry");
+    }
+
+    scene->commit();
+
+    // batched updates
+    EmbreeSceneUpdate update(scene, 2);
+    for(size_t i=0; i<4; i++)
+    {
+        T.t.x += 1.0;
+        update.setTransform(inst, T);
+        update.setVertices(b, moved, offset + i);
+
+        if(update.size() != 2)
+        {
+            RM_THROW(EmbreeException, "EmbreeSceneUpdate did not merge changes per geometry");
+        }
+
+        EmbreeSceneUpdateTimings timings = update.commit();
+        if(update.size() != 0 || timings.total < timings.commit_scenes)
+        {
+            RM_THROW(EmbreeException, "EmbreeSceneUpdate::commit failed");
+        }
+
+        // max_refits = 2: refit, refit, rebuild, refit
+        const unsigned int refits_expected = (i + 1) % 3;
+        if(update.refits(b) != refits_expected)
+        {
+            std::cout << "- update " << i << ": " << update.refits(b) << " refits, expected " << refits_expected << std::endl;
+            RM_THROW(EmbreeException, "EmbreeSceneUpdate did not rebuild after max_refits");
+        }
+    }
+
+    // changed topology: always rebuilt
+    update.touch(b, true);
+    update.commit();
+    if(update.refits(b) != 0)
+    {
+        RM_THROW(EmbreeException, "EmbreeSceneUpdate refitted a mesh with changed topology");
+    }
+
+    if(!equal(inst->transform().t, T.t) 
+        || !equal(b->verticesTransformed()[offset + 3], T.R * moved[0] + Vector{1.0, 2.0, 3.0}))
+    {
+        RM_THROW(EmbreeException, "EmbreeSceneUpdate did not apply the changes");
+    }
+
+    std::cout << "Done." << std::endl;
+
+    return 0;
+}
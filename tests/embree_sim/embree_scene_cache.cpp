@@ -0,0 +1,147 @@
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+
+#include <rmagine/simulation/SphereSimulatorEmbree.hpp>
+#include <rmagine/map/embree/embree_shapes.h>
+#include <rmagine/map/embree/embree_cache.h>
+#include <rmagine/map/EmbreeMap.hpp>
+#include <rmagine/types/sensors.h>
+#include <rmagine/util/exceptions.h>
+#include <rmagine/util/prints.h>
+
+using namespace rmagine;
+
+EmbreeScenePtr make_scene()
+{
+    EmbreeScenePtr scene = std::make_shared<EmbreeScene>();
+
+    // mesh with baked transform
+    EmbreeMeshPtr sphere = std::make_shared<EmbreeSphere>();
+    sphere->name = "sphere";
+    Transform T = Transform::Identity();
+    T.t = {3.0, 0.0, 0.0};
+    sphere->setTransform(T);
+    sphere->apply();
+    sphere->commit();
+    scene->add(sphere);
+
+    // one mesh instanced twice
+    EmbreeMeshPtr cube = std::make_shared<EmbreeCube>();
+    cube->name = "cube";
+    cube->commit();
+    EmbreeScenePtr cube_scene = cube->makeScene();
+    cube_scene->commit();
+
+    for(size_t i=0; i<2; i++)
+    {
+        EmbreeInstancePtr inst = cube_scene->instantiate();
+        inst->name = "cube_" + std::to_string(i);
+        T.t = {-3.0, (i == 0 ? -2.0f : 2.0f), 0.0};
+        inst->setTransform(T);
+        inst->setScale({1.0, 2.0, 1.0});
+        inst->apply();
+        inst->commit();
+        scene->add(inst);
+    }
+
+    scene->setQuality(RTC_BUILD_QUALITY_HIGH);
+    scene->commit();
+    return scene;
+}
+
+Memory<float, RAM> simulate(EmbreeScenePtr scene)
+{
+    SphereSimulatorEmbree sim;
+    sim.setMap(std::make_shared<EmbreeMap>(scene));
+    auto model = vlp16_360();
+    sim.setModel(model);
+
+    Memory<Transform, RAM> T(1);
+    T[0] = Transform::Identity();
+
+    Bundle<Ranges<RAM> > res;
+    resize_memory_bundle<RAM>(res, model.getWidth(), model.getHeight(), 1);
+    sim.simulate(T, res);
+    return res.ranges;
+}
+
+int main(int argc, char** argv)
+{
+    std::cout << "EMBREE SCENE CACHE" << std::endl;
+
+    const std::string filename = "rmagine_test_scene.rmsc";
+
+    EmbreeScenePtr scene = make_scene();
+    save_embree_scene(scene, filename);
+
+    if(!is_embree_scene_cache(filename))
+    {
+        RM_THROW(EmbreeException, "Written file is not recognized as scene cache");
+    }
+
+    EmbreeScenePtr loaded = load_embree_scene(filename);
+    
+    if(loaded->count<EmbreeMesh>() != 1 || loaded->count<EmbreeInstance>() != 2)
+    {
+        RM_THROW(EmbreeException, "Loaded scene has a different structure");
+    }
+
+    if(loaded->settings().quality != RTC_BUILD_QUALITY_HIGH)
+    {
+        RM_THROW(EmbreeException, "Scene settings were not restored");
+    }
+
+    // the instanced mesh is stored once
+    EmbreeInstancePtr inst0 = loaded->getAs<EmbreeInstance>(1);
+    EmbreeInstancePtr inst1 = loaded->getAs<EmbreeInstance>(2);
+    if(!inst0 || !inst1 || inst0->scene() != inst1->scene() || inst1->name != "cube_1")
+    {
+        RM_THROW(EmbreeException, "Instances were not restored");
+    }
+
+    // same scans
+    Memory<float, RAM> ranges = simulate(scene);
+    Memory<float, RAM> ranges_loaded = simulate(loaded);
+
+    for(size_t i=0; i<ranges.size(); i++)
+    {
+        const bool same = (std::isfinite(ranges[i]) == std::isfinite(ranges_loaded[i])) 
+            && (!std::isfinite(ranges[i]) || std::fabs(ranges[i] - ranges_loaded[i]) < 1e-5);
+        if(!same)
+        {
+            std::stringstream ss;
+            ss << "Range " << i << " differs: " << ranges[i] << " vs " << ranges_loaded[i];
+            RM_THROW(EmbreeException, ss.str());
+        }
+    }
+
+    // moving a mapped mesh must not touch the file
+    EmbreeMeshPtr sphere = loaded->getAs<EmbreeMesh>(0);
+    const Vertex v0 = sphere->verticesTransformed()[0];
+    Transform T = Transform::Identity();
+    T.t.z = 10.0;
+    sphere->setTransform(T);
+    sphere->apply();
+    sphere->commit();
+    loaded->commit();
+
+    if(std::fabs(sphere->verticesTransformed()[0].z - v0.z - 10.0) > 1e-5 
+        || std::fabs(sphere->vertices()[0].z - v0.z) > 1e-5)
+    {
+        RM_THROW(EmbreeException, "Transforming a loaded mesh failed");
+    }
+
+    EmbreeScenePtr reloaded = load_embree_scene(filename);
+    if(std::fabs(reloaded->getAs<EmbreeMesh>(0)->vertices()[0].z - v0.z) > 1e-5)
+    {
+        RM_THROW(EmbreeException, "Cache file was modified");
+    }
+
+    std::remove(filename.c_str());
+
+    std::cout << "Done." << std::endl;
+
+    return 0;
+}
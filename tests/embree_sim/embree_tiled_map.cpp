@@ -0,0 +1,225 @@
+#include <iostream>
+#include <cmath>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <rmagine/simulation/SphereSimulatorEmbree.hpp>
+#include <rmagine/map/embree/embree_shapes.h>
+#include <rmagine/map/TiledEmbreeMap.hpp>
+#include <rmagine/types/sensors.h>
+#include <rmagine/util/exceptions.h>
+#include <rmagine/util/prints.h>
+
+using namespace rmagine;
+
+// one cube in the center of the tiles (0,0), (2,0), (4,0) for tiles of 50m
+EmbreeScenePtr make_scene()
+{
+    EmbreeScenePtr scene = std::make_shared<EmbreeScene>();
+
+    for(int i=0; i<3; i++)
+    {
+        EmbreeMeshPtr cube = std::make_shared<EmbreeCube>();
+        Transform T = Transform::Identity();
+        T.t = {25.0f + i * 100.0f, 25.0, 0.0};
+        cube->setTransform(T);
+        cube->apply();
+        cube->commit();
+        scene->add(cube);
+    }
+
+    scene->commit();
+    return scene;
+}
+
+// one triangle: centroid in tile (0,0), but it reaches far into other tiles
+EmbreeScenePtr make_ground()
+{
+    EmbreeScenePtr scene = std::make_shared<EmbreeScene>();
+
+    EmbreeMeshPtr ground = std::make_shared<EmbreeMesh>(3, 1);
+    MemoryView<Vertex, RAM> vertices = ground->vertices();
+    vertices[0] = {-10.0, -10.0, 0.0};
+    vertices[1] = {140.0, -10.0, 0.0};
+    vertices[2] = {-10.0, 140.0, 0.0};
+    ground->faces()[0] = {0, 1, 2};
+    ground->computeFaceNormals();
+    ground->apply();
+    ground->commit();
+    scene->add(ground);
+
+    scene->commit();
+    return scene;
+}
+
+// temporary directory, removed with all files on destruction
+struct TempDirectory
+{
+    std::string path;
+
+    TempDirectory()
+    {
+        char tmpl[] = "/tmp/rmagine_test_tiles_XXXXXX";
+        if(mkdtemp(tmpl) == nullptr)
+        {
+            RM_THROW(EmbreeException, "Could not create a temporary directory");
+        }
+        path = tmpl;
+    }
+
+    ~TempDirectory()
+    {
+        remove_recursive(path);
+    }
+
+    static void remove_recursive(const std::string& dir)
+    {
+        if(DIR* d = opendir(dir.c_str()))
+        {
+            while(dirent* entry = readdir(d))
+            {
+                const std::string name = entry->d_name;
+                if(name == "." || name == "..")
+                {
+                    continue;
+                }
+                const std::string file = dir + "/" + name;
+                if(entry->d_type == DT_DIR)
+                {
+                    remove_recursive(file);
+                } else {
+                    std::remove(file.c_str());
+                }
+            }
+            closedir(d);
+        }
+        rmdir(dir.c_str());
+    }
+};
+
+size_t count_hits(
+    const SphereSimulatorEmbree& sim, 
+    const Transform& Tbm,
+    float max_range)
+{
+    Memory<Transform, RAM> T(1);
+    T[0] = Tbm;
+    Memory<float, RAM> ranges = sim.simulateRanges(T);
+
+    size_t hits = 0;
+    for(size_t i=0; i<ranges.size(); i++)
+    {
+        if(ranges[i] <= max_range)
+        {
+            hits++;
+        }
+    }
+    return hits;
+}
+
+void test_streaming(const std::string& directory)
+{
+    if(save_tiled_embree_map(make_scene(), directory, 50.0) != 3)
+    {
+        RM_THROW(EmbreeException, "Expected 3 tiles");
+    }
+
+    TiledEmbreeMapSettings settings;
+    settings.range = 20.0;
+    // keep only the tiles in range
+    settings.memory_budget = 1;
+
+    TiledEmbreeMapPtr map = std::make_shared<TiledEmbreeMap>(directory, settings);
+    if(map->numTiles() != 3 || map->numLoadedTiles() != 0)
+    {
+        RM_THROW(EmbreeException, "Tile index was not read correctly");
+    }
+
+    SphereSimulatorEmbree sim;
+    sim.setMap(map);
+    SphericalModel model = vlp16_360();
+    sim.setModel(model);
+
+    Transform T = Transform::Identity();
+    T.t = {22.0, 25.0, 0.0};
+
+    map->update(T).get();
+    if(map->numLoadedTiles() != 1)
+    {
+        RM_THROW(EmbreeException, "Expected the tile in range to be loaded");
+    }
+
+    if(count_hits(sim, T, model.range.max) == 0)
+    {
+        RM_THROW(EmbreeException, "Loaded tile is not visible to the simulator");
+    }
+
+    // the budget forces the eviction of all tiles out of range
+    T.t = {222.0, 25.0, 0.0};
+    map->update(T).get();
+    if(map->numLoadedTiles() != 1)
+    {
+        RM_THROW(EmbreeException, "Expected the first tile to be evicted");
+    }
+
+    if(count_hits(sim, T, model.range.max) == 0)
+    {
+        RM_THROW(EmbreeException, "Streamed tile is not visible to the simulator");
+    }
+
+    // the evicted tile is gone from the current version
+    T.t = {22.0, 25.0, 0.0};
+    if(count_hits(sim, T, model.range.max) != 0)
+    {
+        RM_THROW(EmbreeException, "Evicted tile is still visible");
+    }
+
+}
+
+void test_large_faces(const std::string& directory)
+{
+    if(save_tiled_embree_map(make_ground(), directory, 50.0) != 1)
+    {
+        RM_THROW(EmbreeException, "Expected 1 tile");
+    }
+
+    TiledEmbreeMapSettings settings;
+    settings.range = 20.0;
+    TiledEmbreeMapPtr map = std::make_shared<TiledEmbreeMap>(directory, settings);
+
+    SphereSimulatorEmbree sim;
+    sim.setMap(map);
+    SphericalModel model = vlp16_360();
+    sim.setModel(model);
+
+    // standing on the triangle, 70m away from the square of its tile
+    Transform T = Transform::Identity();
+    T.t = {120.0, 5.0, 1.0};
+    map->update(T).get();
+    if(map->numLoadedTiles() != 1)
+    {
+        RM_THROW(EmbreeException, "Tile of a face below the sensor was not loaded");
+    }
+
+    if(count_hits(sim, T, model.range.max) == 0)
+    {
+        RM_THROW(EmbreeException, "Face below the sensor is not visible");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::cout << "EMBREE TILED MAP" << std::endl;
+
+    TempDirectory tmp;
+    test_streaming(tmp.path + "/streaming");
+    test_large_faces(tmp.path + "/large_faces");
+
+    std::cout << "Done." << std::endl;
+
+    return 0;
+}
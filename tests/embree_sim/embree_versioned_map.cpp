@@ -0,0 +1,98 @@
+#include <iostream>
+#include <cmath>
+
+#include <rmagine/simulation/SphereSimulatorEmbree.hpp>
+#include <rmagine/map/embree/embree_shapes.h>
+#include <rmagine/map/VersionedEmbreeMap.hpp>
+#include <rmagine/types/sensors.h>
+#include <rmagine/util/exceptions.h>
+#include <rmagine/util/prints.h>
+
+using namespace rmagine;
+
+EmbreeMeshPtr make_sphere(float scale)
+{
+    EmbreeMeshPtr sphere = std::make_shared<EmbreeSphere>(20, 20);
+    sphere->setScale({scale, scale, scale});
+    sphere->apply();
+    sphere->commit();
+    return sphere;
+}
+
+float simulate_range(const SphereSimulatorEmbree& sim)
+{
+    Memory<Transform, RAM> T(1);
+    T[0] = Transform::Identity();
+    Memory<float, RAM> ranges = sim.simulateRanges(T);
+    return ranges[0];
+}
+
+int main(int argc, char** argv)
+{
+    std::cout << "EMBREE VERSIONED MAP" << std::endl;
+
+    EmbreeScenePtr scene = std::make_shared<EmbreeScene>();
+    scene->add(make_sphere(1.0));
+    scene->commit();
+
+    VersionedEmbreeMapPtr maps = std::make_shared<VersionedEmbreeMap>(
+        std::make_shared<EmbreeMap>(scene));
+
+    SphereSimulatorEmbree sim;
+    sim.setMap(maps);
+    SphericalModel model = vlp16_360();
+    sim.setModel(model);
+
+    const float range_v0 = simulate_range(sim);
+    EmbreeMapPtr v0 = maps->current();
+
+    std::future<uint64_t> version = maps->update([](EmbreeMapPtr map) {
+        EmbreeScenePtr scene = map->scene->copy();
+        scene->remove(0);
+        scene->add(make_sphere(2.0));
+        scene->commit();
+        return scene;
+    });
+
+    if(version.get() != 1 || maps->version() != 1)
+    {
+        RM_THROW(EmbreeException, "Update did not create version 1");
+    }
+
+    const float range_v1 = simulate_range(sim);
+    if(std::fabs(range_v1 - 2.0 * range_v0) > 1e-3)
+    {
+        std::cout << range_v0 << " -> " << range_v1 << std::endl;
+        RM_THROW(EmbreeException, "Simulation does not use the new version");
+    }
+
+    // the old version is still intact for its holders
+    SphereSimulatorEmbree sim_v0(v0);
+    sim_v0.setModel(model);
+    if(std::fabs(simulate_range(sim_v0) - range_v0) > 1e-5)
+    {
+        RM_THROW(EmbreeException, "Update changed an old version");
+    }
+
+    // a failing build keeps the current version
+    std::future<uint64_t> failed = maps->update([](EmbreeMapPtr map) -> EmbreeScenePtr {
+        throw std::runtime_error("build failed");
+    });
+
+    bool thrown = false;
+    try {
+        failed.get();
+    } catch(const std::runtime_error& ex) {
+        thrown = true;
+    }
+
+    maps->wait();
+    if(!thrown || maps->version() != 1)
+    {
+        RM_THROW(EmbreeException, "Failed build was not reported or changed the version");
+    }
+
+    std::cout << "Done." << std::endl;
+
+    return 0;
+}